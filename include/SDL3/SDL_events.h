@@ -1267,6 +1267,40 @@ extern SDL_DECLSPEC void SDLCALL SDL_FlushEvents(Uint32 minType, Uint32 maxType)
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PollEvent(SDL_Event *event);
 
+/**
+ * Poll for all currently pending events at once.
+ *
+ * This removes up to `numevents` events from the queue and stores them in
+ * order in `events`, pumping and locking the queue once instead of once per
+ * event. It returns 0 once every event that was pending when the poll
+ * started has been returned, just as SDL_PollEvent() returns false, so it
+ * can replace an SDL_PollEvent() loop:
+ *
+ * ```c
+ * SDL_Event events[64];
+ * int count;
+ * while ((count = SDL_PollEvents(events, SDL_arraysize(events))) > 0) {
+ *     for (int i = 0; i < count; ++i) {
+ *         // decide what to do with this event.
+ *     }
+ * }
+ * ```
+ *
+ * \param events an array of SDL_Event structures to be filled in.
+ * \param numevents the number of events that fit in `events`.
+ * \returns the number of events stored in `events`, 0 if there are none
+ *          available, or -1 on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_PollEvent
+ * \sa SDL_PushEvents
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PollEvents(SDL_Event *events, int numevents);
+
 /**
  * Wait indefinitely for the next available event.
  *
@@ -1355,6 +1389,34 @@ extern SDL_DECLSPEC bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 t
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PushEvent(SDL_Event *event);
 
+/**
+ * Add several events to the event queue at once.
+ *
+ * This behaves like calling SDL_PushEvent() on each event in order, but the
+ * event filter and watchers are locked once for the whole array and the
+ * events are added to the queue together.
+ *
+ * Events rejected by the event filter are skipped but still counted in the
+ * return value, so if fewer than `numevents` are consumed because the queue
+ * filled up, the rest can be pushed again later starting at the returned
+ * index.
+ *
+ * \param events an array of events to be added to the queue. Event watchers
+ *               may modify the events in place.
+ * \param numevents the number of events in `events`.
+ * \returns the number of events consumed from the array, either added to the
+ *          queue or dropped by the event filter, or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_PollEvents
+ * \sa SDL_PushEvent
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PushEvents(SDL_Event *events, int numevents);
+
 /**
  * A function pointer used for callbacks that watch the event queue.
  *
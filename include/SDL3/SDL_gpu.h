@@ -305,6 +305,7 @@
 #define SDL_gpu_h_
 
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_asyncio.h>
 #include <SDL3/SDL_pixels.h>
 #include <SDL3/SDL_properties.h>
 #include <SDL3/SDL_rect.h>
@@ -512,6 +513,35 @@ typedef struct SDL_GPUCopyPass SDL_GPUCopyPass;
  */
 typedef struct SDL_GPUFence SDL_GPUFence;
 
+/**
+ * An opaque handle representing a pool of GPU queries.
+ *
+ * \since This struct is available since SDL 3.2.0
+ *
+ * \sa SDL_CreateGPUQueryPool
+ * \sa SDL_WriteGPUTimestamp
+ * \sa SDL_GetGPUQueryPoolResults
+ * \sa SDL_ReleaseGPUQueryPool
+ */
+typedef struct SDL_GPUQueryPool SDL_GPUQueryPool;
+
+/**
+ * An opaque handle representing a texture streamer.
+ *
+ * A texture streamer reads texel data from files with asynchronous I/O
+ * straight into transfer buffers and uploads it to textures in batched copy
+ * passes, without the calling thread ever waiting on the disk or the GPU.
+ *
+ * \since This struct is available since SDL 3.2.0
+ *
+ * \sa SDL_CreateGPUTextureStreamer
+ * \sa SDL_StreamGPUTexture
+ * \sa SDL_FlushGPUTextureStreamer
+ * \sa SDL_GetGPUTextureStreamResult
+ * \sa SDL_DestroyGPUTextureStreamer
+ */
+typedef struct SDL_GPUTextureStreamer SDL_GPUTextureStreamer;
+
 /**
  * Specifies the primitive topology of a graphics pipeline.
  *
@@ -1275,6 +1305,35 @@ typedef enum SDL_GPUSwapchainComposition
     SDL_GPU_SWAPCHAINCOMPOSITION_HDR10_ST2084
 } SDL_GPUSwapchainComposition;
 
+/**
+ * Specifies the kind of queries held by a query pool.
+ *
+ * - TIMESTAMP: Each query records the time at which all previously recorded
+ *   commands in the command buffer have finished executing.
+ *
+ * \since This enum is available since SDL 3.2.0
+ *
+ * \sa SDL_CreateGPUQueryPool
+ */
+typedef enum SDL_GPUQueryType
+{
+    SDL_GPU_QUERYTYPE_TIMESTAMP
+} SDL_GPUQueryType;
+
+/**
+ * Specifies the kind of pass reported to a pass timing callback.
+ *
+ * \since This enum is available since SDL 3.2.0
+ *
+ * \sa SDL_SetGPUPassTimingCallback
+ */
+typedef enum SDL_GPUPassType
+{
+    SDL_GPU_PASSTYPE_RENDER,
+    SDL_GPU_PASSTYPE_COMPUTE,
+    SDL_GPU_PASSTYPE_COPY
+} SDL_GPUPassType;
+
 /* Structures */
 
 /**
@@ -1694,6 +1753,56 @@ typedef struct SDL_GPUTransferBufferCreateInfo
     SDL_PropertiesID props;            /**< A properties ID for extensions. Should be 0 if no extensions are needed. */
 } SDL_GPUTransferBufferCreateInfo;
 
+/**
+ * A structure specifying the parameters of a query pool.
+ *
+ * \since This struct is available since SDL 3.2.0
+ *
+ * \sa SDL_CreateGPUQueryPool
+ */
+typedef struct SDL_GPUQueryPoolCreateInfo
+{
+    SDL_GPUQueryType type;   /**< The kind of queries held by the pool. */
+    Uint32 num_queries;      /**< The number of queries in the pool. */
+
+    SDL_PropertiesID props;  /**< A properties ID for extensions. Should be 0 if no extensions are needed. */
+} SDL_GPUQueryPoolCreateInfo;
+
+/**
+ * A structure describing how long a single pass took on the GPU.
+ *
+ * Timestamps are in nanoseconds from an unspecified origin. Only the
+ * difference between two timestamps from the same device is meaningful.
+ *
+ * \since This struct is available since SDL 3.2.0
+ *
+ * \sa SDL_SetGPUPassTimingCallback
+ */
+typedef struct SDL_GPUPassTiming
+{
+    SDL_GPUPassType type;  /**< The kind of pass that was timed. */
+    Uint64 begin_ns;       /**< The timestamp before the pass started, in nanoseconds. */
+    Uint64 end_ns;         /**< The timestamp after the pass finished, in nanoseconds. */
+} SDL_GPUPassTiming;
+
+/**
+ * A callback used to report per-pass GPU timings.
+ *
+ * \param userdata what was passed as `userdata` to
+ *                 SDL_SetGPUPassTimingCallback().
+ * \param timings an array of timings, one for each timed pass, in the order
+ *                the passes were recorded in the command buffer.
+ * \param num_timings the number of elements in the timings array.
+ *
+ * \threadsafety This callback may be called from any thread that acquires
+ *               command buffers from the device or waits for it to be idle.
+ *
+ * \since This datatype is available since SDL 3.2.0.
+ *
+ * \sa SDL_SetGPUPassTimingCallback
+ */
+typedef void (SDLCALL *SDL_GPUPassTimingCallback)(void *userdata, const SDL_GPUPassTiming *timings, int num_timings);
+
 /* Pipeline state structures */
 
 /**
@@ -2046,6 +2155,65 @@ typedef struct SDL_GPUStorageTextureReadWriteBinding
     Uint8 padding3;
 } SDL_GPUStorageTextureReadWriteBinding;
 
+/* Streaming structs */
+
+/**
+ * A structure specifying a texture upload to be read from a file.
+ *
+ * The texel data must be stored in the file exactly as it would be laid out
+ * in a transfer buffer for SDL_UploadToGPUTexture().
+ *
+ * \since This struct is available since SDL 3.2.0
+ *
+ * \sa SDL_StreamGPUTexture
+ */
+typedef struct SDL_GPUTextureStreamRequest
+{
+    SDL_AsyncIO *asyncio;               /**< The file to read from. Must stay open until the result is reported. */
+    Uint64 offset;                      /**< The starting byte of the texel data in the file. */
+    Uint32 size;                        /**< The number of bytes of texel data. */
+    Uint32 pixels_per_row;              /**< The number of pixels from one row to the next. */
+    Uint32 rows_per_layer;              /**< The number of rows from one layer/depth-slice to the next. */
+    SDL_GPUTextureRegion destination;   /**< The texture region to upload to. */
+    bool cycle;                         /**< true cycles the texture if it is already bound. */
+    Uint8 padding1;
+    Uint8 padding2;
+    Uint8 padding3;
+    void *userdata;                     /**< An app-provided pointer reported back by SDL_GetGPUTextureStreamResult(). */
+} SDL_GPUTextureStreamRequest;
+
+/* Memory structs */
+
+/**
+ * A structure reporting how SDL is using one of the device's memory heaps.
+ *
+ * SDL allocates device memory in large blocks and places resources inside
+ * them. `allocated_bytes - used_bytes` is memory that is held but unused;
+ * when that is large compared to `largest_free_region`, the heap is
+ * fragmented and SDL will compact it over the next few frames.
+ *
+ * \since This struct is available since SDL 3.2.0
+ *
+ * \sa SDL_GetGPUMemoryStats
+ */
+typedef struct SDL_GPUMemoryHeapStats
+{
+    Uint64 heap_size;             /**< The total size of the heap in bytes. */
+    Uint64 budget;                /**< The number of bytes the driver estimates this process can use before performance suffers, or 0 if unknown. */
+    Uint64 usage;                 /**< The number of bytes the driver reports this process is using, or allocated_bytes if unknown. */
+    Uint64 allocated_bytes;       /**< The number of bytes in blocks SDL has allocated from this heap. */
+    Uint64 used_bytes;            /**< The number of bytes in those blocks that are occupied by resources. */
+    Uint64 largest_free_region;   /**< The size in bytes of the largest unused range inside a block. */
+    Uint32 block_count;           /**< The number of blocks SDL has allocated from this heap. */
+    Uint32 resource_count;        /**< The number of buffers and textures placed in those blocks. */
+    Uint32 free_region_count;     /**< The number of unused ranges inside those blocks. */
+    Uint32 defrag_block_count;    /**< The number of blocks waiting to be defragmented. */
+    bool device_local;            /**< true if the heap is local to the GPU. */
+    Uint8 padding1;
+    Uint8 padding2;
+    Uint8 padding3;
+} SDL_GPUMemoryHeapStats;
+
 /* Functions */
 
 /* Device */
@@ -2135,6 +2303,27 @@ extern SDL_DECLSPEC SDL_GPUDevice *SDLCALL SDL_CreateGPUDevice(
  * - `SDL_PROP_GPU_DEVICE_CREATE_D3D12_SEMANTIC_NAME_STRING`: the prefix to
  *   use for all vertex semantics, default is "TEXCOORD".
  *
+ * With the Vulkan renderer:
+ *
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER`: a pointer to
+ *   pipeline cache data previously returned by SDL_GetGPUPipelineCacheData(),
+ *   used to avoid recompiling pipelines that were seen on a previous run.
+ *   The data is copied during device creation and is ignored if it was
+ *   produced by a different driver or device.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER`: the size
+ *   in bytes of the pipeline cache data.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_BINDLESS_TEXTURES_NUMBER`: the number
+ *   of slots to reserve in the bindless texture array, defaults to 0 which
+ *   disables bindless textures. The count is clamped to the device limits,
+ *   and the array is silently left disabled if the device doesn't support
+ *   descriptor indexing.
+ * - `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEFRAG_BUDGET_MS_NUMBER`: the number
+ *   of milliseconds per presented frame that may be spent moving resources
+ *   to defragment device memory. Defaults to 0, which moves the contents of
+ *   one memory block per frame regardless of how long that takes. At least
+ *   one resource is moved per frame so defragmentation always makes
+ *   progress.
+ *
  * \param props the properties to use.
  * \returns a GPU context on success or NULL on failure; call SDL_GetError()
  *          for more information.
@@ -2149,16 +2338,20 @@ extern SDL_DECLSPEC SDL_GPUDevice *SDLCALL SDL_CreateGPUDevice(
 extern SDL_DECLSPEC SDL_GPUDevice *SDLCALL SDL_CreateGPUDeviceWithProperties(
     SDL_PropertiesID props);
 
-#define SDL_PROP_GPU_DEVICE_CREATE_DEBUGMODE_BOOLEAN          "SDL.gpu.device.create.debugmode"
-#define SDL_PROP_GPU_DEVICE_CREATE_PREFERLOWPOWER_BOOLEAN     "SDL.gpu.device.create.preferlowpower"
-#define SDL_PROP_GPU_DEVICE_CREATE_NAME_STRING                "SDL.gpu.device.create.name"
-#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_PRIVATE_BOOLEAN    "SDL.gpu.device.create.shaders.private"
-#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_SPIRV_BOOLEAN      "SDL.gpu.device.create.shaders.spirv"
-#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_DXBC_BOOLEAN       "SDL.gpu.device.create.shaders.dxbc"
-#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_DXIL_BOOLEAN       "SDL.gpu.device.create.shaders.dxil"
-#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_MSL_BOOLEAN        "SDL.gpu.device.create.shaders.msl"
-#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_METALLIB_BOOLEAN   "SDL.gpu.device.create.shaders.metallib"
-#define SDL_PROP_GPU_DEVICE_CREATE_D3D12_SEMANTIC_NAME_STRING "SDL.gpu.device.create.d3d12.semantic"
+#define SDL_PROP_GPU_DEVICE_CREATE_DEBUGMODE_BOOLEAN                 "SDL.gpu.device.create.debugmode"
+#define SDL_PROP_GPU_DEVICE_CREATE_PREFERLOWPOWER_BOOLEAN            "SDL.gpu.device.create.preferlowpower"
+#define SDL_PROP_GPU_DEVICE_CREATE_NAME_STRING                       "SDL.gpu.device.create.name"
+#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_PRIVATE_BOOLEAN           "SDL.gpu.device.create.shaders.private"
+#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_SPIRV_BOOLEAN             "SDL.gpu.device.create.shaders.spirv"
+#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_DXBC_BOOLEAN              "SDL.gpu.device.create.shaders.dxbc"
+#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_DXIL_BOOLEAN              "SDL.gpu.device.create.shaders.dxil"
+#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_MSL_BOOLEAN               "SDL.gpu.device.create.shaders.msl"
+#define SDL_PROP_GPU_DEVICE_CREATE_SHADERS_METALLIB_BOOLEAN          "SDL.gpu.device.create.shaders.metallib"
+#define SDL_PROP_GPU_DEVICE_CREATE_D3D12_SEMANTIC_NAME_STRING        "SDL.gpu.device.create.d3d12.semantic"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER     "SDL.gpu.device.create.vulkan.pipeline_cache"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER "SDL.gpu.device.create.vulkan.pipeline_cache.size"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_BINDLESS_TEXTURES_NUMBER   "SDL.gpu.device.create.vulkan.bindless_textures"
+#define SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEFRAG_BUDGET_MS_NUMBER    "SDL.gpu.device.create.vulkan.defrag_budget_ms"
 
 /**
  * Destroys a GPU context previously returned by SDL_CreateGPUDevice.
@@ -2222,6 +2415,127 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetGPUDeviceDriver(SDL_GPUDevice *d
  */
 extern SDL_DECLSPEC SDL_GPUShaderFormat SDLCALL SDL_GetGPUShaderFormats(SDL_GPUDevice *device);
 
+/**
+ * Get the contents of the device's pipeline cache.
+ *
+ * The returned data can be saved to disk and passed back in with
+ * `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER` on a later run
+ * to skip compiling pipelines that were already created. It is only useful
+ * with the same driver and device that produced it; SDL checks this when the
+ * cache is loaded and discards data that doesn't match.
+ *
+ * This is currently only supported by the Vulkan backend.
+ *
+ * \param device a GPU context to query.
+ * \param size a pointer filled in with the number of bytes returned.
+ * \returns the pipeline cache data, which should be freed with SDL_free(),
+ *          or NULL on failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_CreateGPUDeviceWithProperties
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_GetGPUPipelineCacheData(SDL_GPUDevice *device, size_t *size);
+
+/**
+ * Get statistics about how the device's memory heaps are being used.
+ *
+ * On Vulkan devices that support VK_EXT_memory_budget, `budget` and `usage`
+ * come from the driver, and SDL avoids growing a heap past its budget when
+ * another heap can hold the resource instead.
+ *
+ * This is currently only supported by the Vulkan backend.
+ *
+ * \param device a GPU context to query.
+ * \param count a pointer filled in with the number of heaps returned, may be
+ *              NULL.
+ * \returns an array of heap statistics, which should be freed with
+ *          SDL_free(), or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ */
+extern SDL_DECLSPEC SDL_GPUMemoryHeapStats * SDLCALL SDL_GetGPUMemoryStats(SDL_GPUDevice *device, int *count);
+
+/* Bindless Textures */
+
+/**
+ * Get the number of slots in the device's bindless texture array.
+ *
+ * The bindless texture array is a single large array of texture-sampler
+ * pairs that stays bound for the lifetime of the device. Shaders index into
+ * it directly instead of having textures bound with
+ * SDL_BindGPUFragmentSamplers() and friends, which avoids rewriting
+ * descriptors every time a draw call changes textures.
+ *
+ * The array is enabled with
+ * `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_BINDLESS_TEXTURES_NUMBER`. For SPIR-V
+ * graphics shaders it is binding 0 of set 4, and for SPIR-V compute shaders
+ * it is binding 0 of set 3, declared as an unsized array of combined image
+ * samplers. Indices that vary within a draw must be marked `nonuniformEXT`.
+ *
+ * This is currently only supported by the Vulkan backend.
+ *
+ * \param device a GPU context to query.
+ * \returns the number of slots in the bindless texture array, or 0 if
+ *          bindless textures are not available.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_AddGPUBindlessTexture
+ */
+extern SDL_DECLSPEC Uint32 SDLCALL SDL_GetGPUBindlessTextureCapacity(SDL_GPUDevice *device);
+
+/**
+ * Places a texture-sampler pair in a free slot of the bindless texture array.
+ *
+ * The slot takes the texture as it is right now; if the texture is later
+ * cycled, the slot keeps referring to the old contents until it is removed
+ * and added again. The texture and sampler must not be released while they
+ * are in the array.
+ *
+ * \param device a GPU context.
+ * \param binding the texture-sampler pair to add. The texture must have been
+ *                created with SDL_GPU_TEXTUREUSAGE_SAMPLER.
+ * \param index a pointer filled in with the slot the pair was placed in.
+ * \returns true on success or false if the array is full or not available;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_RemoveGPUBindlessTexture
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_AddGPUBindlessTexture(
+    SDL_GPUDevice *device,
+    const SDL_GPUTextureSamplerBinding *binding,
+    Uint32 *index);
+
+/**
+ * Returns a slot of the bindless texture array to the free list.
+ *
+ * The slot may be handed out again by the next call to
+ * SDL_AddGPUBindlessTexture(), so it must not be read by any submitted
+ * command buffer that has not yet completed.
+ *
+ * \param device a GPU context.
+ * \param index a slot previously returned by SDL_AddGPUBindlessTexture().
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_AddGPUBindlessTexture
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_RemoveGPUBindlessTexture(
+    SDL_GPUDevice *device,
+    Uint32 index);
+
 /* State Creation */
 
 /**
@@ -2236,6 +2550,8 @@ extern SDL_DECLSPEC SDL_GPUShaderFormat SDLCALL SDL_GetGPUShaderFormats(SDL_GPUD
  *   read-only storage buffers
  * - 1: Read-write storage textures, followed by read-write storage buffers
  * - 2: Uniform buffers
+ * - 3: The bindless texture array, if enabled (see
+ *   SDL_GetGPUBindlessTextureCapacity)
  *
  * For DXBC and DXIL shaders, use the following register order:
  *
@@ -2349,6 +2665,9 @@ extern SDL_DECLSPEC SDL_GPUSampler *SDLCALL SDL_CreateGPUSampler(
  *   buffers
  * - 3: Uniform buffers
  *
+ * For either stage, set 4 is the bindless texture array, if enabled (see
+ * SDL_GetGPUBindlessTextureCapacity).
+ *
  * For DXBC and DXIL shaders, use the following register order:
  *
  * For vertex shaders:
@@ -2835,6 +3154,42 @@ extern SDL_DECLSPEC void SDLCALL SDL_PushGPUComputeUniformData(
     const void *data,
     Uint32 length);
 
+/* Transient Memory */
+
+/**
+ * Allocates transient GPU memory that the CPU can write directly.
+ *
+ * The memory is suballocated from a mapped ring of upload buffers owned by
+ * SDL, so per-frame vertex, index or indirect draw data can be written and
+ * bound without creating a transfer buffer or recording a copy pass.
+ * `binding` is filled in with a buffer handle and offset that can be passed to
+ * SDL_BindGPUVertexBuffers, SDL_BindGPUIndexBuffer, or as the buffer and
+ * offset of the indirect draw functions. Allocations are aligned to 16 bytes.
+ *
+ * The returned pointer stays valid until the command buffer is submitted or
+ * cancelled; all writes must be done by then. The memory is recycled once the
+ * GPU has finished with the command buffer. The buffer handle in `binding`
+ * belongs to SDL: it must not be released, cycled, or used as a copy
+ * destination.
+ *
+ * This may be called during a pass.
+ *
+ * \param command_buffer a command buffer.
+ * \param size the number of bytes to allocate.
+ * \param binding filled in with the buffer and offset of the allocation.
+ * \returns a pointer to the mapped memory or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_BindGPUVertexBuffers
+ * \sa SDL_BindGPUIndexBuffer
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_AllocateGPUTransientMemory(
+    SDL_GPUCommandBuffer *command_buffer,
+    Uint32 size,
+    SDL_GPUBufferBinding *binding);
+
 /* Graphics State */
 
 /**
@@ -3200,6 +3555,97 @@ extern SDL_DECLSPEC void SDLCALL SDL_DrawGPUIndexedPrimitivesIndirect(
 extern SDL_DECLSPEC void SDLCALL SDL_EndGPURenderPass(
     SDL_GPURenderPass *render_pass);
 
+/* Parallel Render Passes */
+
+/**
+ * Begins a render pass whose contents are recorded by secondary command
+ * buffers.
+ *
+ * This behaves like SDL_BeginGPURenderPass, except that no graphics commands
+ * may be recorded directly into the returned render pass. Instead, acquire
+ * secondary command buffers for it with SDL_AcquireGPUSecondaryCommandBuffer,
+ * record draws into them (possibly on several threads at once), and then
+ * execute them in order with SDL_ExecuteGPUSecondaryCommandBuffers before
+ * ending the render pass with SDL_EndGPURenderPass.
+ *
+ * This is currently only supported by the Vulkan backend.
+ *
+ * \param command_buffer a command buffer.
+ * \param color_target_infos an array of texture subresources with
+ *                           corresponding clear values and load/store ops.
+ * \param num_color_targets the number of color targets in the
+ *                          color_target_infos array.
+ * \param depth_stencil_target_info a texture subresource with corresponding
+ *                                  clear value and load/store ops, may be
+ *                                  NULL.
+ * \returns a render pass handle or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_AcquireGPUSecondaryCommandBuffer
+ * \sa SDL_ExecuteGPUSecondaryCommandBuffers
+ * \sa SDL_EndGPURenderPass
+ */
+extern SDL_DECLSPEC SDL_GPURenderPass *SDLCALL SDL_BeginGPUParallelRenderPass(
+    SDL_GPUCommandBuffer *command_buffer,
+    const SDL_GPUColorTargetInfo *color_target_infos,
+    Uint32 num_color_targets,
+    const SDL_GPUDepthStencilTargetInfo *depth_stencil_target_info);
+
+/**
+ * Acquire a secondary command buffer that records into a parallel render
+ * pass.
+ *
+ * The secondary command buffer renders to the targets of `render_pass`. Call
+ * SDL_BeginGPURenderPass on it with no targets to obtain a render pass handle
+ * for recording, and SDL_EndGPURenderPass when recording is done. A default
+ * viewport and scissor state are set, as with a regular render pass.
+ *
+ * A secondary command buffer cannot be submitted and cannot contain compute
+ * passes, copy passes, blits or timestamps. It is returned to SDL once the
+ * command buffer that executed it has completed, or when it is cancelled
+ * with SDL_CancelGPUCommandBuffer before being executed.
+ *
+ * \param render_pass a render pass begun with SDL_BeginGPUParallelRenderPass.
+ * \returns a secondary command buffer or NULL on failure; call SDL_GetError()
+ *          for more information.
+ *
+ * \threadsafety This function may be called from any thread. The returned
+ *               command buffer may only be used on the thread it was
+ *               acquired on.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_BeginGPUParallelRenderPass
+ * \sa SDL_ExecuteGPUSecondaryCommandBuffers
+ */
+extern SDL_DECLSPEC SDL_GPUCommandBuffer *SDLCALL SDL_AcquireGPUSecondaryCommandBuffer(
+    SDL_GPURenderPass *render_pass);
+
+/**
+ * Executes finished secondary command buffers inside a parallel render pass.
+ *
+ * The command buffers are executed in array order. Each secondary command
+ * buffer must have been acquired from `render_pass` and must have had its
+ * render pass ended, and may only be executed once.
+ *
+ * This must be called from the thread the primary command buffer was
+ * acquired on.
+ *
+ * \param render_pass a render pass begun with SDL_BeginGPUParallelRenderPass.
+ * \param command_buffers an array of secondary command buffers.
+ * \param num_command_buffers the number of command buffers in the array.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_AcquireGPUSecondaryCommandBuffer
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ExecuteGPUSecondaryCommandBuffers(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUCommandBuffer *const *command_buffers,
+    Uint32 num_command_buffers);
+
 /* Compute Pass */
 
 /**
@@ -3591,6 +4037,112 @@ extern SDL_DECLSPEC void SDLCALL SDL_BlitGPUTexture(
     SDL_GPUCommandBuffer *command_buffer,
     const SDL_GPUBlitInfo *info);
 
+/* Texture Streaming */
+
+/**
+ * Creates a texture streamer.
+ *
+ * Texture data is read with SDL_ReadAsyncIO() directly into mapped transfer
+ * buffers, so nothing is copied on the CPU between the disk and the staging
+ * memory. Uploads whose reads have finished are gathered by
+ * SDL_FlushGPUTextureStreamer() into a single copy pass on a command buffer
+ * of the streamer's own, which is tracked with a fence.
+ *
+ * \param device a GPU context.
+ * \returns a texture streamer on success or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_StreamGPUTexture
+ * \sa SDL_DestroyGPUTextureStreamer
+ */
+extern SDL_DECLSPEC SDL_GPUTextureStreamer * SDLCALL SDL_CreateGPUTextureStreamer(
+    SDL_GPUDevice *device);
+
+/**
+ * Starts reading texel data for a texture upload.
+ *
+ * This returns as soon as the read has been queued. The upload itself is
+ * recorded by a later call to SDL_FlushGPUTextureStreamer() once the read has
+ * finished.
+ *
+ * \param streamer a texture streamer.
+ * \param request the file region to read and the texture region to upload
+ *                it to.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_FlushGPUTextureStreamer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_StreamGPUTexture(
+    SDL_GPUTextureStreamer *streamer,
+    const SDL_GPUTextureStreamRequest *request);
+
+/**
+ * Moves finished reads to the GPU and retires finished uploads.
+ *
+ * This never blocks on I/O or on the GPU. Every read that has completed since
+ * the last call is uploaded in one copy pass and submitted, and every upload
+ * whose fence has signaled is made available to
+ * SDL_GetGPUTextureStreamResult(). Call this once a frame, or as often as a
+ * loader thread likes.
+ *
+ * \param streamer a texture streamer.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_GetGPUTextureStreamResult
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_FlushGPUTextureStreamer(
+    SDL_GPUTextureStreamer *streamer);
+
+/**
+ * Gets the result of a finished texture stream request.
+ *
+ * A request is finished once its upload has completed on the GPU, or as soon
+ * as its read fails. Results are reported in the order they finish.
+ *
+ * \param streamer a texture streamer.
+ * \param userdata a pointer filled in with the request's userdata.
+ * \param success a pointer filled in with true if the texture was uploaded,
+ *                false if the read failed. May be NULL.
+ * \returns true if a result was available, false otherwise.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_FlushGPUTextureStreamer
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetGPUTextureStreamResult(
+    SDL_GPUTextureStreamer *streamer,
+    void **userdata,
+    bool *success);
+
+/**
+ * Destroys a texture streamer.
+ *
+ * This waits for all outstanding reads and uploads to finish. Results that
+ * were never retrieved are discarded.
+ *
+ * \param streamer a texture streamer.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_CreateGPUTextureStreamer
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyGPUTextureStreamer(
+    SDL_GPUTextureStreamer *streamer);
+
 /* Submission/Presentation */
 
 /**
@@ -4009,6 +4561,123 @@ extern SDL_DECLSPEC void SDLCALL SDL_ReleaseGPUFence(
     SDL_GPUDevice *device,
     SDL_GPUFence *fence);
 
+/* Queries */
+
+/**
+ * Creates a query pool that can be written to by command buffers.
+ *
+ * Timestamp queries need to be supported by the device; this is not
+ * available on every backend.
+ *
+ * \param device a GPU Context.
+ * \param createinfo a struct describing the state of the query pool to
+ *                   create.
+ * \returns a query pool object on success, or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_WriteGPUTimestamp
+ * \sa SDL_GetGPUQueryPoolResults
+ * \sa SDL_ReleaseGPUQueryPool
+ */
+extern SDL_DECLSPEC SDL_GPUQueryPool * SDLCALL SDL_CreateGPUQueryPool(
+    SDL_GPUDevice *device,
+    const SDL_GPUQueryPoolCreateInfo *createinfo);
+
+/**
+ * Writes a timestamp into a query pool.
+ *
+ * The timestamp is taken once all previously recorded commands in the
+ * command buffer have finished executing. This must be called outside of any
+ * pass.
+ *
+ * \param command_buffer a command buffer.
+ * \param query_pool a query pool created with SDL_GPU_QUERYTYPE_TIMESTAMP.
+ * \param query_index the index of the query to write.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_GetGPUQueryPoolResults
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WriteGPUTimestamp(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 query_index);
+
+/**
+ * Reads back the results of queries in a query pool.
+ *
+ * Results are only available once every command buffer that wrote to the
+ * requested queries has finished executing, for example after waiting on the
+ * fence returned by SDL_SubmitGPUCommandBufferAndAcquireFence(). Only queries
+ * that have been written at least once may be read.
+ *
+ * Timestamps are returned in nanoseconds from an unspecified origin.
+ *
+ * \param device a GPU context.
+ * \param query_pool a query pool.
+ * \param first_query the index of the first query to read.
+ * \param num_queries the number of queries to read.
+ * \param results an array of num_queries values filled in with the results.
+ * \returns true on success, false if the results are not available yet or on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_WriteGPUTimestamp
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetGPUQueryPoolResults(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 first_query,
+    Uint32 num_queries,
+    Uint64 *results);
+
+/**
+ * Frees the given query pool as soon as it is safe to do so.
+ *
+ * You must not reference the query pool after calling this function.
+ *
+ * \param device a GPU context.
+ * \param query_pool a query pool to be destroyed.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_CreateGPUQueryPool
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ReleaseGPUQueryPool(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool);
+
+/**
+ * Sets a callback that reports how long each pass took on the GPU.
+ *
+ * While a callback is set, every render, compute and copy pass recorded on
+ * command buffers acquired afterwards is timed. Results are reported once per
+ * command buffer after it has finished executing, the next time a command
+ * buffer is acquired or SDL_WaitForGPUIdle() is called. Passes beyond the
+ * first 32 in a command buffer are not timed.
+ *
+ * Pass NULL to stop timing passes.
+ *
+ * \param device a GPU context.
+ * \param callback a function to call with the timings of each command
+ *                 buffer, or NULL to disable pass timing.
+ * \param userdata a pointer that is passed to `callback`.
+ * \returns true on success, false on failure (for example, if timestamp
+ *          queries are not supported by the device); call SDL_GetError() for
+ *          more information.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_CreateGPUQueryPool
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetGPUPassTimingCallback(
+    SDL_GPUDevice *device,
+    SDL_GPUPassTimingCallback callback,
+    void *userdata);
+
 /* Format Info */
 
 /**
@@ -773,6 +773,33 @@ extern "C" {
  */
 #define SDL_HINT_EVDEV_DEVICES "SDL_EVDEV_DEVICES"
 
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * When enabled, a mouse, pen, or finger motion event that arrives while the
+ * most recently queued event is a motion event from the same device and
+ * window (and, for mouse and pen, with the same button state) replaces that
+ * event instead of being queued separately. The merged event has the latest
+ * position and timestamp, and mouse and finger relative motion is the sum of
+ * all the motion it replaces. This keeps high frequency devices from filling
+ * the event queue with stale positions.
+ *
+ * Event watchers added with SDL_AddEventWatch() are called before events are
+ * queued, so they still see every individual motion event if the application
+ * needs the full motion history.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Every motion event is queued separately. (default)
+ * - "1": Consecutive motion events are merged in the event queue.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.2.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
 /**
  * A variable controlling verbosity of the logging of SDL events pushed onto
  * the internal queue.
@@ -2916,6 +2943,49 @@ extern "C" {
  */
 #define SDL_HINT_RENDER_METAL_PREFER_LOW_POWER_DEVICE "SDL_RENDER_METAL_PREFER_LOW_POWER_DEVICE"
 
+/**
+ * A variable controlling whether the 2D render API reorders draw commands to
+ * reduce state changes.
+ *
+ * When enabled, draws that don't overlap each other are sorted by texture,
+ * blend mode and color before the command queue is sent to the GPU, so that
+ * draws sharing the same state can be merged into a single batch. This helps
+ * applications that interleave draws from several textures, like UIs using
+ * more than one atlas. The rendered image is unchanged, but it costs some CPU
+ * time per flush.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Draw commands are sent in the order they were issued. (default)
+ * - "1": Draw commands may be reordered to merge draws with the same state.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.2.0.
+ */
+#define SDL_HINT_RENDER_REORDER_COMMANDS "SDL_RENDER_REORDER_COMMANDS"
+
+/**
+ * A variable controlling how many threads the software renderer uses to draw.
+ *
+ * When more than one thread is used, the render target is split into bands
+ * of rows and each thread draws the whole command queue clipped to the bands
+ * it picks up, so the output is the same as drawing on a single thread.
+ * Queues that can't be split this way, like ones containing lines, are still
+ * drawn on the calling thread.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use one thread per logical CPU core.
+ * - "1": Draw on the thread that flushes the command queue. (default)
+ * - "N": Draw with N threads, including the one flushing the command queue.
+ *
+ * This hint should be set before creating a renderer.
+ *
+ * \since This hint is available since SDL 3.2.0.
+ */
+#define SDL_HINT_RENDER_SOFTWARE_THREADS "SDL_RENDER_SOFTWARE_THREADS"
+
 /**
  * A variable controlling whether updates to the SDL screen surface should be
  * synchronized with the vertical refresh, to avoid tearing.
@@ -3142,6 +3212,25 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ * A variable controlling how many worker threads run timer callbacks.
+ *
+ * By default every timer callback runs on a single timer thread, one after
+ * another, so a slow callback delays all the other timers. If this is set to
+ * a number greater than zero, the timer thread hands expired timers to a pool
+ * of that many worker threads instead, and callbacks for different timers can
+ * run at the same time. A single timer's callback never runs on more than one
+ * thread at once, and the timer isn't rescheduled until its callback returns.
+ * At most 64 worker threads are created, larger values are treated as 64.
+ *
+ * The default value is "0".
+ *
+ * This hint should be set before the first timer is added.
+ *
+ * \since This hint is available since SDL 3.2.0.
+ */
+#define SDL_HINT_TIMER_WORKER_THREADS "SDL_TIMER_WORKER_THREADS"
+
 /**
  * A variable controlling whether touch events should generate synthetic mouse
  * events.
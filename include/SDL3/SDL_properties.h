@@ -162,6 +162,28 @@ extern SDL_DECLSPEC bool SDLCALL SDL_LockProperties(SDL_PropertiesID props);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_UnlockProperties(SDL_PropertiesID props);
 
+/**
+ * Make a group of properties read-only.
+ *
+ * Once properties are frozen, any attempt to set or clear properties in the
+ * group will fail, and reading them no longer takes the properties lock. This
+ * is useful for properties that are filled in once and then queried often,
+ * possibly from several threads at once.
+ *
+ * Frozen properties can still be destroyed with SDL_DestroyProperties().
+ *
+ * \param props the properties to freeze.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_LockProperties
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_FreezeProperties(SDL_PropertiesID props);
+
 /**
  * A callback used to free resources when a property is deleted.
  *
@@ -85,6 +85,21 @@ typedef struct SDL_Vertex
     SDL_FPoint tex_coord;       /**< Normalized texture coordinates, if needed */
 } SDL_Vertex;
 
+/**
+ * A single sprite drawn by SDL_RenderTextureBatch().
+ *
+ * \since This struct is available since SDL 3.2.0.
+ *
+ * \sa SDL_RenderTextureBatch
+ */
+typedef struct SDL_TextureBatchItem
+{
+    SDL_FRect srcrect;          /**< The source rectangle, in texture pixels */
+    SDL_FRect dstrect;          /**< The destination rectangle, in SDL_Renderer coordinates */
+    SDL_FColor color;           /**< Color modulation, combined with the texture color and alpha modulation */
+    double angle;               /**< Rotation in degrees, clockwise around the center of dstrect */
+} SDL_TextureBatchItem;
+
 /**
  * The access pattern allowed for a texture.
  *
@@ -279,6 +294,18 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRenderer(SDL_Window *window
  * - `SDL_PROP_RENDERER_CREATE_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER`: the
  *   queue family index used for presentation.
  *
+ * With the gpu renderer:
+ *
+ * - `SDL_PROP_RENDERER_CREATE_GPU_PREBUILD_PIPELINES_BOOLEAN`: true to build
+ *   the pipelines for every common blend mode and target format on a
+ *   background thread while the renderer starts up, instead of on first use,
+ *   defaults to false. GPU device creation properties, such as
+ *   `SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER`, are passed
+ *   through to the device, so a pipeline cache saved with
+ *   SDL_GetGPUPipelineCacheData() on the device from
+ *   `SDL_PROP_RENDERER_GPU_DEVICE_POINTER` can make this nearly free on
+ *   later runs.
+ *
  * \param props the properties to use.
  * \returns a valid rendering context or NULL if there was an error; call
  *          SDL_GetError() for more information.
@@ -306,6 +333,7 @@ extern SDL_DECLSPEC SDL_Renderer * SDLCALL SDL_CreateRendererWithProperties(SDL_
 #define SDL_PROP_RENDERER_CREATE_VULKAN_DEVICE_POINTER                      "SDL.renderer.create.vulkan.device"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_GRAPHICS_QUEUE_FAMILY_INDEX_NUMBER  "SDL.renderer.create.vulkan.graphics_queue_family_index"
 #define SDL_PROP_RENDERER_CREATE_VULKAN_PRESENT_QUEUE_FAMILY_INDEX_NUMBER   "SDL.renderer.create.vulkan.present_queue_family_index"
+#define SDL_PROP_RENDERER_CREATE_GPU_PREBUILD_PIPELINES_BOOLEAN             "SDL.renderer.create.gpu.prebuild_pipelines"
 
 /**
  * Create a 2D software rendering context for a surface.
@@ -401,6 +429,12 @@ extern SDL_DECLSPEC const char * SDLCALL SDL_GetRendererName(SDL_Renderer *rende
  *   that can be displayed, in terms of the SDR white point. When HDR is not
  *   enabled, this will be 1.0. This property can change dynamically when
  *   SDL_EVENT_WINDOW_HDR_STATE_CHANGED is sent.
+ * - `SDL_PROP_RENDERER_DRAW_COMMANDS_NUMBER`: the number of draw commands
+ *   queued during the last frame, updated by SDL_RenderPresent() when
+ *   SDL_HINT_RENDER_REORDER_COMMANDS is enabled.
+ * - `SDL_PROP_RENDERER_DRAW_BATCHES_NUMBER`: the number of batches the draw
+ *   commands of the last frame could be merged into, updated by
+ *   SDL_RenderPresent() when SDL_HINT_RENDER_REORDER_COMMANDS is enabled.
  *
  * With the direct3d renderer:
  *
@@ -466,6 +500,8 @@ extern SDL_DECLSPEC SDL_PropertiesID SDLCALL SDL_GetRendererProperties(SDL_Rende
 #define SDL_PROP_RENDERER_HDR_ENABLED_BOOLEAN                       "SDL.renderer.HDR_enabled"
 #define SDL_PROP_RENDERER_SDR_WHITE_POINT_FLOAT                     "SDL.renderer.SDR_white_point"
 #define SDL_PROP_RENDERER_HDR_HEADROOM_FLOAT                        "SDL.renderer.HDR_headroom"
+#define SDL_PROP_RENDERER_DRAW_COMMANDS_NUMBER                      "SDL.renderer.draw_commands"
+#define SDL_PROP_RENDERER_DRAW_BATCHES_NUMBER                       "SDL.renderer.draw_batches"
 #define SDL_PROP_RENDERER_D3D9_DEVICE_POINTER                       "SDL.renderer.d3d9.device"
 #define SDL_PROP_RENDERER_D3D11_DEVICE_POINTER                      "SDL.renderer.d3d11.device"
 #define SDL_PROP_RENDERER_D3D11_SWAPCHAIN_POINTER                   "SDL.renderer.d3d11.swap_chain"
@@ -2118,6 +2154,35 @@ extern SDL_DECLSPEC bool SDLCALL SDL_RenderTextureAffine(SDL_Renderer *renderer,
                                                      const SDL_FRect *srcrect, const SDL_FPoint *origin,
                                                      const SDL_FPoint *right, const SDL_FPoint *down);
 
+/**
+ * Copy many portions of a texture to the current rendering target at once.
+ *
+ * This is equivalent to calling SDL_RenderTextureRotated() for each item with
+ * the texture color modulation multiplied by the item's color, but the whole
+ * batch is submitted to the renderer as a single draw where possible, which
+ * is much faster for large numbers of sprites, like particle systems.
+ *
+ * Each item's srcrect is clipped to the texture and its dstrect shrinks by
+ * the same fraction, so the part of the item that falls outside the texture
+ * isn't drawn. Items that end up empty are skipped.
+ *
+ * \param renderer the renderer which should copy parts of a texture.
+ * \param texture the source texture.
+ * \param items an array of SDL_TextureBatchItem structures describing each
+ *              copy.
+ * \param count the number of items in the array.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function should only be called on the main thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_RenderTexture
+ * \sa SDL_RenderTextureRotated
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RenderTextureBatch(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureBatchItem *items, int count);
+
 /**
  * Tile a portion of the texture to the current rendering target at subpixel
  * precision.
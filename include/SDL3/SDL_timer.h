@@ -403,6 +403,45 @@ typedef Uint64 (SDLCALL *SDL_NSTimerCallback)(void *userdata, SDL_TimerID timerI
  */
 extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *userdata);
 
+/**
+ * Scheduling statistics for a timer.
+ *
+ * Lateness is how long after its scheduled time a timer's callback started
+ * running. This includes any time spent waiting for a worker thread when
+ * SDL_HINT_TIMER_WORKER_THREADS is set.
+ *
+ * \since This struct is available since SDL 3.2.0.
+ *
+ * \sa SDL_GetTimerStats
+ */
+typedef struct SDL_TimerStats
+{
+    Uint64 count;               /**< The number of times the callback has been called */
+    Uint64 last_lateness_ns;    /**< The lateness of the most recent call, in nanoseconds */
+    Uint64 max_lateness_ns;     /**< The largest lateness of any call, in nanoseconds */
+    Uint64 total_lateness_ns;   /**< The sum of the lateness of all calls, in nanoseconds */
+} SDL_TimerStats;
+
+/**
+ * Get scheduling statistics for a timer.
+ *
+ * Statistics remain available after a timer's callback returns 0, until the
+ * timer is removed with SDL_RemoveTimer() or its ID is reused.
+ *
+ * \param id the ID of the timer to query.
+ * \param stats a pointer filled in with the timer statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.2.0.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_AddTimerNS
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats);
+
 /**
  * Remove a timer created with SDL_AddTimer().
  *
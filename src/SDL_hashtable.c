@@ -48,277 +48,330 @@ static void HT_ASSERT_FAIL(const char *msg)
 #define HT_ASSERT(x) if (!(x)) HT_ASSERT_FAIL("SDL_HashTable Assertion Failure: " #x)
 #endif
 
-typedef struct SDL_HashItem
-{
-    // TODO: Splitting off values into a separate array might be more cache-friendly
-    const void *key;
-    const void *value;
-    Uint32 hash;
-    Uint32 probe_len : 31;
-    Uint32 live : 1;
-} SDL_HashItem;
+/* This is an open addressing hash table in the style of a "Swiss table".
+ *
+ * Keys and values live in separate arrays, and a third array holds one control
+ * byte per slot: either EMPTY, DELETED, or the low 7 bits of the hash of the key
+ * in that slot. Lookups compare a whole group of control bytes against those 7
+ * bits at once (with SSE2 or NEON where available), so the keymatch callback
+ * is only called for slots that are very likely to hold the key.
+ *
+ * Slots are probed linearly one group at a time, starting at the slot picked by
+ * the high bits of the hash, until a group with an EMPTY slot is found. The
+ * first GROUP_SIZE - 1 control bytes are mirrored past the end of the array so
+ * a group can always be loaded with a single unaligned read.
+ */
+#define CTRL_EMPTY   0x80
+#define CTRL_DELETED 0xFE
+#define CTRL_H2(hash) ((Uint8)((hash) & 0x7F))
+#define IS_FULL(ctrl) (((ctrl) & 0x80) == 0)
+
+#define GROUP_SIZE 16u
+#define INVALID_SLOT 0xFFFFFFFFu
+
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HT_GROUP_SSE2
+typedef Uint32 GroupBits;
+#define GROUP_BITS_PER_SLOT 1
+#elif defined(SDL_NEON_INTRINSICS)
+#define HT_GROUP_NEON
+typedef Uint64 GroupBits;
+#define GROUP_BITS_PER_SLOT 4
+#else
+typedef Uint32 GroupBits;
+#define GROUP_BITS_PER_SLOT 1
+#endif
 
-// Must be a power of 2 >= sizeof(SDL_HashItem)
-#define MAX_HASHITEM_SIZEOF 32u
-SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) <= MAX_HASHITEM_SIZEOF);
+// The load factor is capped at 7/8, so a probe always finds an EMPTY slot eventually
+#define MAX_LOAD(capacity) ((capacity) - ((capacity) / 8))
 
 // Anything larger than this will cause integer overflows
-#define MAX_HASHTABLE_SIZE (0x80000000u / (MAX_HASHITEM_SIZEOF))
+#define MAX_HASHTABLE_SIZE (0x80000000u / 32u)
 
 struct SDL_HashTable
 {
     SDL_RWLock *lock;
-    SDL_HashItem *table;
+    const void **keys;
+    const void **values;
+    Uint8 *ctrl;
     SDL_HashTable_HashFn hash;
     SDL_HashTable_KeyMatchFn keymatch;
     SDL_HashTable_NukeFn nuke;
     void *data;
     Uint32 hash_mask;
-    Uint32 max_probe_len;
-    Uint32 num_occupied_slots;
+    Uint32 hash_shift;
+    Uint32 num_live;
+    Uint32 num_deleted;
     bool stackable;
 };
 
-SDL_HashTable *SDL_CreateHashTable(void *data,
-                                   Uint32 num_buckets,
-                                   SDL_HashTable_HashFn hashfn,
-                                   SDL_HashTable_KeyMatchFn keymatchfn,
-                                   SDL_HashTable_NukeFn nukefn,
-                                   bool threadsafe,
-                                   bool stackable)
+// Bits set for each slot in the group whose control byte equals `value`
+static SDL_INLINE GroupBits group_match(const Uint8 *ctrl, Uint8 value)
 {
-    SDL_HashTable *table;
-
-    // num_buckets must be a power of two so we can derive the bucket index with just a bit-and.
-    if ((num_buckets < 1) || !SDL_HasExactlyOneBitSet32(num_buckets)) {
-        SDL_SetError("num_buckets must be a power of two");
-        return NULL;
-    }
-
-    if (num_buckets > MAX_HASHTABLE_SIZE) {
-        SDL_SetError("num_buckets is too large");
-        return NULL;
+#ifdef HT_GROUP_SSE2
+    const __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+    return (GroupBits)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+#elif defined(HT_GROUP_NEON)
+    const uint8x16_t eq = vceqq_u8(vld1q_u8(ctrl), vdupq_n_u8(value));
+    const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+#else
+    GroupBits bits = 0;
+    for (Uint32 i = 0; i < GROUP_SIZE; ++i) {
+        if (ctrl[i] == value) {
+            bits |= (1u << i);
+        }
     }
+    return bits;
+#endif
+}
 
-    table = (SDL_HashTable *)SDL_calloc(1, sizeof(SDL_HashTable));
-    if (!table) {
-        return NULL;
+// Bits set for each slot in the group that is EMPTY or DELETED
+static SDL_INLINE GroupBits group_match_free(const Uint8 *ctrl)
+{
+#ifdef HT_GROUP_SSE2
+    return (GroupBits)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#elif defined(HT_GROUP_NEON)
+    const uint8x16_t high = vcltq_s8(vreinterpretq_s8_u8(vld1q_u8(ctrl)), vdupq_n_s8(0));
+    const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(high), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ull;
+#else
+    GroupBits bits = 0;
+    for (Uint32 i = 0; i < GROUP_SIZE; ++i) {
+        if (!IS_FULL(ctrl[i])) {
+            bits |= (1u << i);
+        }
     }
+    return bits;
+#endif
+}
 
-    if (threadsafe) {
-        // Don't fail if we can't create a lock (single threaded environment?)
-        table->lock = SDL_CreateRWLock();
+// Index of the lowest slot set in a non-empty group bitmask
+static SDL_INLINE Uint32 group_lowest(GroupBits bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    if (sizeof(bits) == sizeof(Uint64)) {
+        return (Uint32)__builtin_ctzll((unsigned long long)bits) / GROUP_BITS_PER_SLOT;
     }
-
-    table->table = (SDL_HashItem *)SDL_calloc(num_buckets, sizeof(SDL_HashItem));
-    if (!table->table) {
-        SDL_DestroyHashTable(table);
-        return NULL;
+    return (Uint32)__builtin_ctz((unsigned int)bits) / GROUP_BITS_PER_SLOT;
+#else
+    Uint32 index = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++index;
     }
-
-    table->hash_mask = num_buckets - 1;
-    table->stackable = stackable;
-    table->data = data;
-    table->hash = hashfn;
-    table->keymatch = keymatchfn;
-    table->nuke = nukefn;
-    return table;
+    return index / GROUP_BITS_PER_SLOT;
+#endif
 }
 
+#define HASH_BIT_MIXER 0x9E3779B1u
+
 static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    const Uint32 BitMixer = 0x9E3779B1u;
-    return table->hash(key, table->data) * BitMixer;
+    return table->hash(key, table->data) * HASH_BIT_MIXER;
 }
 
-static SDL_INLINE Uint32 get_probe_length(Uint32 zero_idx, Uint32 actual_idx, Uint32 num_buckets)
+// The first slot to probe for a hash; the high bits are the best mixed by calc_hash()
+static SDL_INLINE Uint32 home_slot(const SDL_HashTable *ht, Uint32 hash)
 {
-    // returns the probe sequence length from zero_idx to actual_idx
+    return (Uint32)((Uint64)hash >> ht->hash_shift) & ht->hash_mask;
+}
 
-    if (actual_idx < zero_idx) {
-        return num_buckets - zero_idx + actual_idx;
+static SDL_INLINE void set_ctrl(SDL_HashTable *ht, Uint32 i, Uint8 value)
+{
+    ht->ctrl[i] = value;
+    if (i < GROUP_SIZE - 1) {
+        // Keep the mirrored bytes past the end in sync
+        ht->ctrl[ht->hash_mask + 1 + i] = value;
     }
-
-    return actual_idx - zero_idx;
 }
 
-static SDL_HashItem *find_item(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 *i, Uint32 *probe_len)
+// Find the next slot holding `key`, starting at slot `pos`, or INVALID_SLOT if there isn't one
+static Uint32 find_slot(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 pos)
 {
-    Uint32 hash_mask = ht->hash_mask;
-    Uint32 max_probe_len = ht->max_probe_len;
-
-    SDL_HashItem *table = ht->table;
+    const Uint8 h2 = CTRL_H2(hash);
+    const Uint32 hash_mask = ht->hash_mask;
 
     for (;;) {
-        SDL_HashItem *item = table + *i;
-        Uint32 item_hash = item->hash;
-
-        if (!item->live) {
-            return NULL;
-        }
-
-        if (item_hash == hash && ht->keymatch(item->key, key, ht->data)) {
-            return item;
-        }
-
-        Uint32 item_probe_len = item->probe_len;
-        HT_ASSERT(item_probe_len == get_probe_length(item_hash & hash_mask, (Uint32)(item - table), hash_mask + 1));
+        const Uint8 *group = ht->ctrl + pos;
+        GroupBits bits = group_match(group, h2);
 
-        if (*probe_len > item_probe_len) {
-            return NULL;
+        while (bits) {
+            const Uint32 i = (pos + group_lowest(bits)) & hash_mask;
+            if (ht->keymatch(ht->keys[i], key, ht->data)) {
+                return i;
+            }
+            bits &= bits - 1;
         }
 
-        if (++*probe_len > max_probe_len) {
-            return NULL;
+        if (group_match(group, CTRL_EMPTY)) {
+            return INVALID_SLOT;
         }
 
-        *i = (*i + 1) & hash_mask;
+        pos = (pos + GROUP_SIZE) & hash_mask;
     }
 }
 
-static SDL_HashItem *find_first_item(const SDL_HashTable *ht, const void *key, Uint32 hash)
+// Find the first EMPTY or DELETED slot for a hash
+static Uint32 find_free_slot(const SDL_HashTable *ht, Uint32 hash)
 {
-    Uint32 i = hash & ht->hash_mask;
-    Uint32 probe_len = 0;
-    return find_item(ht, key, hash, &i, &probe_len);
-}
-
-static SDL_HashItem *insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *table, Uint32 hash_mask, Uint32 *max_probe_len_ptr)
-{
-    Uint32 idx = item_to_insert->hash & hash_mask;
-    SDL_HashItem temp_item, *target = NULL;
-    Uint32 num_buckets = hash_mask + 1;
+    const Uint32 hash_mask = ht->hash_mask;
+    Uint32 pos = home_slot(ht, hash);
 
     for (;;) {
-        SDL_HashItem *candidate = table + idx;
-
-        if (!candidate->live) {
-            // Found an empty slot. Put it here and we're done.
-
-            *candidate = *item_to_insert;
-
-            if (target == NULL) {
-                target = candidate;
-            }
-
-            Uint32 probe_len = get_probe_length(candidate->hash & hash_mask, idx, num_buckets);
-            candidate->probe_len = probe_len;
-
-            if (*max_probe_len_ptr < probe_len) {
-                *max_probe_len_ptr = probe_len;
-            }
-
-            break;
+        const GroupBits bits = group_match_free(ht->ctrl + pos);
+        if (bits) {
+            return (pos + group_lowest(bits)) & hash_mask;
         }
+        pos = (pos + GROUP_SIZE) & hash_mask;
+    }
+}
 
-        Uint32 candidate_probe_len = candidate->probe_len;
-        HT_ASSERT(candidate_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-        Uint32 new_probe_len = get_probe_length(item_to_insert->hash & hash_mask, idx, num_buckets);
-
-        if (candidate_probe_len < new_probe_len) {
-            // Robin Hood hashing: the item at idx has a better probe length than our item would at this position.
-            // Evict it and put our item in its place, then continue looking for a new spot for the displaced item.
-            // This algorithm significantly reduces clustering in the table, making lookups take very few probes.
-
-            temp_item = *candidate;
-            *candidate = *item_to_insert;
-
-            if (target == NULL) {
-                target = candidate;
-            }
-
-            *item_to_insert = temp_item;
-
-            HT_ASSERT(new_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-            candidate->probe_len = new_probe_len;
-
-            if (*max_probe_len_ptr < new_probe_len) {
-                *max_probe_len_ptr = new_probe_len;
-            }
-        }
+static bool alloc_slots(SDL_HashTable *ht, Uint32 capacity)
+{
+    const size_t ptrs_size = (size_t)capacity * sizeof(void *);
+    const size_t ctrl_size = (size_t)capacity + GROUP_SIZE - 1;
+    Uint8 *block = (Uint8 *)SDL_malloc(2 * ptrs_size + ctrl_size);
 
-        idx = (idx + 1) & hash_mask;
+    if (!block) {
+        return false;
     }
 
-    return target;
+    ht->keys = (const void **)block;
+    ht->values = (const void **)(block + ptrs_size);
+    ht->ctrl = block + 2 * ptrs_size;
+    SDL_memset(ht->ctrl, CTRL_EMPTY, ctrl_size);
+
+    ht->hash_mask = capacity - 1;
+    ht->hash_shift = 32 - (Uint32)SDL_MostSignificantBitIndex32(capacity);
+    ht->num_live = 0;
+    ht->num_deleted = 0;
+    return true;
 }
 
-static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
+SDL_HashTable *SDL_CreateHashTable(void *data,
+                                   Uint32 num_buckets,
+                                   SDL_HashTable_HashFn hashfn,
+                                   SDL_HashTable_KeyMatchFn keymatchfn,
+                                   SDL_HashTable_NukeFn nukefn,
+                                   bool threadsafe,
+                                   bool stackable)
 {
-    Uint32 hash_mask = ht->hash_mask;
-    SDL_HashItem *table = ht->table;
+    SDL_HashTable *table;
 
-    if (ht->nuke) {
-        ht->nuke(item->key, item->value, ht->data);
+    // num_buckets must be a power of two so we can derive the bucket index with just a bit-and.
+    if ((num_buckets < 1) || !SDL_HasExactlyOneBitSet32(num_buckets)) {
+        SDL_SetError("num_buckets must be a power of two");
+        return NULL;
     }
-    ht->num_occupied_slots--;
 
-    Uint32 idx = (Uint32)(item - ht->table);
+    if (num_buckets > MAX_HASHTABLE_SIZE) {
+        SDL_SetError("num_buckets is too large");
+        return NULL;
+    }
 
-    for (;;) {
-        idx = (idx + 1) & hash_mask;
-        SDL_HashItem *next_item = table + idx;
+    // We need at least one full group of slots
+    if (num_buckets < GROUP_SIZE) {
+        num_buckets = GROUP_SIZE;
+    }
 
-        if (next_item->probe_len < 1) {
-            SDL_zerop(item);
-            return;
-        }
+    table = (SDL_HashTable *)SDL_calloc(1, sizeof(SDL_HashTable));
+    if (!table) {
+        return NULL;
+    }
+
+    if (threadsafe) {
+        // Don't fail if we can't create a lock (single threaded environment?)
+        table->lock = SDL_CreateRWLock();
+    }
 
-        *item = *next_item;
-        item->probe_len -= 1;
-        HT_ASSERT(item->probe_len < ht->max_probe_len);
-        item = next_item;
+    if (!alloc_slots(table, num_buckets)) {
+        SDL_DestroyHashTable(table);
+        return NULL;
     }
+
+    table->stackable = stackable;
+    table->data = data;
+    table->hash = hashfn;
+    table->keymatch = keymatchfn;
+    table->nuke = nukefn;
+    return table;
 }
 
 static bool resize(SDL_HashTable *ht, Uint32 new_size)
 {
-    SDL_HashItem *old_table = ht->table;
-    Uint32 old_size = ht->hash_mask + 1;
-    Uint32 new_hash_mask = new_size - 1;
-    SDL_HashItem *new_table = SDL_calloc(new_size, sizeof(*new_table));
-
-    if (!new_table) {
+    const void **old_keys = ht->keys;
+    const void **old_values = ht->values;
+    const Uint8 *old_ctrl = ht->ctrl;
+    const Uint32 old_size = ht->hash_mask + 1;
+    const Uint32 num_live = ht->num_live;
+
+    // alloc_slots() leaves the table untouched if it fails
+    if (!alloc_slots(ht, new_size)) {
         return false;
     }
 
-    ht->max_probe_len = 0;
-    ht->hash_mask = new_hash_mask;
-    ht->table = new_table;
-
     for (Uint32 i = 0; i < old_size; ++i) {
-        SDL_HashItem *item = old_table + i;
-        if (item->live) {
-            insert_item(item, new_table, new_hash_mask, &ht->max_probe_len);
+        if (IS_FULL(old_ctrl[i])) {
+            const Uint32 hash = calc_hash(ht, old_keys[i]);
+            const Uint32 slot = find_free_slot(ht, hash);
+
+            HT_ASSERT(CTRL_H2(hash) == old_ctrl[i]);
+            set_ctrl(ht, slot, CTRL_H2(hash));
+            ht->keys[slot] = old_keys[i];
+            ht->values[slot] = old_values[i];
         }
     }
+    ht->num_live = num_live;
 
-    SDL_free(old_table);
+    // The keys, values and control bytes are all one allocation
+    SDL_free((void *)old_keys);
     return true;
 }
 
+// Make sure there's room to use one more slot
 static bool maybe_resize(SDL_HashTable *ht)
 {
-    Uint32 capacity = ht->hash_mask + 1;
+    const Uint32 capacity = ht->hash_mask + 1;
+
+    if (ht->num_live + ht->num_deleted < MAX_LOAD(capacity)) {
+        return true;
+    }
+
+    if (ht->num_live < MAX_LOAD(capacity) / 2) {
+        // Mostly DELETED slots, clean them out without growing
+        return resize(ht, capacity);
+    }
 
     if (capacity >= MAX_HASHTABLE_SIZE) {
         return false;
     }
+    return resize(ht, capacity * 2);
+}
 
-    Uint32 max_load_factor = 217; // range: 0-255; 217 is roughly 85%
-    Uint32 resize_threshold = (Uint32)((max_load_factor * (Uint64)capacity) >> 8);
-
-    if (ht->num_occupied_slots > resize_threshold) {
-        return resize(ht, capacity * 2);
+static void delete_slot(SDL_HashTable *ht, Uint32 i)
+{
+    if (ht->nuke) {
+        ht->nuke(ht->keys[i], ht->values[i], ht->data);
     }
 
-    return true;
+    /* A probe stops at the first group with an EMPTY slot. Empty slots only ever
+       spread backwards from other empty slots, so this one can be EMPTY if the
+       next one is; there can't be a key past it that was probed through it. */
+    if (ht->ctrl[(i + 1) & ht->hash_mask] == CTRL_EMPTY) {
+        set_ctrl(ht, i, CTRL_EMPTY);
+    } else {
+        set_ctrl(ht, i, CTRL_DELETED);
+        ht->num_deleted++;
+    }
+    ht->keys[i] = NULL;
+    ht->values[i] = NULL;
+    ht->num_live--;
 }
 
 bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value)
 {
-    SDL_HashItem *item;
-    Uint32 hash;
+    Uint32 hash, slot;
     bool result = false;
 
     if (!table) {
@@ -330,29 +383,33 @@ bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *
     }
 
     hash = calc_hash(table, key);
-    item = find_first_item(table, key, hash);
 
-    if (item && !table->stackable) {
-        // Allow overwrites, this might have been inserted on another thread
-        delete_item(table, item);
+    if (!table->stackable) {
+        slot = find_slot(table, key, hash, home_slot(table, hash));
+        if (slot != INVALID_SLOT) {
+            // Allow overwrites, this might have been inserted on another thread
+            if (table->nuke) {
+                table->nuke(table->keys[slot], table->values[slot], table->data);
+            }
+            table->keys[slot] = key;
+            table->values[slot] = value;
+            result = true;
+            goto done;
+        }
     }
 
-    SDL_HashItem new_item;
-    new_item.key = key;
-    new_item.value = value;
-    new_item.hash = hash;
-    new_item.live = true;
-    new_item.probe_len = 0;
-
-    table->num_occupied_slots++;
-
     if (!maybe_resize(table)) {
-        table->num_occupied_slots--;
         goto done;
     }
 
-    // This never returns NULL
-    insert_item(&new_item, table->table, table->hash_mask, &table->max_probe_len);
+    slot = find_free_slot(table, hash);
+    if (table->ctrl[slot] == CTRL_DELETED) {
+        table->num_deleted--;
+    }
+    set_ctrl(table, slot, CTRL_H2(hash));
+    table->keys[slot] = key;
+    table->values[slot] = value;
+    table->num_live++;
     result = true;
 
 done:
@@ -364,8 +421,19 @@ done:
 
 bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **value)
 {
-    Uint32 hash;
-    SDL_HashItem *i;
+    if (!table) {
+        if (value) {
+            *value = NULL;
+        }
+        return false;
+    }
+
+    return SDL_FindInHashTableWithHash(table, key, table->hash(key, table->data), value);
+}
+
+bool SDL_FindInHashTableWithHash(const SDL_HashTable *table, const void *key, Uint32 hash, const void **value)
+{
+    Uint32 slot;
     bool result = false;
 
     if (!table) {
@@ -379,11 +447,11 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
         SDL_LockRWLockForReading(table->lock);
     }
 
-    hash = calc_hash(table, key);
-    i = find_first_item(table, key, hash);
-    if (i) {
+    hash *= HASH_BIT_MIXER;
+    slot = find_slot(table, key, hash, home_slot(table, hash));
+    if (slot != INVALID_SLOT) {
         if (value) {
-            *value = i->value;
+            *value = table->values[slot];
         }
         result = true;
     }
@@ -396,8 +464,7 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
 
 bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
 {
-    Uint32 hash;
-    SDL_HashItem *item;
+    Uint32 hash, slot;
     bool result = false;
 
     if (!table) {
@@ -409,18 +476,16 @@ bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
     }
 
     // FIXME: what to do for stacking hashtables?
-    // The original code removes just one item.
-    // This hashtable happens to preserve the insertion order of multi-value keys,
-    // so deleting the first one will always delete the least-recently inserted one.
-    // But maybe it makes more sense to remove all matching items?
+    // This removes just the first matching item found along the probe sequence.
+    // Maybe it makes more sense to remove all matching items?
 
     hash = calc_hash(table, key);
-    item = find_first_item(table, key, hash);
-    if (!item) {
+    slot = find_slot(table, key, hash, home_slot(table, hash));
+    if (slot == INVALID_SLOT) {
         goto done;
     }
 
-    delete_item(table, item);
+    delete_slot(table, slot);
     result = true;
 
 done:
@@ -430,67 +495,55 @@ done:
     return result;
 }
 
+// The iterators store the slot index plus one, so NULL is the start of the iteration
+
 bool SDL_IterateHashTableKey(const SDL_HashTable *table, const void *key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = (SDL_HashItem *)*iter;
+    Uint32 hash, pos, slot;
 
     if (!table) {
         return false;
     }
 
-    Uint32 i, probe_len, hash;
-
-    if (item) {
-        HT_ASSERT(item >= table->table);
-        HT_ASSERT(item < table->table + (table->hash_mask + 1));
-
-        hash = item->hash;
-        probe_len = item->probe_len + 1;
-        i = ((Uint32)(item - table->table) + 1) & table->hash_mask;
-        item = table->table + i;
+    hash = calc_hash(table, key);
+    if (*iter) {
+        // Carry on probing from the slot after the last one we found
+        const Uint32 last = (Uint32)((uintptr_t)*iter - 1);
+        HT_ASSERT(last <= table->hash_mask);
+        pos = (last + 1) & table->hash_mask;
     } else {
-        hash = calc_hash(table, key);
-        i = hash & table->hash_mask;
-        probe_len = 0;
+        pos = home_slot(table, hash);
     }
 
-    item = find_item(table, key, hash, &i, &probe_len);
-
-    if (!item) {
+    slot = find_slot(table, key, hash, pos);
+    if (slot == INVALID_SLOT) {
         *_value = NULL;
         return false;
     }
 
-    *_value = item->value;
-    *iter = item;
+    *_value = table->values[slot];
+    *iter = (void *)((uintptr_t)slot + 1);
 
     return true;
 }
 
 bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const void **_value, void **iter)
 {
-    SDL_HashItem *item = (SDL_HashItem *)*iter;
+    Uint32 i, end;
 
     if (!table) {
         return false;
     }
 
-    if (!item) {
-        item = table->table;
-    } else {
-        item++;
-    }
-
-    HT_ASSERT(item >= table->table);
-    SDL_HashItem *end = table->table + (table->hash_mask + 1);
+    i = (Uint32)(uintptr_t)*iter;
+    end = table->hash_mask + 1;
+    HT_ASSERT(i <= end);
 
-    while (item < end && !item->live) {
-        ++item;
+    while (i < end && !IS_FULL(table->ctrl[i])) {
+        ++i;
     }
 
-    HT_ASSERT(item <= end);
-
-    if (item == end) {
+    if (i == end) {
         if (_key) {
             *_key = NULL;
         }
@@ -501,30 +554,29 @@ bool SDL_IterateHashTable(const SDL_HashTable *table, const void **_key, const v
     }
 
     if (_key) {
-        *_key = item->key;
+        *_key = table->keys[i];
     }
     if (_value) {
-        *_value = item->value;
+        *_value = table->values[i];
     }
-    *iter = item;
+    *iter = (void *)((uintptr_t)i + 1);
 
     return true;
 }
 
 bool SDL_HashTableEmpty(SDL_HashTable *table)
 {
-    return !(table && table->num_occupied_slots);
+    return !(table && table->num_live);
 }
 
 static void nuke_all(SDL_HashTable *table)
 {
     void *data = table->data;
-    SDL_HashItem *end = table->table + (table->hash_mask + 1);
-    SDL_HashItem *i;
+    const Uint32 end = table->hash_mask + 1;
 
-    for (i = table->table; i < end; ++i) {
-        if (i->live) {
-            table->nuke(i->key, i->value, data);
+    for (Uint32 i = 0; i < end; ++i) {
+        if (IS_FULL(table->ctrl[i])) {
+            table->nuke(table->keys[i], table->values[i], data);
         }
     }
 }
@@ -538,8 +590,9 @@ void SDL_EmptyHashTable(SDL_HashTable *table)
                 nuke_all(table);
             }
 
-            SDL_memset(table->table, 0, sizeof(*table->table) * (table->hash_mask + 1));
-            table->num_occupied_slots = 0;
+            SDL_memset(table->ctrl, CTRL_EMPTY, (size_t)table->hash_mask + GROUP_SIZE);
+            table->num_live = 0;
+            table->num_deleted = 0;
         }
         SDL_UnlockRWLock(table->lock);
     }
@@ -548,10 +601,13 @@ void SDL_EmptyHashTable(SDL_HashTable *table)
 void SDL_DestroyHashTable(SDL_HashTable *table)
 {
     if (table) {
-        SDL_EmptyHashTable(table);
+        if (table->keys) {
+            SDL_EmptyHashTable(table);
+        }
 
         SDL_DestroyRWLock(table->lock);
-        SDL_free(table->table);
+        // The keys, values and control bytes are all one allocation
+        SDL_free((void *)table->keys);
         SDL_free(table);
     }
 }
@@ -52,6 +52,9 @@ extern bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key);
 // This function is thread-safe if the hashtable was created with threadsafe = true
 extern bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void **_value);
 
+// look up a key whose hash was already computed with the table's hash function
+extern bool SDL_FindInHashTableWithHash(const SDL_HashTable *table, const void *key, Uint32 hash, const void **_value);
+
 // This function is thread-safe if the hashtable was created with threadsafe = true
 extern bool SDL_HashTableEmpty(SDL_HashTable *table);
 
@@ -46,14 +46,28 @@ typedef struct
 {
     SDL_HashTable *props;
     SDL_Mutex *lock;
+    SDL_AtomicInt frozen;
 } SDL_Properties;
 
 static SDL_InitState SDL_properties_init;
 static SDL_HashTable *SDL_properties;
+static SDL_HashTable *SDL_property_names;
+static SDL_Mutex *SDL_property_names_lock;
 static SDL_AtomicU32 SDL_last_properties_id;
 static SDL_AtomicU32 SDL_global_properties;
 
 
+// Returns the interned copy of a name, or NULL if no SDL_PropertyKey was made for it
+static const char *SDL_FindInternedPropertyName(const char *name)
+{
+    const char *interned = NULL;
+
+    if (!SDL_property_names || !SDL_FindInHashTable(SDL_property_names, name, (const void **)&interned)) {
+        return NULL;
+    }
+    return interned;
+}
+
 static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, bool cleanup)
 {
     SDL_Property *property = (SDL_Property *)value;
@@ -72,7 +86,10 @@ static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void
         }
         SDL_free(property->string_storage);
     }
-    SDL_free((void *)key);
+    // Interned names are owned by SDL_property_names, any other name belongs to this property
+    if (key && key != SDL_FindInternedPropertyName((const char *)key)) {
+        SDL_free((void *)key);
+    }
     SDL_free((void *)value);
 }
 
@@ -107,6 +124,14 @@ bool SDL_InitProperties(void)
         goto error;
     }
 
+    SDL_property_names = SDL_CreateHashTable(NULL, 64, SDL_HashString, SDL_KeyMatchString, SDL_NukeFreeKey, true, false);
+    if (!SDL_property_names) {
+        goto error;
+    }
+
+    // If this fails we'll continue without it.
+    SDL_property_names_lock = SDL_CreateMutex();
+
     SDL_SetInitialized(&SDL_properties_init, true);
     return true;
 
@@ -143,6 +168,13 @@ void SDL_QuitProperties(void)
         SDL_properties = NULL;
     }
 
+    // Every property set is gone, so nothing refers to the interned names anymore.
+    // This has to come last, freeing a property checks whether its name is interned.
+    SDL_DestroyHashTable(SDL_property_names);
+    SDL_property_names = NULL;
+    SDL_DestroyMutex(SDL_property_names_lock);
+    SDL_property_names_lock = NULL;
+
     SDL_SetInitialized(&SDL_properties_init, false);
 }
 
@@ -151,6 +183,96 @@ static bool SDL_CheckInitProperties(void)
     return SDL_InitProperties();
 }
 
+/* Names passed to SDL_GetPropertyKey() are interned, so every set shares one
+ * copy of them and a lookup with the key matches on the first pointer comparison.
+ * Interned names are only freed by SDL_QuitProperties(), so other names are
+ * copied into each set instead, otherwise arbitrary app names would pile up.
+ */
+static const char *SDL_InternPropertyName(const char *name)
+{
+    const char *interned;
+    char *copy;
+
+    interned = SDL_FindInternedPropertyName(name);
+    if (interned) {
+        return interned;
+    }
+
+    SDL_LockMutex(SDL_property_names_lock);
+    {
+        // Somebody else might have interned it while we weren't holding the lock
+        if (!SDL_FindInHashTable(SDL_property_names, name, (const void **)&interned)) {
+            copy = SDL_strdup(name);
+            if (copy) {
+                if (SDL_InsertIntoHashTable(SDL_property_names, copy, copy)) {
+                    interned = copy;
+                } else {
+                    SDL_free(copy);
+                }
+            }
+        }
+    }
+    SDL_UnlockMutex(SDL_property_names_lock);
+
+    return interned;
+}
+
+bool SDL_GetPropertyKey(const char *name, SDL_PropertyKey *key)
+{
+    SDL_zerop(key);
+
+    if (!name || !*name) {
+        return SDL_InvalidParamError("name");
+    }
+
+    if (!SDL_CheckInitProperties()) {
+        return false;
+    }
+
+    key->name = SDL_InternPropertyName(name);
+    if (!key->name) {
+        return false;
+    }
+    key->hash = SDL_HashString(key->name, NULL);
+    return true;
+}
+
+// Returns the name for a set to own, sharing the interned copy if there is one
+static const char *SDL_CopyPropertyName(const char *name)
+{
+    const char *interned = SDL_FindInternedPropertyName(name);
+    if (interned) {
+        return interned;
+    }
+    return SDL_strdup(name);
+}
+
+static SDL_Properties *SDL_GetProperties(SDL_PropertiesID props)
+{
+    SDL_Properties *properties = NULL;
+
+    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    return properties;
+}
+
+// Frozen properties never change, so they can be read without the lock
+static bool SDL_LockPropertiesForReading(SDL_Properties *properties)
+{
+    if (SDL_GetAtomicInt(&properties->frozen)) {
+        return false;
+    }
+    SDL_LockMutex(properties->lock);
+    return true;
+}
+
+static SDL_Property *SDL_FindProperty(SDL_Properties *properties, const char *name, Uint32 hash)
+{
+    SDL_Property *property = NULL;
+
+    SDL_FindInHashTableWithHash(properties->props, name, hash, (const void **)&property);
+    return property;
+}
+
 SDL_PropertiesID SDL_GetGlobalProperties(void)
 {
     SDL_PropertiesID props = SDL_GetAtomicU32(&SDL_global_properties);
@@ -234,15 +356,16 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
 
     SDL_LockMutex(src_properties->lock);
     SDL_LockMutex(dst_properties->lock);
-    {
+    if (SDL_GetAtomicInt(&dst_properties->frozen)) {
+        result = SDL_SetError("Can't modify frozen properties");
+    } else {
         void *iter;
         const void *key, *value;
 
         iter = NULL;
         while (SDL_IterateHashTable(src_properties->props, &key, &value, &iter)) {
-            const char *src_name = (const char *)key;
+            const char *name = (const char *)key;
             const SDL_Property *src_property = (const SDL_Property *)value;
-            char *dst_name;
             SDL_Property *dst_property;
 
             if (src_property->cleanup) {
@@ -250,25 +373,21 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
                 continue;
             }
 
-            SDL_RemoveFromHashTable(dst_properties->props, src_name);
+            SDL_RemoveFromHashTable(dst_properties->props, name);
 
-            dst_name = SDL_strdup(src_name);
-            if (!dst_name) {
-                result = false;
-                continue;
-            }
             dst_property = (SDL_Property *)SDL_malloc(sizeof(*dst_property));
             if (!dst_property) {
-                SDL_free(dst_name);
                 result = false;
                 continue;
             }
             SDL_copyp(dst_property, src_property);
+            dst_property->string_storage = NULL;
             if (src_property->type == SDL_PROPERTY_TYPE_STRING) {
                 dst_property->value.string_value = SDL_strdup(src_property->value.string_value);
             }
-            if (!SDL_InsertIntoHashTable(dst_properties->props, dst_name, dst_property)) {
-                SDL_FreePropertyWithCleanup(dst_name, dst_property, NULL, false);
+            name = SDL_CopyPropertyName(name);
+            if (!name || !SDL_InsertIntoHashTable(dst_properties->props, name, dst_property)) {
+                SDL_FreePropertyWithCleanup(name, dst_property, NULL, false);
                 result = false;
             }
         }
@@ -312,6 +431,44 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
     SDL_UnlockMutex(properties->lock);
 }
 
+bool SDL_FreezeProperties(SDL_PropertiesID props)
+{
+    SDL_Properties *properties = NULL;
+
+    if (!props) {
+        return SDL_InvalidParamError("props");
+    }
+
+    properties = SDL_GetProperties(props);
+    if (!properties) {
+        return SDL_InvalidParamError("props");
+    }
+
+    SDL_LockMutex(properties->lock);
+    if (!SDL_GetAtomicInt(&properties->frozen)) {
+        void *iter;
+        const void *key, *value;
+
+        // Readers won't take the lock anymore, so fill in the string forms they would have cached
+        iter = NULL;
+        while (SDL_IterateHashTable(properties->props, &key, &value, &iter)) {
+            SDL_Property *property = (SDL_Property *)value;
+            if (property->string_storage) {
+                continue;
+            }
+            if (property->type == SDL_PROPERTY_TYPE_NUMBER) {
+                SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value);
+            } else if (property->type == SDL_PROPERTY_TYPE_FLOAT) {
+                SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
+            }
+        }
+        SDL_SetAtomicInt(&properties->frozen, 1);
+    }
+    SDL_UnlockMutex(properties->lock);
+
+    return true;
+}
+
 static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
@@ -333,11 +490,14 @@ static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL
     }
 
     SDL_LockMutex(properties->lock);
-    {
+    if (SDL_GetAtomicInt(&properties->frozen)) {
+        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        result = SDL_SetError("Can't modify frozen properties");
+    } else {
         SDL_RemoveFromHashTable(properties->props, name);
         if (property) {
-            char *key = SDL_strdup(name);
-            if (!SDL_InsertIntoHashTable(properties->props, key, property)) {
+            const char *key = SDL_CopyPropertyName(name);
+            if (!key || !SDL_InsertIntoHashTable(properties->props, key, property)) {
                 SDL_FreePropertyWithCleanup(key, property, NULL, true);
                 result = false;
             }
@@ -474,8 +634,9 @@ bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
 
 SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
 {
-    SDL_Properties *properties = NULL;
+    SDL_Properties *properties;
     SDL_PropertyType type = SDL_PROPERTY_TYPE_INVALID;
+    bool locked;
 
     if (!props) {
         return SDL_PROPERTY_TYPE_INVALID;
@@ -484,36 +645,31 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, name, SDL_HashString(name, NULL));
+        if (property) {
             type = property->type;
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    if (locked) {
+        SDL_UnlockMutex(properties->lock);
+    }
 
     return type;
 }
 
-void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
+static void *SDL_PrivateGetPointerProperty(SDL_PropertiesID props, const char *name, Uint32 hash, void *default_value)
 {
-    SDL_Properties *properties = NULL;
+    SDL_Properties *properties = SDL_GetProperties(props);
     void *value = default_value;
+    bool locked;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
-        return value;
-    }
-
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
     if (!properties) {
         return value;
     }
@@ -522,41 +678,65 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
      * hashtable while it's being modified. The value itself can easily be
      * freed from another thread after it is returned here.
      */
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, name, hash);
+        if (property) {
             if (property->type == SDL_PROPERTY_TYPE_POINTER) {
                 value = property->value.pointer_value;
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    if (locked) {
+        SDL_UnlockMutex(properties->lock);
+    }
 
     return value;
 }
 
+void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
+{
+    if (!props) {
+        return default_value;
+    }
+    if (!name || !*name) {
+        return default_value;
+    }
+
+    return SDL_PrivateGetPointerProperty(props, name, SDL_HashString(name, NULL), default_value);
+}
+
+void *SDL_GetPointerPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, void *default_value)
+{
+    if (!props || !key->name) {
+        return default_value;
+    }
+
+    return SDL_PrivateGetPointerProperty(props, key->name, key->hash, default_value);
+}
+
 const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
 {
-    SDL_Properties *properties = NULL;
+    SDL_Properties *properties;
     const char *value = default_value;
+    bool locked;
 
     if (!props) {
-        return value;
+        return default_value;
     }
     if (!name || !*name) {
-        return value;
+        return default_value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, name, SDL_HashString(name, NULL));
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = property->value.string_value;
@@ -564,7 +744,7 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
             case SDL_PROPERTY_TYPE_NUMBER:
                 if (property->string_storage) {
                     value = property->string_storage;
-                } else {
+                } else if (locked) {
                     SDL_asprintf(&property->string_storage, "%" SDL_PRIs64, property->value.number_value);
                     if (property->string_storage) {
                         value = property->string_storage;
@@ -574,7 +754,7 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
             case SDL_PROPERTY_TYPE_FLOAT:
                 if (property->string_storage) {
                     value = property->string_storage;
-                } else {
+                } else if (locked) {
                     SDL_asprintf(&property->string_storage, "%f", property->value.float_value);
                     if (property->string_storage) {
                         value = property->string_storage;
@@ -589,32 +769,35 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    if (locked) {
+        SDL_UnlockMutex(properties->lock);
+    }
 
     return value;
 }
 
 Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
 {
-    SDL_Properties *properties = NULL;
+    SDL_Properties *properties;
     Sint64 value = default_value;
+    bool locked;
 
     if (!props) {
-        return value;
+        return default_value;
     }
     if (!name || !*name) {
-        return value;
+        return default_value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, name, SDL_HashString(name, NULL));
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (Sint64)SDL_strtoll(property->value.string_value, NULL, 0);
@@ -633,32 +816,35 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    if (locked) {
+        SDL_UnlockMutex(properties->lock);
+    }
 
     return value;
 }
 
 float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
 {
-    SDL_Properties *properties = NULL;
+    SDL_Properties *properties;
     float value = default_value;
+    bool locked;
 
     if (!props) {
-        return value;
+        return default_value;
     }
     if (!name || !*name) {
-        return value;
+        return default_value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, name, SDL_HashString(name, NULL));
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (float)SDL_atof(property->value.string_value);
@@ -677,32 +863,35 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    if (locked) {
+        SDL_UnlockMutex(properties->lock);
+    }
 
     return value;
 }
 
 bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
 {
-    SDL_Properties *properties = NULL;
+    SDL_Properties *properties;
     bool value = default_value ? true : false;
+    bool locked;
 
     if (!props) {
-        return value;
+        return default_value ? true : false;
     }
     if (!name || !*name) {
-        return value;
+        return default_value ? true : false;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
-    SDL_LockMutex(properties->lock);
+    locked = SDL_LockPropertiesForReading(properties);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, name, SDL_HashString(name, NULL));
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_GetStringBoolean(property->value.string_value, default_value);
@@ -721,7 +910,9 @@ bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool defau
             }
         }
     }
-    SDL_UnlockMutex(properties->lock);
+    if (locked) {
+        SDL_UnlockMutex(properties->lock);
+    }
 
     return value;
 }
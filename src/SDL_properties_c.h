@@ -18,9 +18,26 @@
      misrepresented as being the original software.
   3. This notice may not be removed or altered from any source distribution.
 */
+#include "SDL_internal.h"
+
+#ifndef SDL_properties_c_h_
+#define SDL_properties_c_h_
+
+// A property name interned by SDL_GetPropertyKey(), with its hash computed up front.
+// Keys stay valid until SDL_QuitProperties(), so cache them in objects with a shorter lifetime.
+// Interned names are never freed before that, so only make keys for a fixed set of names.
+typedef struct SDL_PropertyKey
+{
+    const char *name;
+    Uint32 hash;
+} SDL_PropertyKey;
 
 extern bool SDL_InitProperties(void);
+extern bool SDL_GetPropertyKey(const char *name, SDL_PropertyKey *key);
+extern void *SDL_GetPointerPropertyByKey(SDL_PropertiesID props, const SDL_PropertyKey *key, void *default_value);
 extern bool SDL_SetFreeableProperty(SDL_PropertiesID props, const char *name, void *value);
 extern bool SDL_SetSurfaceProperty(SDL_PropertiesID props, const char *name, SDL_Surface *surface);
 extern bool SDL_DumpProperties(SDL_PropertiesID props);
 extern void SDL_QuitProperties(void);
+
+#endif // SDL_properties_c_h_
@@ -132,17 +132,197 @@ Uint32 SDL_GetNextObjectID(void)
     return id;
 }
 
+/* The object table is read far more often than it's written: every public call
+ * that takes a handle validates it. Readers never take a lock; they probe the
+ * current table through atomic loads. Writers are serialized by a mutex, and
+ * publish new entries by writing the type before the object pointer.
+ *
+ * When the table needs rebuilding, a new one is published and the old one is
+ * retired with a simple two-epoch scheme: readers count themselves in on one
+ * of a set of per-thread-striped counters for the current epoch, and the
+ * writer flips the epoch and waits for the old epoch's counters to drain
+ * before freeing the old table. Striping keeps readers on different threads
+ * from bouncing the same cache line around.
+ */
+#define SDL_OBJECT_READER_STRIPES 32
+#define SDL_OBJECT_MIN_SLOTS      32
+
+typedef struct SDL_ObjectSlot
+{
+    void *object;
+    SDL_AtomicInt type;
+} SDL_ObjectSlot;
+
+typedef struct SDL_ObjectTable
+{
+    SDL_ObjectSlot *slots;
+    Uint32 mask;
+    Uint32 shift;
+    Uint32 num_live;
+    Uint32 num_used;    // live entries plus tombstones
+} SDL_ObjectTable;
+
+typedef struct SDL_ObjectReaders
+{
+    SDL_AtomicInt active[2];
+    Uint8 padding[SDL_CACHELINE_SIZE - 2 * sizeof(SDL_AtomicInt)];
+} SDL_ObjectReaders;
+
 static SDL_InitState SDL_objects_init;
-static SDL_HashTable *SDL_objects;
+static SDL_Mutex *SDL_objects_lock;
+static SDL_ObjectTable *SDL_objects;
+static SDL_AtomicInt SDL_objects_epoch;
+static SDL_ObjectReaders SDL_object_readers[SDL_OBJECT_READER_STRIPES];
+static char SDL_object_tombstone;
+#define SDL_OBJECT_TOMBSTONE ((void *)&SDL_object_tombstone)
+
+static Uint32 SDL_HashObject(const SDL_ObjectTable *table, const void *object)
+{
+    // Allocations are at least 8 byte aligned, so drop the low bits before mixing
+    return (Uint32)(((Uint32)((uintptr_t)object >> 3) * 0x9E3779B1u) >> table->shift);
+}
 
-static Uint32 SDL_HashObject(const void *key, void *unused)
+static SDL_ObjectTable *SDL_CreateObjectTable(Uint32 num_slots)
 {
-    return (Uint32)(uintptr_t)key;
+    SDL_ObjectTable *table = (SDL_ObjectTable *)SDL_calloc(1, sizeof(*table) + num_slots * sizeof(SDL_ObjectSlot));
+    if (!table) {
+        return NULL;
+    }
+    table->slots = (SDL_ObjectSlot *)(table + 1);
+    table->mask = num_slots - 1;
+    table->shift = 32 - (Uint32)SDL_MostSignificantBitIndex32(num_slots);
+    return table;
 }
 
-static bool SDL_KeyMatchObject(const void *a, const void *b, void *unused)
+static SDL_ObjectReaders *SDL_GetObjectReaders(void)
 {
-    return (a == b);
+    const Uint64 id = (Uint64)SDL_GetCurrentThreadID();
+    return &SDL_object_readers[(Uint32)((id ^ (id >> 17)) * 0x9E3779B1u) >> 27];
+}
+SDL_COMPILE_TIME_ASSERT(object_reader_stripes, SDL_OBJECT_READER_STRIPES == (1 << (32 - 27)));
+
+// Wait until no reader can still be looking at a table that was just unpublished
+static void SDL_WaitForObjectReaders(void)
+{
+    const int epoch = SDL_AddAtomicInt(&SDL_objects_epoch, 1) & 1;
+
+    for (int i = 0; i < SDL_OBJECT_READER_STRIPES; ++i) {
+        int spins = 0;
+        while (SDL_GetAtomicInt(&SDL_object_readers[i].active[epoch]) != 0) {
+            // The reader may have been preempted, so don't spin for long
+            if (++spins < 64) {
+                SDL_CPUPauseInstruction();
+            } else {
+                SDL_Delay(0);
+            }
+        }
+    }
+}
+
+// Rebuild the table with room to grow, called with SDL_objects_lock held
+static bool SDL_RebuildObjectTable(void)
+{
+    SDL_ObjectTable *old_table = SDL_objects;
+    SDL_ObjectTable *new_table;
+    Uint32 num_live = old_table ? old_table->num_live : 0;
+    Uint32 num_slots = SDL_OBJECT_MIN_SLOTS;
+
+    // Keep the new table under half full
+    while (num_slots < (num_live + 1) * 2) {
+        num_slots *= 2;
+    }
+
+    new_table = SDL_CreateObjectTable(num_slots);
+    if (!new_table) {
+        return false;
+    }
+
+    if (old_table) {
+        for (Uint32 i = 0; i <= old_table->mask; ++i) {
+            void *object = old_table->slots[i].object;
+            if (object && object != SDL_OBJECT_TOMBSTONE) {
+                Uint32 slot = SDL_HashObject(new_table, object);
+                while (new_table->slots[slot].object) {
+                    slot = (slot + 1) & new_table->mask;
+                }
+                new_table->slots[slot].object = object;
+                SDL_SetAtomicInt(&new_table->slots[slot].type, SDL_GetAtomicInt(&old_table->slots[i].type));
+            }
+        }
+        new_table->num_live = num_live;
+        new_table->num_used = num_live;
+    }
+
+    SDL_SetAtomicPointer((void **)&SDL_objects, new_table);
+
+    if (old_table) {
+        SDL_WaitForObjectReaders();
+        SDL_free(old_table);
+    }
+    return true;
+}
+
+static void SDL_AddObject(void *object, SDL_ObjectType type)
+{
+    SDL_ObjectTable *table = SDL_objects;
+    Uint32 slot, free_slot = ~0u;
+
+    if (!table || (table->num_used + 1) * 4 > (table->mask + 1) * 3) {
+        if (!SDL_RebuildObjectTable()) {
+            return;
+        }
+        table = SDL_objects;
+    }
+
+    for (slot = SDL_HashObject(table, object); table->slots[slot].object; slot = (slot + 1) & table->mask) {
+        if (table->slots[slot].object == object) {
+            SDL_SetAtomicInt(&table->slots[slot].type, type);
+            return;
+        }
+        if (table->slots[slot].object == SDL_OBJECT_TOMBSTONE && free_slot == ~0u) {
+            free_slot = slot;
+        }
+    }
+
+    if (free_slot == ~0u) {
+        free_slot = slot;
+        table->num_used++;
+    }
+    table->num_live++;
+
+    // Readers check the object pointer first, so it has to be published last
+    SDL_SetAtomicInt(&table->slots[free_slot].type, type);
+    SDL_SetAtomicPointer(&table->slots[free_slot].object, object);
+}
+
+static void SDL_RemoveObject(void *object)
+{
+    SDL_ObjectTable *table = SDL_objects;
+    Uint32 slot;
+
+    if (!table) {
+        return;
+    }
+
+    for (slot = SDL_HashObject(table, object); table->slots[slot].object != object; slot = (slot + 1) & table->mask) {
+        if (!table->slots[slot].object) {
+            return;
+        }
+    }
+    table->num_live--;
+
+    /* If the next slot ends the probe sequence, this one can end it too, along
+       with any tombstones right before it. Readers looking for anything past
+       these slots would already have stopped at the next one. */
+    if (!table->slots[(slot + 1) & table->mask].object) {
+        do {
+            SDL_SetAtomicPointer(&table->slots[slot].object, NULL);
+            table->num_used--;
+            slot = (slot - 1) & table->mask;
+        } while (table->slots[slot].object == SDL_OBJECT_TOMBSTONE);
+    } else {
+        SDL_SetAtomicPointer(&table->slots[slot].object, SDL_OBJECT_TOMBSTONE);
+    }
 }
 
 void SDL_SetObjectValid(void *object, SDL_ObjectType type, bool valid)
@@ -150,43 +330,79 @@ void SDL_SetObjectValid(void *object, SDL_ObjectType type, bool valid)
     SDL_assert(object != NULL);
 
     if (valid && SDL_ShouldInit(&SDL_objects_init)) {
-        SDL_objects = SDL_CreateHashTable(NULL, 32, SDL_HashObject, SDL_KeyMatchObject, NULL, true, false);
-        if (!SDL_objects) {
-            SDL_SetInitialized(&SDL_objects_init, false);
-        }
+        // Don't fail if we can't create a lock (single threaded environment?)
+        SDL_objects_lock = SDL_CreateMutex();
         SDL_SetInitialized(&SDL_objects_init, true);
     }
 
+    SDL_LockMutex(SDL_objects_lock);
     if (valid) {
-        SDL_InsertIntoHashTable(SDL_objects, object, (void *)(uintptr_t)type);
+        SDL_AddObject(object, type);
     } else {
-        SDL_RemoveFromHashTable(SDL_objects, object);
+        SDL_RemoveObject(object);
     }
+    SDL_UnlockMutex(SDL_objects_lock);
 }
 
 bool SDL_ObjectValid(void *object, SDL_ObjectType type)
 {
+    SDL_ObjectReaders *readers;
+    SDL_ObjectTable *table;
+    bool result = false;
+    int epoch;
+
     if (!object) {
         return false;
     }
 
-    const void *object_type;
-    if (!SDL_FindInHashTable(SDL_objects, object, &object_type)) {
-        return false;
+    /* Register as a reader of the current epoch. If the epoch flipped before we
+       registered, a writer may already have waited on it and moved on, so try again. */
+    readers = SDL_GetObjectReaders();
+    for (;;) {
+        epoch = SDL_GetAtomicInt(&SDL_objects_epoch) & 1;
+        SDL_AtomicIncRef(&readers->active[epoch]);
+        if ((SDL_GetAtomicInt(&SDL_objects_epoch) & 1) == epoch) {
+            break;
+        }
+        SDL_AddAtomicInt(&readers->active[epoch], -1);
+    }
+
+    table = (SDL_ObjectTable *)SDL_GetAtomicPointer((void **)&SDL_objects);
+    if (table) {
+        Uint32 slot = SDL_HashObject(table, object);
+        for (;;) {
+            SDL_ObjectSlot *entry = &table->slots[slot];
+            void *current = SDL_GetAtomicPointer(&entry->object);
+            if (current == object) {
+                // Make sure the slot wasn't reused while we read the type
+                const SDL_ObjectType current_type = (SDL_ObjectType)SDL_GetAtomicInt(&entry->type);
+                result = (current_type == type && SDL_GetAtomicPointer(&entry->object) == object);
+                break;
+            }
+            if (!current) {
+                break;
+            }
+            slot = (slot + 1) & table->mask;
+        }
     }
 
-    return (((SDL_ObjectType)(uintptr_t)object_type) == type);
+    SDL_AddAtomicInt(&readers->active[epoch], -1);
+
+    return result;
 }
 
 void SDL_SetObjectsInvalid(void)
 {
     if (SDL_ShouldQuit(&SDL_objects_init)) {
         // Log any leaked objects
-        const void *object, *object_type;
-        void *iter = NULL;
-        while (SDL_IterateHashTable(SDL_objects, &object, &object_type, &iter)) {
+        SDL_ObjectTable *table = SDL_objects;
+        for (Uint32 i = 0; table && i <= table->mask; ++i) {
+            void *object = table->slots[i].object;
             const char *type;
-            switch ((SDL_ObjectType)(uintptr_t)object_type) {
+            if (!object || object == SDL_OBJECT_TOMBSTONE) {
+                continue;
+            }
+            switch ((SDL_ObjectType)SDL_GetAtomicInt(&table->slots[i].type)) {
             case SDL_OBJECT_TYPE_WINDOW:
                 type = "SDL_Window";
                 break;
@@ -223,10 +439,15 @@ void SDL_SetObjectsInvalid(void)
             }
             SDL_Log("Leaked %s (%p)\n", type, object);
         }
-        SDL_assert(SDL_HashTableEmpty(SDL_objects));
+        SDL_assert(!table || table->num_live == 0);
 
-        SDL_DestroyHashTable(SDL_objects);
-        SDL_objects = NULL;
+        if (table) {
+            SDL_SetAtomicPointer((void **)&SDL_objects, NULL);
+            SDL_WaitForObjectReaders();
+            SDL_free(table);
+        }
+        SDL_DestroyMutex(SDL_objects_lock);
+        SDL_objects_lock = NULL;
 
         SDL_SetInitialized(&SDL_objects_init, false);
     }
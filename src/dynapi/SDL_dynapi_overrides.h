@@ -1257,3 +1257,27 @@
 #define SDL_GetThreadState SDL_GetThreadState_REAL
 #define SDL_AudioStreamDevicePaused SDL_AudioStreamDevicePaused_REAL
 #define SDL_ClickTrayEntry SDL_ClickTrayEntry_REAL
+#define SDL_RenderTextureBatch SDL_RenderTextureBatch_REAL
+#define SDL_GetGPUPipelineCacheData SDL_GetGPUPipelineCacheData_REAL
+#define SDL_CreateGPUQueryPool SDL_CreateGPUQueryPool_REAL
+#define SDL_WriteGPUTimestamp SDL_WriteGPUTimestamp_REAL
+#define SDL_GetGPUQueryPoolResults SDL_GetGPUQueryPoolResults_REAL
+#define SDL_ReleaseGPUQueryPool SDL_ReleaseGPUQueryPool_REAL
+#define SDL_SetGPUPassTimingCallback SDL_SetGPUPassTimingCallback_REAL
+#define SDL_BeginGPUParallelRenderPass SDL_BeginGPUParallelRenderPass_REAL
+#define SDL_AcquireGPUSecondaryCommandBuffer SDL_AcquireGPUSecondaryCommandBuffer_REAL
+#define SDL_ExecuteGPUSecondaryCommandBuffers SDL_ExecuteGPUSecondaryCommandBuffers_REAL
+#define SDL_AllocateGPUTransientMemory SDL_AllocateGPUTransientMemory_REAL
+#define SDL_GetGPUBindlessTextureCapacity SDL_GetGPUBindlessTextureCapacity_REAL
+#define SDL_AddGPUBindlessTexture SDL_AddGPUBindlessTexture_REAL
+#define SDL_RemoveGPUBindlessTexture SDL_RemoveGPUBindlessTexture_REAL
+#define SDL_CreateGPUTextureStreamer SDL_CreateGPUTextureStreamer_REAL
+#define SDL_StreamGPUTexture SDL_StreamGPUTexture_REAL
+#define SDL_FlushGPUTextureStreamer SDL_FlushGPUTextureStreamer_REAL
+#define SDL_GetGPUTextureStreamResult SDL_GetGPUTextureStreamResult_REAL
+#define SDL_DestroyGPUTextureStreamer SDL_DestroyGPUTextureStreamer_REAL
+#define SDL_GetGPUMemoryStats SDL_GetGPUMemoryStats_REAL
+#define SDL_PollEvents SDL_PollEvents_REAL
+#define SDL_PushEvents SDL_PushEvents_REAL
+#define SDL_GetTimerStats SDL_GetTimerStats_REAL
+#define SDL_FreezeProperties SDL_FreezeProperties_REAL
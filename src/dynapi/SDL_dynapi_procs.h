@@ -1265,3 +1265,27 @@ SDL_DYNAPI_PROC(SDL_Tray*,SDL_GetTrayMenuParentTray,(SDL_TrayMenu *a),(a),return
 SDL_DYNAPI_PROC(SDL_ThreadState,SDL_GetThreadState,(SDL_Thread *a),(a),return)
 SDL_DYNAPI_PROC(bool,SDL_AudioStreamDevicePaused,(SDL_AudioStream *a),(a),return)
 SDL_DYNAPI_PROC(void,SDL_ClickTrayEntry,(SDL_TrayEntry *a),(a),)
+SDL_DYNAPI_PROC(bool,SDL_RenderTextureBatch,(SDL_Renderer *a,SDL_Texture *b,const SDL_TextureBatchItem *c,int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(void*,SDL_GetGPUPipelineCacheData,(SDL_GPUDevice *a,size_t *b),(a,b),return)
+SDL_DYNAPI_PROC(SDL_GPUQueryPool*,SDL_CreateGPUQueryPool,(SDL_GPUDevice *a,const SDL_GPUQueryPoolCreateInfo *b),(a,b),return)
+SDL_DYNAPI_PROC(void,SDL_WriteGPUTimestamp,(SDL_GPUCommandBuffer *a,SDL_GPUQueryPool *b,Uint32 c),(a,b,c),)
+SDL_DYNAPI_PROC(bool,SDL_GetGPUQueryPoolResults,(SDL_GPUDevice *a,SDL_GPUQueryPool *b,Uint32 c,Uint32 d,Uint64 *e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void,SDL_ReleaseGPUQueryPool,(SDL_GPUDevice *a,SDL_GPUQueryPool *b),(a,b),)
+SDL_DYNAPI_PROC(bool,SDL_SetGPUPassTimingCallback,(SDL_GPUDevice *a,SDL_GPUPassTimingCallback b,void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(SDL_GPURenderPass*,SDL_BeginGPUParallelRenderPass,(SDL_GPUCommandBuffer *a,const SDL_GPUColorTargetInfo *b,Uint32 c,const SDL_GPUDepthStencilTargetInfo *d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_GPUCommandBuffer*,SDL_AcquireGPUSecondaryCommandBuffer,(SDL_GPURenderPass *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ExecuteGPUSecondaryCommandBuffers,(SDL_GPURenderPass *a,SDL_GPUCommandBuffer *const*b,Uint32 c),(a,b,c),)
+SDL_DYNAPI_PROC(void*,SDL_AllocateGPUTransientMemory,(SDL_GPUCommandBuffer *a,Uint32 b,SDL_GPUBufferBinding *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Uint32,SDL_GetGPUBindlessTextureCapacity,(SDL_GPUDevice *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_AddGPUBindlessTexture,(SDL_GPUDevice *a,const SDL_GPUTextureSamplerBinding *b,Uint32 *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_RemoveGPUBindlessTexture,(SDL_GPUDevice *a,Uint32 b),(a,b),)
+SDL_DYNAPI_PROC(SDL_GPUTextureStreamer*,SDL_CreateGPUTextureStreamer,(SDL_GPUDevice *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_StreamGPUTexture,(SDL_GPUTextureStreamer *a,const SDL_GPUTextureStreamRequest *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_FlushGPUTextureStreamer,(SDL_GPUTextureStreamer *a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_GetGPUTextureStreamResult,(SDL_GPUTextureStreamer *a,void **b,bool *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyGPUTextureStreamer,(SDL_GPUTextureStreamer *a),(a),)
+SDL_DYNAPI_PROC(SDL_GPUMemoryHeapStats*,SDL_GetGPUMemoryStats,(SDL_GPUDevice *a,int *b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PollEvents,(SDL_Event *a,int b),(a,b),return)
+SDL_DYNAPI_PROC(int,SDL_PushEvents,(SDL_Event *a,int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetTimerStats,(SDL_TimerID a,SDL_TimerStats *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_FreezeProperties,(SDL_PropertiesID a),(a),return)
@@ -76,17 +76,34 @@ typedef struct
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static Uint32 SDL_userevents = SDL_EVENT_USER;
 
-typedef struct SDL_TemporaryMemory
+/* Temporary memory is bump allocated out of per-thread blocks, which are all
+ * reset at once by SDL_FreeTemporaryMemory() instead of tracking and freeing
+ * each allocation. An event holds a reference on the blocks its strings live
+ * in, so a block stays valid until every event pointing into it has been
+ * consumed and the consuming thread frees its temporary memory.
+ */
+#define SDL_TEMPORARY_MEMORY_BLOCK_SIZE   4096
+#define SDL_TEMPORARY_MEMORY_MAX_RETAINED (64 * 1024) // larger blocks are freed instead of reused
+#define SDL_TEMPORARY_MEMORY_ALIGNMENT    16
+#define SDL_TEMPORARY_MEMORY_ALIGN(size)  (((size) + (SDL_TEMPORARY_MEMORY_ALIGNMENT - 1)) & ~(size_t)(SDL_TEMPORARY_MEMORY_ALIGNMENT - 1))
+#define SDL_MAX_EVENT_MEMORY_BLOCKS       2 // an event has at most two temporary pointers (drop source and data)
+
+typedef struct SDL_TemporaryMemoryBlock
 {
-    void *memory;
-    struct SDL_TemporaryMemory *prev;
-    struct SDL_TemporaryMemory *next;
-} SDL_TemporaryMemory;
+    SDL_AtomicInt refcount;
+    size_t size;
+    size_t used;
+    struct SDL_TemporaryMemoryBlock *next;
+} SDL_TemporaryMemoryBlock;
+
+#define SDL_TEMPORARY_MEMORY_DATA(block) ((Uint8 *)(block) + SDL_TEMPORARY_MEMORY_ALIGN(sizeof(SDL_TemporaryMemoryBlock)))
 
 typedef struct SDL_TemporaryMemoryState
 {
-    SDL_TemporaryMemory *head;
-    SDL_TemporaryMemory *tail;
+    SDL_TemporaryMemoryBlock *blocks; // blocks allocated by this thread, newest first
+    SDL_TemporaryMemoryBlock **held;  // blocks referenced by events consumed on this thread
+    int num_held;
+    int max_held;
 } SDL_TemporaryMemoryState;
 
 static SDL_TLSID SDL_temporary_memory;
@@ -94,7 +111,7 @@ static SDL_TLSID SDL_temporary_memory;
 typedef struct SDL_EventEntry
 {
     SDL_Event event;
-    SDL_TemporaryMemory *memory;
+    SDL_TemporaryMemoryBlock *memory[SDL_MAX_EVENT_MEMORY_BLOCKS];
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
 } SDL_EventEntry;
@@ -110,12 +127,49 @@ static struct
     SDL_EventEntry *free;
 } SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL };
 
+/* Events pushed with SDL_ADDEVENT go into a bounded lock-free ring first, so
+ * threads pushing events don't serialize on SDL_EventQ.lock. Whoever holds the
+ * lock is the single consumer: it moves events from the ring to the end of the
+ * queue before looking at the queue, or takes them directly when the queue is
+ * empty and nothing is being filtered. If the ring is full, producers fall back
+ * to the locked queue, which drains the ring first to keep events in order.
+ */
+#define SDL_EVENT_RING_SIZE 1024 // must be a power of two
+
+typedef struct SDL_EventRingSlot
+{
+    SDL_AtomicU32 sequence;
+    SDL_EventEntry entry;
+} SDL_EventRingSlot;
+
+static struct
+{
+    SDL_EventRingSlot *slots;
+    SDL_AtomicInt ready;
+    SDL_AtomicInt producers;
+    SDL_AtomicU32 tail; // next slot claimed by a producer
+    Uint32 head;        // next slot to consume, protected by SDL_EventQ.lock
+} SDL_EventRing;
+
+static bool SDL_PopEventRing(SDL_EventEntry *entry, bool wait);
+
+
+static void SDL_ReleaseTemporaryMemoryBlock(SDL_TemporaryMemoryBlock *block)
+{
+    if (SDL_AddAtomicInt(&block->refcount, -1) == 1) {
+        SDL_free(block);
+    }
+}
 
 static void SDL_CleanupTemporaryMemory(void *data)
 {
     SDL_TemporaryMemoryState *state = (SDL_TemporaryMemoryState *)data;
 
     SDL_FreeTemporaryMemory();
+    if (state->blocks) {
+        SDL_ReleaseTemporaryMemoryBlock(state->blocks);
+    }
+    SDL_free(state->held);
     SDL_free(state);
 }
 
@@ -142,79 +196,55 @@ static SDL_TemporaryMemoryState *SDL_GetTemporaryMemoryState(bool create)
     return state;
 }
 
-static SDL_TemporaryMemory *SDL_GetTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, const void *mem)
+static SDL_TemporaryMemoryBlock *SDL_GetTemporaryMemoryBlock(SDL_TemporaryMemoryState *state, const void *mem)
 {
-    SDL_TemporaryMemory *entry;
+    const uintptr_t address = (uintptr_t)mem;
+    SDL_TemporaryMemoryBlock *block;
 
-    // Start from the end, it's likely to have been recently allocated
-    for (entry = state->tail; entry; entry = entry->prev) {
-        if (mem == entry->memory) {
-            return entry;
+    // Start from the newest block, it's likely to have been recently allocated
+    for (block = state->blocks; block; block = block->next) {
+        const uintptr_t start = (uintptr_t)SDL_TEMPORARY_MEMORY_DATA(block);
+        if (address >= start && address < start + block->used) {
+            return block;
         }
     }
     return NULL;
 }
 
-static void SDL_LinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
-{
-    entry->prev = state->tail;
-    entry->next = NULL;
-
-    if (state->tail) {
-        state->tail->next = entry;
-    } else {
-        state->head = entry;
-    }
-    state->tail = entry;
-}
-
-static void SDL_UnlinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
-{
-    if (state->head == entry) {
-        state->head = entry->next;
-    }
-    if (state->tail == entry) {
-        state->tail = entry->prev;
-    }
-
-    if (entry->prev) {
-        entry->prev->next = entry->next;
-    }
-    if (entry->next) {
-        entry->next->prev = entry->prev;
-    }
-
-    entry->prev = NULL;
-    entry->next = NULL;
-}
-
-static void SDL_FreeTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry, bool free_data)
-{
-    if (free_data) {
-        SDL_free(entry->memory);
-    }
-    SDL_free(entry);
-}
-
 static void SDL_LinkTemporaryMemoryToEvent(SDL_EventEntry *event, const void *mem)
 {
     SDL_TemporaryMemoryState *state;
-    SDL_TemporaryMemory *entry;
+    SDL_TemporaryMemoryBlock *block;
+    int i;
+
+    if (!mem) {
+        return;
+    }
 
     state = SDL_GetTemporaryMemoryState(false);
     if (!state) {
         return;
     }
 
-    entry = SDL_GetTemporaryMemoryEntry(state, mem);
-    if (entry) {
-        SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        entry->next = event->memory;
-        event->memory = entry;
+    block = SDL_GetTemporaryMemoryBlock(state, mem);
+    if (!block) {
+        return;
+    }
+
+    for (i = 0; i < SDL_MAX_EVENT_MEMORY_BLOCKS; ++i) {
+        if (event->memory[i] == block) {
+            return; // already referenced by this event
+        }
+        if (!event->memory[i]) {
+            SDL_AddAtomicInt(&block->refcount, 1);
+            event->memory[i] = block;
+            return;
+        }
     }
+    SDL_assert(!"Too many temporary memory blocks in one event");
 }
 
-// Transfer the event memory from the thread-local event memory list to the event
+// Give the event a reference to the thread-local temporary memory it points to
 static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
 {
     switch (event->event.type) {
@@ -243,13 +273,13 @@ static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
     }
 }
 
-// Transfer the event memory from the event to the thread-local event memory list
+// Hand the event's memory references to the current thread, to be released when it frees temporary memory
 static void SDL_TransferTemporaryMemoryFromEvent(SDL_EventEntry *event)
 {
     SDL_TemporaryMemoryState *state;
-    SDL_TemporaryMemory *entry, *next;
+    int i;
 
-    if (!event->memory) {
+    if (!event->memory[0]) {
         return;
     }
 
@@ -258,66 +288,63 @@ static void SDL_TransferTemporaryMemoryFromEvent(SDL_EventEntry *event)
         return;  // this is now a leak, but you probably have bigger problems if malloc failed.
     }
 
-    for (entry = event->memory; entry; entry = next) {
-        next = entry->next;
-        SDL_LinkTemporaryMemoryEntry(state, entry);
+    for (i = 0; i < SDL_MAX_EVENT_MEMORY_BLOCKS && event->memory[i]; ++i) {
+        if (state->num_held == state->max_held) {
+            const int max_held = state->max_held ? state->max_held * 2 : 16;
+            SDL_TemporaryMemoryBlock **held = (SDL_TemporaryMemoryBlock **)SDL_realloc(state->held, max_held * sizeof(*held));
+            if (!held) {
+                break;  // this is now a leak, but you probably have bigger problems if malloc failed.
+            }
+            state->held = held;
+            state->max_held = max_held;
+        }
+        state->held[state->num_held++] = event->memory[i];
     }
-    event->memory = NULL;
+    SDL_zeroa(event->memory);
 }
 
-static void *SDL_FreeLater(void *memory)
+void *SDL_AllocateTemporaryMemory(size_t size)
 {
     SDL_TemporaryMemoryState *state;
-
-    if (memory == NULL) {
-        return NULL;
-    }
-
-    // Make sure we're not adding this to the list twice
-    //SDL_assert(!SDL_ClaimTemporaryMemory(memory));
+    SDL_TemporaryMemoryBlock *block;
+    void *mem;
 
     state = SDL_GetTemporaryMemoryState(true);
     if (!state) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed.
-    }
-
-    SDL_TemporaryMemory *entry = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed. We could probably pool up and reuse entries, though.
+        return NULL;
     }
 
-    entry->memory = memory;
+    size = SDL_TEMPORARY_MEMORY_ALIGN(size ? size : 1);
 
-    SDL_LinkTemporaryMemoryEntry(state, entry);
+    block = state->blocks;
+    if (!block || (block->size - block->used) < size) {
+        const size_t block_size = SDL_max(size, SDL_TEMPORARY_MEMORY_BLOCK_SIZE);
 
-    return memory;
-}
+        block = (SDL_TemporaryMemoryBlock *)SDL_malloc(SDL_TEMPORARY_MEMORY_ALIGN(sizeof(*block)) + block_size);
+        if (!block) {
+            return NULL;
+        }
+        SDL_SetAtomicInt(&block->refcount, 1);
+        block->size = block_size;
+        block->used = 0;
+        block->next = state->blocks;
+        state->blocks = block;
+    }
 
-void *SDL_AllocateTemporaryMemory(size_t size)
-{
-    return SDL_FreeLater(SDL_malloc(size));
+    mem = SDL_TEMPORARY_MEMORY_DATA(block) + block->used;
+    block->used += size;
+    return mem;
 }
 
 const char *SDL_CreateTemporaryString(const char *string)
 {
     if (string) {
-        return (const char *)SDL_FreeLater(SDL_strdup(string));
-    }
-    return NULL;
-}
-
-void *SDL_ClaimTemporaryMemory(const void *mem)
-{
-    SDL_TemporaryMemoryState *state;
-
-    state = SDL_GetTemporaryMemoryState(false);
-    if (state && mem) {
-        SDL_TemporaryMemory *entry = SDL_GetTemporaryMemoryEntry(state, mem);
-        if (entry) {
-            SDL_UnlinkTemporaryMemoryEntry(state, entry);
-            SDL_FreeTemporaryMemoryEntry(state, entry, false);
-            return (void *)mem;
+        const size_t length = SDL_strlen(string) + 1;
+        char *copy = (char *)SDL_AllocateTemporaryMemory(length);
+        if (copy) {
+            SDL_memcpy(copy, string, length);
         }
+        return copy;
     }
     return NULL;
 }
@@ -325,18 +352,33 @@ void *SDL_ClaimTemporaryMemory(const void *mem)
 void SDL_FreeTemporaryMemory(void)
 {
     SDL_TemporaryMemoryState *state;
+    SDL_TemporaryMemoryBlock *block, *next, *keep = NULL;
+    int i;
 
     state = SDL_GetTemporaryMemoryState(false);
     if (!state) {
         return;
     }
 
-    while (state->head) {
-        SDL_TemporaryMemory *entry = state->head;
+    for (i = 0; i < state->num_held; ++i) {
+        SDL_ReleaseTemporaryMemoryBlock(state->held[i]);
+    }
+    state->num_held = 0;
 
-        SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        SDL_FreeTemporaryMemoryEntry(state, entry, true);
+    /* Keep one block that no queued event points into for reuse, and let go of the rest.
+       Only this thread adds references to its blocks, so the reference count can't go up
+       behind our back. */
+    for (block = state->blocks; block; block = next) {
+        next = block->next;
+        if (!keep && block->size <= SDL_TEMPORARY_MEMORY_MAX_RETAINED && SDL_GetAtomicInt(&block->refcount) == 1) {
+            keep = block;
+            keep->used = 0;
+            keep->next = NULL;
+        } else {
+            SDL_ReleaseTemporaryMemoryBlock(block);
+        }
     }
+    state->blocks = keep;
 }
 
 #ifndef SDL_JOYSTICK_DISABLED
@@ -366,6 +408,13 @@ static void SDLCALL SDL_PollSentinelChanged(void *userdata, const char *name, co
     SDL_SetEventEnabled(SDL_EVENT_POLL_SENTINEL, SDL_GetStringBoolean(hint, true));
 }
 
+static bool SDL_coalesce_motion = false;
+
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_coalesce_motion = SDL_GetStringBoolean(hint, false);
+}
+
 /**
  * Verbosity of logged events as defined in SDL_HINT_EVENT_LOGGING:
  *  - 0: (default) no logging
@@ -851,6 +900,21 @@ void SDL_StopEventLoop(void)
                 SDL_EventQ.max_events_seen);
     }
 
+    // Wait for any producers still writing to the ring, then clean it out
+    SDL_SetAtomicInt(&SDL_EventRing.ready, 0);
+    while (SDL_GetAtomicInt(&SDL_EventRing.producers) > 0) {
+        SDL_CPUPauseInstruction();
+    }
+    if (SDL_EventRing.slots) {
+        SDL_EventEntry pending;
+
+        while (SDL_PopEventRing(&pending, true)) {
+            SDL_TransferTemporaryMemoryFromEvent(&pending);
+        }
+        SDL_free(SDL_EventRing.slots);
+        SDL_EventRing.slots = NULL;
+    }
+
     // Clean out EventQ
     for (entry = SDL_EventQ.head; entry;) {
         SDL_EventEntry *next = entry->next;
@@ -930,43 +994,115 @@ bool SDL_StartEventLoop(void)
 #endif // !SDL_THREADS_DISABLED
 
     SDL_EventQ.active = true;
+
+    if (!SDL_EventRing.slots) {
+        // If this fails, events just go through the locked queue
+        SDL_EventRing.slots = (SDL_EventRingSlot *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*SDL_EventRing.slots));
+        if (SDL_EventRing.slots) {
+            for (Uint32 i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_SetAtomicU32(&SDL_EventRing.slots[i].sequence, i);
+            }
+            SDL_SetAtomicU32(&SDL_EventRing.tail, 0);
+            SDL_EventRing.head = 0;
+        }
+    }
+    if (SDL_EventRing.slots) {
+        SDL_SetAtomicInt(&SDL_EventRing.ready, 1);
+    }
+
     SDL_UnlockMutex(SDL_EventQ.lock);
     return true;
 }
 
-// Add an event to the event queue -- called with the queue locked
-static int SDL_AddEvent(SDL_Event *event)
+/* Count an event against SDL_MAX_QUEUED_EVENTS before it's stored. Producers on the
+   ring don't hold the queue lock, so the check and the increment have to be one step. */
+static bool SDL_ReserveQueuedEvent(void)
 {
-    SDL_EventEntry *entry;
-    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
-    int final_count;
+    int count;
 
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
+    do {
+        count = SDL_GetAtomicInt(&SDL_EventQ.count);
+        if (count >= SDL_MAX_QUEUED_EVENTS) {
+            return false;
+        }
+    } while (!SDL_CompareAndSwapAtomicInt(&SDL_EventQ.count, count, count + 1));
 
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
+    return true;
+}
+
+// Add an event to the ring, returns false if the ring is full or not running, or the queue is full
+static bool SDL_PushEventRing(SDL_Event *event)
+{
+    bool result = false;
+
+    SDL_AddAtomicInt(&SDL_EventRing.producers, 1);
+    if (SDL_GetAtomicInt(&SDL_EventRing.ready) && SDL_ReserveQueuedEvent()) {
+        for (;;) {
+            const Uint32 pos = SDL_GetAtomicU32(&SDL_EventRing.tail);
+            SDL_EventRingSlot *slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+            const Sint32 diff = (Sint32)(SDL_GetAtomicU32(&slot->sequence) - pos);
+
+            if (diff == 0) {
+                if (SDL_CompareAndSwapAtomicU32(&SDL_EventRing.tail, pos, pos + 1)) {
+                    if (SDL_EventLoggingVerbosity > 0) {
+                        SDL_LogEvent(event);
+                    }
+
+                    SDL_copyp(&slot->entry.event, event);
+                    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+                        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+                    }
+                    SDL_zeroa(slot->entry.memory);
+                    SDL_TransferTemporaryMemoryToEvent(&slot->entry);
+
+                    // Publish the slot to the consumer
+                    SDL_SetAtomicU32(&slot->sequence, pos + 1);
+                    result = true;
+                    break;
+                }
+            } else if (diff < 0) {
+                break; // full
+            }
+            // otherwise another producer claimed this slot first, try again
+        }
+        if (!result) {
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
         }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
     }
+    SDL_AddAtomicInt(&SDL_EventRing.producers, -1);
 
-    if (SDL_EventLoggingVerbosity > 0) {
-        SDL_LogEvent(event);
+    return result;
+}
+
+/* Take the oldest event out of the ring -- called with the queue locked.
+   If wait is true and a producer has claimed the oldest slot but not finished
+   writing it yet, this waits for it instead of treating the ring as empty. */
+static bool SDL_PopEventRing(SDL_EventEntry *entry, bool wait)
+{
+    const Uint32 pos = SDL_EventRing.head;
+    SDL_EventRingSlot *slot;
+
+    if (!SDL_EventRing.slots) {
+        return false;
     }
 
-    SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    slot = &SDL_EventRing.slots[pos & (SDL_EVENT_RING_SIZE - 1)];
+    while (SDL_GetAtomicU32(&slot->sequence) != pos + 1) {
+        if (!wait || SDL_GetAtomicU32(&SDL_EventRing.tail) == pos) {
+            return false; // empty, or the oldest producer is still writing
+        }
+        SDL_CPUPauseInstruction();
     }
-    entry->memory = NULL;
-    SDL_TransferTemporaryMemoryToEvent(entry);
 
+    SDL_copyp(entry, &slot->entry);
+    SDL_SetAtomicU32(&slot->sequence, pos + SDL_EVENT_RING_SIZE);
+    SDL_EventRing.head = pos + 1;
+    return true;
+}
+
+// Append an entry to the event queue -- called with the queue locked
+static void SDL_LinkEvent(SDL_EventEntry *entry)
+{
     if (SDL_EventQ.tail) {
         SDL_EventQ.tail->next = entry;
         entry->prev = SDL_EventQ.tail;
@@ -979,8 +1115,152 @@ static int SDL_AddEvent(SDL_Event *event)
         entry->prev = NULL;
         entry->next = NULL;
     }
+}
+
+static SDL_EventEntry *SDL_NewEventEntry(void)
+{
+    SDL_EventEntry *entry;
+
+    if (SDL_EventQ.free == NULL) {
+        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+    } else {
+        entry = SDL_EventQ.free;
+        SDL_EventQ.free = entry->next;
+    }
+    return entry;
+}
+
+/* Move everything in the ring to the end of the event queue -- called with the queue locked.
+   Events in the queue are always older than events in the ring, so before an event is
+   added to the queue directly, the ring must be drained with wait set. */
+static void SDL_DrainEventRing(bool wait)
+{
+    SDL_EventEntry pending;
+    int count;
+
+    while (SDL_PopEventRing(&pending, wait)) {
+        SDL_EventEntry *entry = SDL_NewEventEntry();
+        if (!entry) {
+            // Out of memory, drop the event
+            SDL_TransferTemporaryMemoryFromEvent(&pending);
+            if (pending.event.type == SDL_EVENT_POLL_SENTINEL) {
+                SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+            }
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+            continue;
+        }
+
+        SDL_copyp(entry, &pending);
+        SDL_LinkEvent(entry);
+        ++SDL_last_event_id;
+    }
+
+    count = SDL_GetAtomicInt(&SDL_EventQ.count);
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+}
+
+static bool SDL_IsMotionEvent(const SDL_Event *event)
+{
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+    case SDL_EVENT_PEN_MOTION:
+    case SDL_EVENT_FINGER_MOTION:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Merge a motion event into the last event in the queue, if that's motion from the
+   same device -- called with the queue locked. Returns false if it can't be merged. */
+static bool SDL_CoalesceMotionEvent(const SDL_Event *event)
+{
+    SDL_EventEntry *last = SDL_EventQ.tail;
+    SDL_Event merged;
+
+    if (!last || last->event.type != event->type || last->memory[0]) {
+        return false;
+    }
+
+    SDL_copyp(&merged, event);
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        if (last->event.motion.which != event->motion.which ||
+            last->event.motion.windowID != event->motion.windowID ||
+            last->event.motion.state != event->motion.state) {
+            return false;
+        }
+        merged.motion.xrel += last->event.motion.xrel;
+        merged.motion.yrel += last->event.motion.yrel;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        if (last->event.pmotion.which != event->pmotion.which ||
+            last->event.pmotion.windowID != event->pmotion.windowID ||
+            last->event.pmotion.pen_state != event->pmotion.pen_state) {
+            return false;
+        }
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        if (last->event.tfinger.touchID != event->tfinger.touchID ||
+            last->event.tfinger.fingerID != event->tfinger.fingerID ||
+            last->event.tfinger.windowID != event->tfinger.windowID) {
+            return false;
+        }
+        merged.tfinger.dx += last->event.tfinger.dx;
+        merged.tfinger.dy += last->event.tfinger.dy;
+        break;
+    default:
+        return false;
+    }
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    SDL_copyp(&last->event, &merged);
+    return true;
+}
+
+// Add an event to the event queue -- called with the queue locked
+static int SDL_AddEvent(SDL_Event *event)
+{
+    SDL_EventEntry *entry;
+    int final_count;
+
+    // Anything already in the ring was pushed before this event
+    SDL_DrainEventRing(true);
+
+    if (SDL_coalesce_motion && SDL_IsMotionEvent(event) && SDL_CoalesceMotionEvent(event)) {
+        return 1;
+    }
+
+    if (!SDL_ReserveQueuedEvent()) {
+        SDL_SetError("Event queue is full (%d events)", SDL_GetAtomicInt(&SDL_EventQ.count));
+        return 0;
+    }
 
-    final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
+    entry = SDL_NewEventEntry();
+    if (entry == NULL) {
+        SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        return 0;
+    }
+
+    if (SDL_EventLoggingVerbosity > 0) {
+        SDL_LogEvent(event);
+    }
+
+    SDL_copyp(&entry->event, event);
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    }
+    SDL_zeroa(entry->memory);
+    SDL_TransferTemporaryMemoryToEvent(entry);
+
+    SDL_LinkEvent(entry);
+
+    final_count = SDL_GetAtomicInt(&SDL_EventQ.count);
     if (final_count > SDL_EventQ.max_events_seen) {
         SDL_EventQ.max_events_seen = final_count;
     }
@@ -1050,9 +1330,46 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
 {
     int i, used, sentinels_expected = 0;
 
-    // Lock the event queue
     used = 0;
 
+    if (action == SDL_ADDEVENT) {
+        if (!events) {
+            return SDL_InvalidParamError("events");
+        }
+        for (i = 0; i < numevents; ++i) {
+            // Motion events that might be merged with the queue tail skip the ring
+            if (!(SDL_coalesce_motion && SDL_IsMotionEvent(&events[i])) &&
+                SDL_PushEventRing(&events[i])) {
+                ++used;
+                continue;
+            }
+
+            // The ring is full or not running, or this is motion to coalesce, add the rest of the batch to the locked queue
+            SDL_LockMutex(SDL_EventQ.lock);
+            if (!SDL_EventQ.active) {
+                SDL_UnlockMutex(SDL_EventQ.lock);
+                if (used == 0) {
+                    return -1;
+                }
+                break;
+            }
+            for (; i < numevents; ++i) {
+                if (!SDL_AddEvent(&events[i])) {
+                    break;
+                }
+                ++used;
+            }
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            break;
+        }
+
+        if (used > 0) {
+            SDL_SendWakeupEvent();
+        }
+        return used;
+    }
+
+    // Lock the event queue
     SDL_LockMutex(SDL_EventQ.lock);
     {
         // Don't look after we've quit
@@ -1064,18 +1381,36 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
-        if (action == SDL_ADDEVENT) {
-            if (!events) {
-                SDL_UnlockMutex(SDL_EventQ.lock);
-                return SDL_InvalidParamError("events");
-            }
-            for (i = 0; i < numevents; ++i) {
-                used += SDL_AddEvent(&events[i]);
+        if (action == SDL_GETEVENT && events && !SDL_EventQ.head &&
+            minType <= SDL_EVENT_FIRST && maxType >= SDL_EVENT_LAST) {
+            // Nothing is queued behind the lock and nothing is filtered, take events straight from the ring
+            SDL_EventEntry entry;
+
+            while (used < numevents && SDL_PopEventRing(&entry, false)) {
+                SDL_TransferTemporaryMemoryFromEvent(&entry);
+                SDL_assert(SDL_GetAtomicInt(&SDL_EventQ.count) > 0);
+                SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+
+                if (entry.event.type == SDL_EVENT_POLL_SENTINEL) {
+                    SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+                    if (!include_sentinel || SDL_GetAtomicInt(&SDL_sentinel_pending) > 0) {
+                        // Skip it, we don't want it or there's another one pending
+                        continue;
+                    }
+                }
+                SDL_copyp(&events[used], &entry.event);
+                ++used;
+
+                if (entry.event.type == SDL_EVENT_POLL_SENTINEL) {
+                    break; // end of the poll cycle
+                }
             }
         } else {
             SDL_EventEntry *entry, *next;
             Uint32 type;
 
+            SDL_DrainEventRing(false);
+
             for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
                 next = entry->next;
                 type = entry->event.type;
@@ -1100,6 +1435,8 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                             // Skip it, there's another one pending
                             continue;
                         }
+                        ++used;
+                        break; // end of the poll cycle
                     }
                     ++used;
                 }
@@ -1132,6 +1469,7 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         if (SDL_EventQ.active) {
+            SDL_DrainEventRing(false);
             for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
                 const Uint32 type = entry->event.type;
                 if (minType <= type && type <= maxType) {
@@ -1172,6 +1510,7 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
+        SDL_DrainEventRing(false);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             type = entry->event.type;
@@ -1422,6 +1761,31 @@ void SDL_PumpEvents(void)
 
 // Public functions
 
+int SDL_PollEvents(SDL_Event *events, int numevents)
+{
+    int result;
+
+    if (!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    if (numevents <= 0) {
+        return 0;
+    }
+
+    // If there isn't a poll sentinel event pending, pump events and add one
+    if (SDL_GetAtomicInt(&SDL_sentinel_pending) == 0) {
+        SDL_PumpEventsInternal(true);
+    }
+
+    result = SDL_PeepEventsInternal(events, numevents, SDL_GETEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST, true);
+    if (result > 0 && events[result - 1].type == SDL_EVENT_POLL_SENTINEL) {
+        // Reached the end of a poll cycle
+        --result;
+    }
+    return result;
+}
+
 bool SDL_PollEvent(SDL_Event *event)
 {
     return SDL_WaitEventTimeoutNS(event, 0);
@@ -1665,48 +2029,58 @@ bool SDL_WaitEventTimeoutNS(SDL_Event *event, Sint64 timeoutNS)
 #endif // SDL_PLATFORM_ANDROID
 }
 
-static bool SDL_CallEventWatchers(SDL_Event *event)
+// Run the event filter and watchers -- called with SDL_event_watchers_lock held
+static bool SDL_DispatchEventWatchers(SDL_Event *event)
 {
-    if ((SDL_EventOK.callback || SDL_event_watchers_count > 0) &&
-        (event->common.type != SDL_EVENT_POLL_SENTINEL)) {
-        SDL_LockMutex(SDL_event_watchers_lock);
-        {
-            if (SDL_EventOK.callback && !SDL_EventOK.callback(SDL_EventOK.userdata, event)) {
-                SDL_UnlockMutex(SDL_event_watchers_lock);
-                return false;
-            }
+    if (event->common.type == SDL_EVENT_POLL_SENTINEL) {
+        return true;
+    }
+
+    if (SDL_EventOK.callback && !SDL_EventOK.callback(SDL_EventOK.userdata, event)) {
+        return false;
+    }
 
-            if (SDL_event_watchers_count > 0) {
-                // Make sure we only dispatch the current watcher list
-                int i, event_watchers_count = SDL_event_watchers_count;
+    if (SDL_event_watchers_count > 0) {
+        // Make sure we only dispatch the current watcher list
+        int i, event_watchers_count = SDL_event_watchers_count;
 
-                SDL_event_watchers_dispatching = true;
-                for (i = 0; i < event_watchers_count; ++i) {
-                    if (!SDL_event_watchers[i].removed) {
-                        SDL_event_watchers[i].callback(SDL_event_watchers[i].userdata, event);
-                    }
-                }
-                SDL_event_watchers_dispatching = false;
-
-                if (SDL_event_watchers_removed) {
-                    for (i = SDL_event_watchers_count; i--;) {
-                        if (SDL_event_watchers[i].removed) {
-                            --SDL_event_watchers_count;
-                            if (i < SDL_event_watchers_count) {
-                                SDL_memmove(&SDL_event_watchers[i], &SDL_event_watchers[i + 1], (SDL_event_watchers_count - i) * sizeof(SDL_event_watchers[i]));
-                            }
-                        }
+        SDL_event_watchers_dispatching = true;
+        for (i = 0; i < event_watchers_count; ++i) {
+            if (!SDL_event_watchers[i].removed) {
+                SDL_event_watchers[i].callback(SDL_event_watchers[i].userdata, event);
+            }
+        }
+        SDL_event_watchers_dispatching = false;
+
+        if (SDL_event_watchers_removed) {
+            for (i = SDL_event_watchers_count; i--;) {
+                if (SDL_event_watchers[i].removed) {
+                    --SDL_event_watchers_count;
+                    if (i < SDL_event_watchers_count) {
+                        SDL_memmove(&SDL_event_watchers[i], &SDL_event_watchers[i + 1], (SDL_event_watchers_count - i) * sizeof(SDL_event_watchers[i]));
                     }
-                    SDL_event_watchers_removed = false;
                 }
             }
+            SDL_event_watchers_removed = false;
         }
-        SDL_UnlockMutex(SDL_event_watchers_lock);
     }
 
     return true;
 }
 
+static bool SDL_CallEventWatchers(SDL_Event *event)
+{
+    bool result = true;
+
+    if ((SDL_EventOK.callback || SDL_event_watchers_count > 0) &&
+        (event->common.type != SDL_EVENT_POLL_SENTINEL)) {
+        SDL_LockMutex(SDL_event_watchers_lock);
+        result = SDL_DispatchEventWatchers(event);
+        SDL_UnlockMutex(SDL_event_watchers_lock);
+    }
+    return result;
+}
+
 bool SDL_PushEvent(SDL_Event *event)
 {
     if (!event->common.timestamp) {
@@ -1725,6 +2099,62 @@ bool SDL_PushEvent(SDL_Event *event)
     return true;
 }
 
+int SDL_PushEvents(SDL_Event *events, int numevents)
+{
+    const Uint64 now = SDL_GetTicksNS();
+    int i, first, consumed, result;
+
+    if (!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    if (numevents <= 0) {
+        return 0;
+    }
+
+    for (i = 0; i < numevents; ++i) {
+        if (!events[i].common.timestamp) {
+            events[i].common.timestamp = now;
+        }
+    }
+
+    if (!SDL_EventOK.callback && SDL_event_watchers_count == 0) {
+        return SDL_PeepEvents(events, numevents, SDL_ADDEVENT, 0, 0);
+    }
+
+    /* Dispatch the whole batch under one lock, adding each run of
+       accepted events as soon as the filter rejects one */
+    consumed = 0;
+    first = 0;
+    SDL_LockMutex(SDL_event_watchers_lock);
+    for (i = 0; i <= numevents; ++i) {
+        if (i < numevents && SDL_DispatchEventWatchers(&events[i])) {
+            continue;
+        }
+
+        if (i > first) {
+            result = SDL_PeepEvents(&events[first], i - first, SDL_ADDEVENT, 0, 0);
+            if (result < 0) {
+                if (consumed == 0) {
+                    consumed = -1;
+                }
+                break;
+            }
+            consumed += result;
+            if (result < i - first) {
+                break; // the queue is full
+            }
+        }
+        if (i < numevents) {
+            ++consumed; // dropped by the filter
+        }
+        first = i + 1;
+    }
+    SDL_UnlockMutex(SDL_event_watchers_lock);
+
+    return consumed;
+}
+
 void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 {
     SDL_EventEntry *event, *next;
@@ -1737,6 +2167,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
             // Cut all events not accepted by the filter
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_DrainEventRing(false);
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1825,6 +2256,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_DrainEventRing(false);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1974,8 +2406,10 @@ bool SDL_InitEvents(void)
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_InitMainThreadCallbacks();
     if (!SDL_StartEventLoop()) {
+        SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
         SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
         return false;
     }
@@ -1990,6 +2424,7 @@ void SDL_QuitEvents(void)
     SDL_QuitQuit();
     SDL_StopEventLoop();
     SDL_QuitMainThreadCallbacks();
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
@@ -55,6 +55,12 @@
         return retval;                                                          \
     }
 
+#define CHECK_PRIMARY_COMMAND_BUFFER(msg, retval)                          \
+    if (((CommandBufferCommonHeader *)command_buffer)->parent != NULL) { \
+        SDL_assert_release(!msg);                                          \
+        return retval;                                                     \
+    }
+
 #define CHECK_RENDERPASS                                     \
     if (!((Pass *)render_pass)->in_progress) {                 \
         SDL_assert_release(!"Render pass not in progress!"); \
@@ -439,6 +445,159 @@ static const SDL_GPUBootstrap * SDL_GPUSelectBackend(SDL_PropertiesID props)
     return NULL;
 }
 
+// Pass Timing
+
+static GPUPassTimer *SDL_GPU_AcquirePassTimer(SDL_GPUDevice *device)
+{
+    SDL_GPUQueryPoolCreateInfo createinfo;
+    GPUPassTimer *timer = device->available_pass_timers;
+
+    if (timer != NULL) {
+        device->available_pass_timers = timer->next;
+    } else {
+        SDL_zero(createinfo);
+        createinfo.type = SDL_GPU_QUERYTYPE_TIMESTAMP;
+        createinfo.num_queries = GPU_PASS_TIMER_MAX_PASSES * 2;
+
+        timer = (GPUPassTimer *)SDL_calloc(1, sizeof(GPUPassTimer));
+        if (timer == NULL) {
+            return NULL;
+        }
+
+        timer->query_pool = device->CreateQueryPool(device->driverData, &createinfo);
+        if (timer->query_pool == NULL) {
+            SDL_free(timer);
+            return NULL;
+        }
+    }
+
+    timer->num_passes = 0;
+    timer->next = NULL;
+    return timer;
+}
+
+static void SDL_GPU_DestroyPassTimer(SDL_GPUDevice *device, GPUPassTimer *timer)
+{
+    device->ReleaseQueryPool(device->driverData, timer->query_pool);
+    SDL_free(timer);
+}
+
+// Detach the timers whose results are ready and fill in their timings, called with pass_timer_lock held
+static GPUPassTimer *SDL_GPU_CollectPassTimings(SDL_GPUDevice *device)
+{
+    GPUPassTimer **link = &device->pending_pass_timers;
+    GPUPassTimer *completed = NULL;
+    GPUPassTimer **completed_tail = &completed;
+    Uint64 timestamps[GPU_PASS_TIMER_MAX_PASSES * 2];
+
+    while (*link != NULL) {
+        GPUPassTimer *timer = *link;
+
+        // Ask first so that polling doesn't clobber the app's error string
+        if (!device->QueryPoolResultsAvailable(device->driverData, timer->query_pool) ||
+            !device->GetQueryPoolResults(device->driverData, timer->query_pool, 0, timer->num_passes * 2, timestamps)) {
+            // Still in flight, try again later
+            link = &timer->next;
+            continue;
+        }
+
+        *link = timer->next;
+
+        for (Uint32 i = 0; i < timer->num_passes; i += 1) {
+            timer->timings[i].type = timer->pass_types[i];
+            timer->timings[i].begin_ns = timestamps[i * 2];
+            timer->timings[i].end_ns = timestamps[i * 2 + 1];
+        }
+
+        // Keep submission order so callbacks arrive in the order work was submitted
+        timer->next = NULL;
+        *completed_tail = timer;
+        completed_tail = &timer->next;
+    }
+
+    return completed;
+}
+
+/* Hand collected timings to the app, then recycle the timers. This is called
+   without pass_timer_lock held, so the callback can call back into the GPU API. */
+static void SDL_GPU_DeliverPassTimings(
+    SDL_GPUDevice *device,
+    GPUPassTimer *completed,
+    SDL_GPUPassTimingCallback callback,
+    void *userdata)
+{
+    GPUPassTimer *timer;
+
+    if (completed == NULL) {
+        return;
+    }
+
+    if (callback != NULL) {
+        for (timer = completed; timer != NULL; timer = timer->next) {
+            callback(userdata, timer->timings, (int)timer->num_passes);
+        }
+    }
+
+    SDL_LockMutex(device->pass_timer_lock);
+    while (completed != NULL) {
+        timer = completed;
+        completed = timer->next;
+        timer->next = device->available_pass_timers;
+        device->available_pass_timers = timer;
+    }
+    SDL_UnlockMutex(device->pass_timer_lock);
+}
+
+static void SDL_GPU_FinishPassTimer(SDL_GPUDevice *device, GPUPassTimer *timer, bool submitted)
+{
+    GPUPassTimer **link;
+
+    SDL_LockMutex(device->pass_timer_lock);
+
+    if (submitted && timer->num_passes > 0) {
+        // Keep submission order so callbacks arrive in the order work was submitted
+        link = &device->pending_pass_timers;
+        while (*link != NULL) {
+            link = &(*link)->next;
+        }
+        *link = timer;
+    } else if (!submitted && timer->num_passes > 0) {
+        // We can't tell whether the GPU will still touch these queries
+        SDL_GPU_DestroyPassTimer(device, timer);
+    } else {
+        timer->next = device->available_pass_timers;
+        device->available_pass_timers = timer;
+    }
+
+    SDL_UnlockMutex(device->pass_timer_lock);
+}
+
+static void SDL_GPU_BeginTimedPass(SDL_GPUCommandBuffer *command_buffer)
+{
+    GPUPassTimer *timer = ((CommandBufferCommonHeader *)command_buffer)->pass_timer;
+
+    if (timer != NULL && timer->num_passes < GPU_PASS_TIMER_MAX_PASSES) {
+        COMMAND_BUFFER_DEVICE->WriteTimestamp(
+            command_buffer,
+            timer->query_pool,
+            timer->num_passes * 2);
+    }
+}
+
+static void SDL_GPU_EndTimedPass(SDL_GPUCommandBuffer *command_buffer, SDL_GPUPassType type)
+{
+    GPUPassTimer *timer = ((CommandBufferCommonHeader *)command_buffer)->pass_timer;
+
+    if (timer != NULL && timer->num_passes < GPU_PASS_TIMER_MAX_PASSES) {
+        COMMAND_BUFFER_DEVICE->WriteTimestamp(
+            command_buffer,
+            timer->query_pool,
+            timer->num_passes * 2 + 1);
+        timer->pass_types[timer->num_passes] = type;
+        timer->num_passes += 1;
+    }
+}
+
 static void SDL_GPU_FillProperties(
     SDL_PropertiesID props,
     SDL_GPUShaderFormat format_flags,
@@ -531,6 +690,11 @@ SDL_GPUDevice *SDL_CreateGPUDeviceWithProperties(SDL_PropertiesID props)
             result->backend = selectedBackend->name;
             result->shader_formats = selectedBackend->shader_formats;
             result->debug_mode = debug_mode;
+            result->pass_timer_lock = SDL_CreateMutex();
+            result->pass_timing_callback = NULL;
+            result->pass_timing_userdata = NULL;
+            result->available_pass_timers = NULL;
+            result->pending_pass_timers = NULL;
         }
     }
     return result;
@@ -542,8 +706,23 @@ SDL_GPUDevice *SDL_CreateGPUDeviceWithProperties(SDL_PropertiesID props)
 
 void SDL_DestroyGPUDevice(SDL_GPUDevice *device)
 {
+    GPUPassTimer *timer;
+
     CHECK_DEVICE_MAGIC(device, );
 
+    // The query pools are released lazily, so the backend cleans them up once the GPU is done
+    while (device->available_pass_timers != NULL) {
+        timer = device->available_pass_timers;
+        device->available_pass_timers = timer->next;
+        SDL_GPU_DestroyPassTimer(device, timer);
+    }
+    while (device->pending_pass_timers != NULL) {
+        timer = device->pending_pass_timers;
+        device->pending_pass_timers = timer->next;
+        SDL_GPU_DestroyPassTimer(device, timer);
+    }
+    SDL_DestroyMutex(device->pass_timer_lock);
+
     device->DestroyDevice(device);
 }
 
@@ -583,6 +762,98 @@ SDL_GPUShaderFormat SDL_GetGPUShaderFormats(SDL_GPUDevice *device)
     return device->shader_formats;
 }
 
+void *SDL_GetGPUPipelineCacheData(SDL_GPUDevice *device, size_t *size)
+{
+    if (size) {
+        *size = 0;
+    }
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (size == NULL) {
+        SDL_InvalidParamError("size");
+        return NULL;
+    }
+
+    return device->GetPipelineCacheData(
+        device->driverData,
+        size);
+}
+
+SDL_GPUMemoryHeapStats *SDL_GetGPUMemoryStats(SDL_GPUDevice *device, int *count)
+{
+    int dummy;
+
+    if (!count) {
+        count = &dummy;
+    }
+    *count = 0;
+
+    CHECK_DEVICE_MAGIC(device, NULL);
+
+    return device->GetMemoryStats(
+        device->driverData,
+        count);
+}
+
+Uint32 SDL_GetGPUBindlessTextureCapacity(SDL_GPUDevice *device)
+{
+    CHECK_DEVICE_MAGIC(device, 0);
+
+    return device->GetBindlessTextureCapacity(device->driverData);
+}
+
+bool SDL_AddGPUBindlessTexture(
+    SDL_GPUDevice *device,
+    const SDL_GPUTextureSamplerBinding *binding,
+    Uint32 *index)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+    if (binding == NULL) {
+        return SDL_InvalidParamError("binding");
+    }
+    if (index == NULL) {
+        return SDL_InvalidParamError("index");
+    }
+
+    if (device->debug_mode) {
+        if (binding->texture == NULL) {
+            SDL_assert_release(!"Bindless texture must not be NULL!");
+            return false;
+        }
+        if (binding->sampler == NULL) {
+            SDL_assert_release(!"Bindless sampler must not be NULL!");
+            return false;
+        }
+        if (!(((TextureCommonHeader *)binding->texture)->info.usage & SDL_GPU_TEXTUREUSAGE_SAMPLER)) {
+            SDL_assert_release(!"Bindless texture must have been created with the SAMPLER usage flag!");
+            return false;
+        }
+    }
+
+    return device->AddBindlessTexture(
+        device->driverData,
+        binding,
+        index);
+}
+
+void SDL_RemoveGPUBindlessTexture(
+    SDL_GPUDevice *device,
+    Uint32 index)
+{
+    CHECK_DEVICE_MAGIC(device, );
+
+    if (device->debug_mode) {
+        if (index >= device->GetBindlessTextureCapacity(device->driverData)) {
+            SDL_assert_release(!"Bindless texture index is out of range!");
+            return;
+        }
+    }
+
+    device->RemoveBindlessTexture(
+        device->driverData,
+        index);
+}
+
 Uint32 SDL_GPUTextureFormatTexelBlockSize(
     SDL_GPUTextureFormat format)
 {
@@ -1300,6 +1571,9 @@ SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
 {
     SDL_GPUCommandBuffer *command_buffer;
     CommandBufferCommonHeader *commandBufferHeader;
+    GPUPassTimer *completed_timers;
+    SDL_GPUPassTimingCallback pass_timing_callback;
+    void *pass_timing_userdata;
 
     CHECK_DEVICE_MAGIC(device, NULL);
 
@@ -1312,8 +1586,11 @@ SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
 
     commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
     commandBufferHeader->device = device;
+    commandBufferHeader->pass_timer = NULL;
+    commandBufferHeader->parent = NULL;
     commandBufferHeader->render_pass.command_buffer = command_buffer;
     commandBufferHeader->render_pass.in_progress = false;
+    commandBufferHeader->parallel_render_pass = false;
     commandBufferHeader->graphics_pipeline_bound = false;
     commandBufferHeader->compute_pass.command_buffer = command_buffer;
     commandBufferHeader->compute_pass.in_progress = false;
@@ -1323,6 +1600,17 @@ SDL_GPUCommandBuffer *SDL_AcquireGPUCommandBuffer(
     commandBufferHeader->swapchain_texture_acquired = false;
     commandBufferHeader->submitted = false;
 
+    SDL_LockMutex(device->pass_timer_lock);
+    completed_timers = SDL_GPU_CollectPassTimings(device);
+    pass_timing_callback = device->pass_timing_callback;
+    pass_timing_userdata = device->pass_timing_userdata;
+    if (pass_timing_callback != NULL) {
+        commandBufferHeader->pass_timer = SDL_GPU_AcquirePassTimer(device);
+    }
+    SDL_UnlockMutex(device->pass_timer_lock);
+
+    SDL_GPU_DeliverPassTimings(device, completed_timers, pass_timing_callback, pass_timing_userdata);
+
     return command_buffer;
 }
 
@@ -1406,20 +1694,47 @@ void SDL_PushGPUComputeUniformData(
         length);
 }
 
+// Transient Memory
+
+void *SDL_AllocateGPUTransientMemory(
+    SDL_GPUCommandBuffer *command_buffer,
+    Uint32 size,
+    SDL_GPUBufferBinding *binding)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return NULL;
+    }
+    if (size == 0) {
+        SDL_InvalidParamError("size");
+        return NULL;
+    }
+    if (binding == NULL) {
+        SDL_InvalidParamError("binding");
+        return NULL;
+    }
+
+    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+        CHECK_COMMAND_BUFFER_RETURN_NULL
+    }
+
+    return COMMAND_BUFFER_DEVICE->AllocateTransientMemory(
+        command_buffer,
+        size,
+        binding);
+}
+
 // Render Pass
 
-SDL_GPURenderPass *SDL_BeginGPURenderPass(
+static SDL_GPURenderPass *SDL_GPU_BeginRenderPass(
     SDL_GPUCommandBuffer *command_buffer,
     const SDL_GPUColorTargetInfo *color_target_infos,
     Uint32 num_color_targets,
-    const SDL_GPUDepthStencilTargetInfo *depth_stencil_target_info)
+    const SDL_GPUDepthStencilTargetInfo *depth_stencil_target_info,
+    bool parallel)
 {
     CommandBufferCommonHeader *commandBufferHeader;
 
-    if (command_buffer == NULL) {
-        SDL_InvalidParamError("command_buffer");
-        return NULL;
-    }
     if (color_target_infos == NULL && num_color_targets > 0) {
         SDL_InvalidParamError("color_target_infos");
         return NULL;
@@ -1485,17 +1800,69 @@ SDL_GPURenderPass *SDL_BeginGPURenderPass(
         }
     }
 
-    COMMAND_BUFFER_DEVICE->BeginRenderPass(
-        command_buffer,
-        color_target_infos,
-        num_color_targets,
-        depth_stencil_target_info);
+    SDL_GPU_BeginTimedPass(command_buffer);
+
+    if (parallel) {
+        if (!COMMAND_BUFFER_DEVICE->BeginParallelRenderPass(
+                command_buffer,
+                color_target_infos,
+                num_color_targets,
+                depth_stencil_target_info)) {
+            return NULL;
+        }
+    } else {
+        COMMAND_BUFFER_DEVICE->BeginRenderPass(
+            command_buffer,
+            color_target_infos,
+            num_color_targets,
+            depth_stencil_target_info);
+    }
 
     commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
     commandBufferHeader->render_pass.in_progress = true;
+    commandBufferHeader->parallel_render_pass = parallel;
     return (SDL_GPURenderPass *)&(commandBufferHeader->render_pass);
 }
 
+SDL_GPURenderPass *SDL_BeginGPURenderPass(
+    SDL_GPUCommandBuffer *command_buffer,
+    const SDL_GPUColorTargetInfo *color_target_infos,
+    Uint32 num_color_targets,
+    const SDL_GPUDepthStencilTargetInfo *depth_stencil_target_info)
+{
+    CommandBufferCommonHeader *commandBufferHeader;
+
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return NULL;
+    }
+
+    commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
+
+    if (commandBufferHeader->parent != NULL) {
+        // Secondary command buffers continue the render pass of their parent
+        if (COMMAND_BUFFER_DEVICE->debug_mode) {
+            CHECK_COMMAND_BUFFER_RETURN_NULL
+            CHECK_ANY_PASS_IN_PROGRESS("Cannot begin render pass during another pass!", NULL)
+
+            if (color_target_infos != NULL || num_color_targets > 0 || depth_stencil_target_info != NULL) {
+                SDL_assert_release(!"Secondary command buffers inherit their targets, pass no targets!");
+                return NULL;
+            }
+        }
+
+        commandBufferHeader->render_pass.in_progress = true;
+        return (SDL_GPURenderPass *)&(commandBufferHeader->render_pass);
+    }
+
+    return SDL_GPU_BeginRenderPass(
+        command_buffer,
+        color_target_infos,
+        num_color_targets,
+        depth_stencil_target_info,
+        false);
+}
+
 void SDL_BindGPUGraphicsPipeline(
     SDL_GPURenderPass *render_pass,
     SDL_GPUGraphicsPipeline *graphics_pipeline)
@@ -1511,6 +1878,14 @@ void SDL_BindGPUGraphicsPipeline(
         return;
     }
 
+    if (RENDERPASS_DEVICE->debug_mode) {
+        CHECK_RENDERPASS
+        if (((CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER)->parallel_render_pass) {
+            SDL_assert_release(!"Parallel render passes can only execute secondary command buffers!");
+            return;
+        }
+    }
+
     RENDERPASS_DEVICE->BindGraphicsPipeline(
         RENDERPASS_COMMAND_BUFFER,
         graphics_pipeline);
@@ -1925,14 +2300,143 @@ void SDL_EndGPURenderPass(
         CHECK_RENDERPASS
     }
 
-    RENDERPASS_DEVICE->EndRenderPass(
-        RENDERPASS_COMMAND_BUFFER);
-
     commandBufferCommonHeader = (CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER;
+
+    if (commandBufferCommonHeader->parent != NULL) {
+        RENDERPASS_DEVICE->EndSecondaryCommandBuffer(
+            RENDERPASS_COMMAND_BUFFER);
+
+        // A secondary command buffer is finished once its render pass ends
+        commandBufferCommonHeader->submitted = true;
+    } else {
+        RENDERPASS_DEVICE->EndRenderPass(
+            RENDERPASS_COMMAND_BUFFER);
+
+        SDL_GPU_EndTimedPass(RENDERPASS_COMMAND_BUFFER, SDL_GPU_PASSTYPE_RENDER);
+    }
+
     commandBufferCommonHeader->render_pass.in_progress = false;
+    commandBufferCommonHeader->parallel_render_pass = false;
     commandBufferCommonHeader->graphics_pipeline_bound = false;
 }
 
+// Parallel Render Pass
+
+SDL_GPURenderPass *SDL_BeginGPUParallelRenderPass(
+    SDL_GPUCommandBuffer *command_buffer,
+    const SDL_GPUColorTargetInfo *color_target_infos,
+    Uint32 num_color_targets,
+    const SDL_GPUDepthStencilTargetInfo *depth_stencil_target_info)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return NULL;
+    }
+
+    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+        CHECK_PRIMARY_COMMAND_BUFFER("Secondary command buffers cannot begin parallel render passes!", NULL)
+    }
+
+    return SDL_GPU_BeginRenderPass(
+        command_buffer,
+        color_target_infos,
+        num_color_targets,
+        depth_stencil_target_info,
+        true);
+}
+
+SDL_GPUCommandBuffer *SDL_AcquireGPUSecondaryCommandBuffer(
+    SDL_GPURenderPass *render_pass)
+{
+    SDL_GPUCommandBuffer *command_buffer;
+    CommandBufferCommonHeader *commandBufferHeader;
+
+    if (render_pass == NULL) {
+        SDL_InvalidParamError("render_pass");
+        return NULL;
+    }
+
+    if (RENDERPASS_DEVICE->debug_mode) {
+        if (!((Pass *)render_pass)->in_progress) {
+            SDL_assert_release(!"Render pass not in progress!");
+            return NULL;
+        }
+        if (!((CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER)->parallel_render_pass) {
+            SDL_assert_release(!"Secondary command buffers require a parallel render pass!");
+            return NULL;
+        }
+    }
+
+    command_buffer = RENDERPASS_DEVICE->AcquireSecondaryCommandBuffer(
+        RENDERPASS_COMMAND_BUFFER);
+
+    if (command_buffer == NULL) {
+        return NULL;
+    }
+
+    commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
+    commandBufferHeader->device = RENDERPASS_DEVICE;
+    commandBufferHeader->pass_timer = NULL;
+    commandBufferHeader->parent = RENDERPASS_COMMAND_BUFFER;
+    commandBufferHeader->render_pass.command_buffer = command_buffer;
+    commandBufferHeader->render_pass.in_progress = false;
+    commandBufferHeader->parallel_render_pass = false;
+    commandBufferHeader->graphics_pipeline_bound = false;
+    commandBufferHeader->compute_pass.command_buffer = command_buffer;
+    commandBufferHeader->compute_pass.in_progress = false;
+    commandBufferHeader->compute_pipeline_bound = false;
+    commandBufferHeader->copy_pass.command_buffer = command_buffer;
+    commandBufferHeader->copy_pass.in_progress = false;
+    commandBufferHeader->swapchain_texture_acquired = false;
+    commandBufferHeader->submitted = false;
+
+    return command_buffer;
+}
+
+void SDL_ExecuteGPUSecondaryCommandBuffers(
+    SDL_GPURenderPass *render_pass,
+    SDL_GPUCommandBuffer *const *command_buffers,
+    Uint32 num_command_buffers)
+{
+    if (render_pass == NULL) {
+        SDL_InvalidParamError("render_pass");
+        return;
+    }
+    if (command_buffers == NULL && num_command_buffers > 0) {
+        SDL_InvalidParamError("command_buffers");
+        return;
+    }
+
+    if (RENDERPASS_DEVICE->debug_mode) {
+        CHECK_RENDERPASS
+        if (!((CommandBufferCommonHeader *)RENDERPASS_COMMAND_BUFFER)->parallel_render_pass) {
+            SDL_assert_release(!"Secondary command buffers can only be executed in a parallel render pass!");
+            return;
+        }
+
+        for (Uint32 i = 0; i < num_command_buffers; i += 1) {
+            CommandBufferCommonHeader *secondaryHeader = (CommandBufferCommonHeader *)command_buffers[i];
+            if (secondaryHeader->parent != RENDERPASS_COMMAND_BUFFER) {
+                SDL_assert_release(!"Secondary command buffer was not acquired from this render pass!");
+                return;
+            }
+            if (!secondaryHeader->submitted) {
+                SDL_assert_release(!"Secondary command buffer render pass has not ended!");
+                return;
+            }
+        }
+    }
+
+    if (num_command_buffers == 0) {
+        return;
+    }
+
+    RENDERPASS_DEVICE->ExecuteSecondaryCommandBuffers(
+        RENDERPASS_COMMAND_BUFFER,
+        command_buffers,
+        num_command_buffers);
+}
+
 // Compute Pass
 
 SDL_GPUComputePass *SDL_BeginGPUComputePass(
@@ -1967,6 +2471,7 @@ SDL_GPUComputePass *SDL_BeginGPUComputePass(
     if (COMMAND_BUFFER_DEVICE->debug_mode) {
         CHECK_COMMAND_BUFFER_RETURN_NULL
         CHECK_ANY_PASS_IN_PROGRESS("Cannot begin compute pass during another pass!", NULL)
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot begin compute pass on a secondary command buffer!", NULL)
 
         for (Uint32 i = 0; i < num_storage_texture_bindings; i += 1) {
             TextureCommonHeader *header = (TextureCommonHeader *)storage_texture_bindings[i].texture;
@@ -1979,6 +2484,8 @@ SDL_GPUComputePass *SDL_BeginGPUComputePass(
         // TODO: validate buffer usage?
     }
 
+    SDL_GPU_BeginTimedPass(command_buffer);
+
     COMMAND_BUFFER_DEVICE->BeginComputePass(
         command_buffer,
         storage_texture_bindings,
@@ -2157,6 +2664,8 @@ void SDL_EndGPUComputePass(
     COMPUTEPASS_DEVICE->EndComputePass(
         COMPUTEPASS_COMMAND_BUFFER);
 
+    SDL_GPU_EndTimedPass(COMPUTEPASS_COMMAND_BUFFER, SDL_GPU_PASSTYPE_COMPUTE);
+
     commandBufferCommonHeader = (CommandBufferCommonHeader *)COMPUTEPASS_COMMAND_BUFFER;
     commandBufferCommonHeader->compute_pass.in_progress = false;
     commandBufferCommonHeader->compute_pipeline_bound = false;
@@ -2211,8 +2720,11 @@ SDL_GPUCopyPass *SDL_BeginGPUCopyPass(
     if (COMMAND_BUFFER_DEVICE->debug_mode) {
         CHECK_COMMAND_BUFFER_RETURN_NULL
         CHECK_ANY_PASS_IN_PROGRESS("Cannot begin copy pass during another pass!", NULL)
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot begin copy pass on a secondary command buffer!", NULL)
     }
 
+    SDL_GPU_BeginTimedPass(command_buffer);
+
     COMMAND_BUFFER_DEVICE->BeginCopyPass(
         command_buffer);
 
@@ -2468,6 +2980,8 @@ void SDL_EndGPUCopyPass(
     COPYPASS_DEVICE->EndCopyPass(
         COPYPASS_COMMAND_BUFFER);
 
+    SDL_GPU_EndTimedPass(COPYPASS_COMMAND_BUFFER, SDL_GPU_PASSTYPE_COPY);
+
     ((CommandBufferCommonHeader *)COPYPASS_COMMAND_BUFFER)->copy_pass.in_progress = false;
 }
 
@@ -2487,6 +3001,7 @@ void SDL_GenerateMipmapsForGPUTexture(
     if (COMMAND_BUFFER_DEVICE->debug_mode) {
         CHECK_COMMAND_BUFFER
         CHECK_ANY_PASS_IN_PROGRESS("Cannot generate mipmaps during a pass!", )
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot generate mipmaps on a secondary command buffer!", )
 
         TextureCommonHeader *header = (TextureCommonHeader *)texture;
         if (header->info.num_levels <= 1) {
@@ -2521,6 +3036,7 @@ void SDL_BlitGPUTexture(
     if (COMMAND_BUFFER_DEVICE->debug_mode) {
         CHECK_COMMAND_BUFFER
         CHECK_ANY_PASS_IN_PROGRESS("Cannot blit during a pass!", )
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot blit on a secondary command buffer!", )
 
         // Validation
         bool failed = false;
@@ -2720,6 +3236,7 @@ bool SDL_AcquireGPUSwapchainTexture(
     if (COMMAND_BUFFER_DEVICE->debug_mode) {
         CHECK_COMMAND_BUFFER_RETURN_FALSE
         CHECK_ANY_PASS_IN_PROGRESS("Cannot acquire a swapchain texture during a pass!", false)
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot acquire a swapchain texture on a secondary command buffer!", false)
     }
 
     bool result = COMMAND_BUFFER_DEVICE->AcquireSwapchainTexture(
@@ -2773,6 +3290,7 @@ bool SDL_WaitAndAcquireGPUSwapchainTexture(
     if (COMMAND_BUFFER_DEVICE->debug_mode) {
         CHECK_COMMAND_BUFFER_RETURN_FALSE
         CHECK_ANY_PASS_IN_PROGRESS("Cannot acquire a swapchain texture during a pass!", false)
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot acquire a swapchain texture on a secondary command buffer!", false)
     }
 
     bool result = COMMAND_BUFFER_DEVICE->WaitAndAcquireSwapchainTexture(
@@ -2793,6 +3311,9 @@ bool SDL_SubmitGPUCommandBuffer(
     SDL_GPUCommandBuffer *command_buffer)
 {
     CommandBufferCommonHeader *commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
+    SDL_GPUDevice *device;
+    GPUPassTimer *timer;
+    bool result;
 
     if (command_buffer == NULL) {
         SDL_InvalidParamError("command_buffer");
@@ -2808,18 +3329,33 @@ bool SDL_SubmitGPUCommandBuffer(
             SDL_assert_release(!"Cannot submit command buffer while a pass is in progress!");
             return false;
         }
+        CHECK_PRIMARY_COMMAND_BUFFER("Secondary command buffers are executed, not submitted!", false)
     }
 
     commandBufferHeader->submitted = true;
 
-    return COMMAND_BUFFER_DEVICE->Submit(
+    // The command buffer may be recycled as soon as it is submitted
+    device = COMMAND_BUFFER_DEVICE;
+    timer = commandBufferHeader->pass_timer;
+    commandBufferHeader->pass_timer = NULL;
+
+    result = device->Submit(
         command_buffer);
+
+    if (timer != NULL) {
+        SDL_GPU_FinishPassTimer(device, timer, result);
+    }
+
+    return result;
 }
 
 SDL_GPUFence *SDL_SubmitGPUCommandBufferAndAcquireFence(
     SDL_GPUCommandBuffer *command_buffer)
 {
     CommandBufferCommonHeader *commandBufferHeader = (CommandBufferCommonHeader *)command_buffer;
+    SDL_GPUDevice *device;
+    GPUPassTimer *timer;
+    SDL_GPUFence *fence;
 
     if (command_buffer == NULL) {
         SDL_InvalidParamError("command_buffer");
@@ -2835,12 +3371,24 @@ SDL_GPUFence *SDL_SubmitGPUCommandBufferAndAcquireFence(
             SDL_assert_release(!"Cannot submit command buffer while a pass is in progress!");
             return NULL;
         }
+        CHECK_PRIMARY_COMMAND_BUFFER("Secondary command buffers are executed, not submitted!", NULL)
     }
 
     commandBufferHeader->submitted = true;
 
-    return COMMAND_BUFFER_DEVICE->SubmitAndAcquireFence(
+    // The command buffer may be recycled as soon as it is submitted
+    device = COMMAND_BUFFER_DEVICE;
+    timer = commandBufferHeader->pass_timer;
+    commandBufferHeader->pass_timer = NULL;
+
+    fence = device->SubmitAndAcquireFence(
         command_buffer);
+
+    if (timer != NULL) {
+        SDL_GPU_FinishPassTimer(device, timer, fence != NULL);
+    }
+
+    return fence;
 }
 
 bool SDL_CancelGPUCommandBuffer(
@@ -2860,6 +3408,13 @@ bool SDL_CancelGPUCommandBuffer(
         }
     }
 
+    if (commandBufferHeader->pass_timer != NULL) {
+        // Nothing was written to the queries, so they can be reused right away
+        commandBufferHeader->pass_timer->num_passes = 0;
+        SDL_GPU_FinishPassTimer(COMMAND_BUFFER_DEVICE, commandBufferHeader->pass_timer, false);
+        commandBufferHeader->pass_timer = NULL;
+    }
+
     return COMMAND_BUFFER_DEVICE->Cancel(
         command_buffer);
 }
@@ -2867,10 +3422,28 @@ bool SDL_CancelGPUCommandBuffer(
 bool SDL_WaitForGPUIdle(
     SDL_GPUDevice *device)
 {
+    bool result;
+
     CHECK_DEVICE_MAGIC(device, false);
 
-    return device->Wait(
+    result = device->Wait(
         device->driverData);
+
+    if (result) {
+        GPUPassTimer *completed_timers;
+        SDL_GPUPassTimingCallback pass_timing_callback;
+        void *pass_timing_userdata;
+
+        SDL_LockMutex(device->pass_timer_lock);
+        completed_timers = SDL_GPU_CollectPassTimings(device);
+        pass_timing_callback = device->pass_timing_callback;
+        pass_timing_userdata = device->pass_timing_userdata;
+        SDL_UnlockMutex(device->pass_timer_lock);
+
+        SDL_GPU_DeliverPassTimings(device, completed_timers, pass_timing_callback, pass_timing_userdata);
+    }
+
+    return result;
 }
 
 bool SDL_WaitForGPUFences(
@@ -2921,6 +3494,141 @@ void SDL_ReleaseGPUFence(
         fence);
 }
 
+// Queries
+
+SDL_GPUQueryPool *SDL_CreateGPUQueryPool(
+    SDL_GPUDevice *device,
+    const SDL_GPUQueryPoolCreateInfo *createinfo)
+{
+    CHECK_DEVICE_MAGIC(device, NULL);
+    if (createinfo == NULL) {
+        SDL_InvalidParamError("createinfo");
+        return NULL;
+    }
+
+    if (device->debug_mode) {
+        if (createinfo->type != SDL_GPU_QUERYTYPE_TIMESTAMP) {
+            SDL_assert_release(!"Invalid query type!");
+            return NULL;
+        }
+        if (createinfo->num_queries == 0) {
+            SDL_assert_release(!"Query pool must hold at least one query!");
+            return NULL;
+        }
+    }
+
+    return device->CreateQueryPool(
+        device->driverData,
+        createinfo);
+}
+
+void SDL_WriteGPUTimestamp(
+    SDL_GPUCommandBuffer *command_buffer,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 query_index)
+{
+    if (command_buffer == NULL) {
+        SDL_InvalidParamError("command_buffer");
+        return;
+    }
+    if (query_pool == NULL) {
+        SDL_InvalidParamError("query_pool");
+        return;
+    }
+
+    if (COMMAND_BUFFER_DEVICE->debug_mode) {
+        CHECK_COMMAND_BUFFER
+        CHECK_ANY_PASS_IN_PROGRESS("Cannot write a timestamp during a pass!", )
+        CHECK_PRIMARY_COMMAND_BUFFER("Cannot write a timestamp on a secondary command buffer!", )
+        if (query_index >= ((QueryPoolCommonHeader *)query_pool)->num_queries) {
+            SDL_assert_release(!"Query index is out of range!");
+            return;
+        }
+    }
+
+    COMMAND_BUFFER_DEVICE->WriteTimestamp(
+        command_buffer,
+        query_pool,
+        query_index);
+}
+
+bool SDL_GetGPUQueryPoolResults(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool,
+    Uint32 first_query,
+    Uint32 num_queries,
+    Uint64 *results)
+{
+    CHECK_DEVICE_MAGIC(device, false);
+    if (query_pool == NULL) {
+        return SDL_InvalidParamError("query_pool");
+    }
+    if (results == NULL && num_queries > 0) {
+        return SDL_InvalidParamError("results");
+    }
+    if (num_queries == 0) {
+        return true;
+    }
+
+    if (device->debug_mode) {
+        const Uint32 pool_size = ((QueryPoolCommonHeader *)query_pool)->num_queries;
+        if (first_query >= pool_size || num_queries > pool_size - first_query) {
+            SDL_assert_release(!"Query range exceeds the query pool size!");
+            return false;
+        }
+    }
+
+    return device->GetQueryPoolResults(
+        device->driverData,
+        query_pool,
+        first_query,
+        num_queries,
+        results);
+}
+
+void SDL_ReleaseGPUQueryPool(
+    SDL_GPUDevice *device,
+    SDL_GPUQueryPool *query_pool)
+{
+    CHECK_DEVICE_MAGIC(device, );
+    if (query_pool == NULL) {
+        return;
+    }
+
+    device->ReleaseQueryPool(
+        device->driverData,
+        query_pool);
+}
+
+bool SDL_SetGPUPassTimingCallback(
+    SDL_GPUDevice *device,
+    SDL_GPUPassTimingCallback callback,
+    void *userdata)
+{
+    GPUPassTimer *timer;
+
+    CHECK_DEVICE_MAGIC(device, false);
+
+    SDL_LockMutex(device->pass_timer_lock);
+
+    if (callback != NULL && device->available_pass_timers == NULL) {
+        // Make sure timestamps work before promising to report anything
+        timer = SDL_GPU_AcquirePassTimer(device);
+        if (timer == NULL) {
+            SDL_UnlockMutex(device->pass_timer_lock);
+            return false;
+        }
+        device->available_pass_timers = timer;
+    }
+
+    device->pass_timing_callback = callback;
+    device->pass_timing_userdata = userdata;
+
+    SDL_UnlockMutex(device->pass_timer_lock);
+
+    return true;
+}
+
 Uint32 SDL_CalculateGPUTextureFormatSize(
     SDL_GPUTextureFormat format,
     Uint32 width,
@@ -0,0 +1,489 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+// Texture streaming: async file reads into mapped transfer buffers, uploaded in batches
+
+#define STAGING_BUFFER_GRANULARITY 65536 // 64 KiB
+#define MAX_FREE_STAGING_BUFFERS   16
+
+typedef struct GPUStagingBuffer
+{
+    SDL_GPUTransferBuffer *transferBuffer;
+    Uint32 size;
+    struct GPUStagingBuffer *next;
+} GPUStagingBuffer;
+
+typedef struct GPUStreamTask
+{
+    SDL_GPUTextureStreamRequest request;
+    GPUStagingBuffer *stagingBuffer;
+    bool success;
+    struct GPUStreamTask *next;
+} GPUStreamTask;
+
+typedef struct GPUStreamTaskList
+{
+    GPUStreamTask *head;
+    GPUStreamTask *tail;
+} GPUStreamTaskList;
+
+typedef struct GPUStreamBatch
+{
+    SDL_GPUFence *fence;
+    GPUStreamTaskList tasks;
+    struct GPUStreamBatch *next;
+} GPUStreamBatch;
+
+struct SDL_GPUTextureStreamer
+{
+    SDL_GPUDevice *device;
+    SDL_AsyncIOQueue *queue;
+    SDL_Mutex *lock;
+
+    GPUStagingBuffer *freeStagingBuffers;
+    Uint32 freeStagingBufferCount;
+
+    Uint32 pendingReadCount;          // reads queued with SDL_ReadAsyncIO
+    GPUStreamTaskList readTasks;      // reads that finished, waiting for the next flush
+    GPUStreamBatch *submittedBatches; // uploads waiting on a fence, oldest first
+    GPUStreamTaskList finishedTasks;  // waiting for SDL_GetGPUTextureStreamResult
+};
+
+static void SDL_GPU_AppendStreamTask(
+    GPUStreamTaskList *list,
+    GPUStreamTask *task)
+{
+    task->next = NULL;
+    if (list->tail) {
+        list->tail->next = task;
+    } else {
+        list->head = task;
+    }
+    list->tail = task;
+}
+
+static void SDL_GPU_AppendStreamTaskList(
+    GPUStreamTaskList *list,
+    GPUStreamTaskList *other)
+{
+    if (other->head == NULL) {
+        return;
+    }
+    if (list->tail) {
+        list->tail->next = other->head;
+    } else {
+        list->head = other->head;
+    }
+    list->tail = other->tail;
+    other->head = NULL;
+    other->tail = NULL;
+}
+
+static GPUStagingBuffer *SDL_GPU_AcquireStagingBuffer(
+    SDL_GPUTextureStreamer *streamer,
+    Uint32 size)
+{
+    GPUStagingBuffer *prev = NULL;
+    GPUStagingBuffer *stagingBuffer;
+    SDL_GPUTransferBufferCreateInfo createinfo;
+
+    // Reuse a free buffer if it isn't wastefully large
+    for (stagingBuffer = streamer->freeStagingBuffers; stagingBuffer; stagingBuffer = stagingBuffer->next) {
+        if (stagingBuffer->size >= size && stagingBuffer->size / 2 <= size) {
+            if (prev) {
+                prev->next = stagingBuffer->next;
+            } else {
+                streamer->freeStagingBuffers = stagingBuffer->next;
+            }
+            streamer->freeStagingBufferCount -= 1;
+            stagingBuffer->next = NULL;
+            return stagingBuffer;
+        }
+        prev = stagingBuffer;
+    }
+
+    stagingBuffer = SDL_malloc(sizeof(GPUStagingBuffer));
+    if (stagingBuffer == NULL) {
+        return NULL;
+    }
+
+    SDL_zero(createinfo);
+    createinfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+    createinfo.size = size;
+    if (size <= SDL_MAX_UINT32 - (STAGING_BUFFER_GRANULARITY - 1)) {
+        createinfo.size = (size + STAGING_BUFFER_GRANULARITY - 1) & ~(Uint32)(STAGING_BUFFER_GRANULARITY - 1);
+    }
+
+    stagingBuffer->transferBuffer = SDL_CreateGPUTransferBuffer(streamer->device, &createinfo);
+    if (stagingBuffer->transferBuffer == NULL) {
+        SDL_free(stagingBuffer);
+        return NULL;
+    }
+    stagingBuffer->size = createinfo.size;
+    stagingBuffer->next = NULL;
+
+    return stagingBuffer;
+}
+
+static void SDL_GPU_ReturnStagingBuffer(
+    SDL_GPUTextureStreamer *streamer,
+    GPUStagingBuffer *stagingBuffer)
+{
+    if (streamer->freeStagingBufferCount >= MAX_FREE_STAGING_BUFFERS) {
+        SDL_ReleaseGPUTransferBuffer(streamer->device, stagingBuffer->transferBuffer);
+        SDL_free(stagingBuffer);
+        return;
+    }
+
+    stagingBuffer->next = streamer->freeStagingBuffers;
+    streamer->freeStagingBuffers = stagingBuffer;
+    streamer->freeStagingBufferCount += 1;
+}
+
+static void SDL_GPU_FinishStreamTask(
+    SDL_GPUTextureStreamer *streamer,
+    GPUStreamTask *task,
+    bool success)
+{
+    SDL_GPU_ReturnStagingBuffer(streamer, task->stagingBuffer);
+    task->stagingBuffer = NULL;
+    task->success = success;
+    SDL_GPU_AppendStreamTask(&streamer->finishedTasks, task);
+}
+
+static void SDL_GPU_CompleteStreamRead(
+    SDL_GPUTextureStreamer *streamer,
+    const SDL_AsyncIOOutcome *outcome)
+{
+    GPUStreamTask *task = (GPUStreamTask *)outcome->userdata;
+
+    streamer->pendingReadCount -= 1;
+
+    SDL_UnmapGPUTransferBuffer(streamer->device, task->stagingBuffer->transferBuffer);
+
+    if (outcome->result == SDL_ASYNCIO_COMPLETE && outcome->bytes_transferred == task->request.size) {
+        SDL_GPU_AppendStreamTask(&streamer->readTasks, task);
+    } else {
+        SDL_GPU_FinishStreamTask(streamer, task, false);
+    }
+}
+
+static void SDL_GPU_RetireStreamBatches(
+    SDL_GPUTextureStreamer *streamer,
+    bool wait)
+{
+    while (streamer->submittedBatches) {
+        GPUStreamBatch *batch = streamer->submittedBatches;
+        GPUStreamTask *task;
+
+        if (wait) {
+            SDL_WaitForGPUFences(streamer->device, true, &batch->fence, 1);
+        } else if (!SDL_QueryGPUFence(streamer->device, batch->fence)) {
+            // Batches are submitted in order, so later ones can't be done either
+            break;
+        }
+
+        SDL_ReleaseGPUFence(streamer->device, batch->fence);
+
+        for (task = batch->tasks.head; task; task = task->next) {
+            SDL_GPU_ReturnStagingBuffer(streamer, task->stagingBuffer);
+            task->stagingBuffer = NULL;
+            task->success = true;
+        }
+        SDL_GPU_AppendStreamTaskList(&streamer->finishedTasks, &batch->tasks);
+
+        streamer->submittedBatches = batch->next;
+        SDL_free(batch);
+    }
+}
+
+static bool SDL_GPU_SubmitStreamBatch(
+    SDL_GPUTextureStreamer *streamer)
+{
+    SDL_GPUCommandBuffer *commandBuffer;
+    SDL_GPUCopyPass *copyPass;
+    GPUStreamBatch *batch;
+    GPUStreamBatch **tail;
+    GPUStreamTask *task;
+
+    batch = SDL_calloc(1, sizeof(GPUStreamBatch));
+    if (batch == NULL) {
+        return false;
+    }
+
+    commandBuffer = SDL_AcquireGPUCommandBuffer(streamer->device);
+    if (commandBuffer == NULL) {
+        // The reads stay queued for the next flush
+        SDL_free(batch);
+        return false;
+    }
+
+    copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+    for (task = streamer->readTasks.head; task; task = task->next) {
+        SDL_GPUTextureTransferInfo source;
+
+        source.transfer_buffer = task->stagingBuffer->transferBuffer;
+        source.offset = 0;
+        source.pixels_per_row = task->request.pixels_per_row;
+        source.rows_per_layer = task->request.rows_per_layer;
+
+        SDL_UploadToGPUTexture(
+            copyPass,
+            &source,
+            &task->request.destination,
+            task->request.cycle);
+    }
+    SDL_EndGPUCopyPass(copyPass);
+
+    batch->fence = SDL_SubmitGPUCommandBufferAndAcquireFence(commandBuffer);
+    if (batch->fence == NULL) {
+        SDL_free(batch);
+        return false;
+    }
+
+    SDL_GPU_AppendStreamTaskList(&batch->tasks, &streamer->readTasks);
+
+    tail = &streamer->submittedBatches;
+    while (*tail) {
+        tail = &(*tail)->next;
+    }
+    *tail = batch;
+
+    return true;
+}
+
+SDL_GPUTextureStreamer *SDL_CreateGPUTextureStreamer(
+    SDL_GPUDevice *device)
+{
+    SDL_GPUTextureStreamer *streamer;
+
+    if (device == NULL) {
+        SDL_SetError("Invalid GPU device");
+        return NULL;
+    }
+
+    streamer = SDL_calloc(1, sizeof(SDL_GPUTextureStreamer));
+    if (streamer == NULL) {
+        return NULL;
+    }
+
+    streamer->device = device;
+
+    streamer->queue = SDL_CreateAsyncIOQueue();
+    if (streamer->queue == NULL) {
+        SDL_free(streamer);
+        return NULL;
+    }
+
+    streamer->lock = SDL_CreateMutex();
+    if (streamer->lock == NULL) {
+        SDL_DestroyAsyncIOQueue(streamer->queue);
+        SDL_free(streamer);
+        return NULL;
+    }
+
+    return streamer;
+}
+
+bool SDL_StreamGPUTexture(
+    SDL_GPUTextureStreamer *streamer,
+    const SDL_GPUTextureStreamRequest *request)
+{
+    GPUStreamTask *task;
+    void *mapped;
+
+    if (streamer == NULL) {
+        return SDL_InvalidParamError("streamer");
+    }
+    if (request == NULL) {
+        return SDL_InvalidParamError("request");
+    }
+    if (request->asyncio == NULL) {
+        return SDL_InvalidParamError("request->asyncio");
+    }
+    if (request->destination.texture == NULL) {
+        return SDL_InvalidParamError("request->destination.texture");
+    }
+    if (request->size == 0) {
+        return SDL_InvalidParamError("request->size");
+    }
+
+    task = SDL_malloc(sizeof(GPUStreamTask));
+    if (task == NULL) {
+        return false;
+    }
+    task->request = *request;
+    task->success = false;
+    task->next = NULL;
+
+    SDL_LockMutex(streamer->lock);
+
+    task->stagingBuffer = SDL_GPU_AcquireStagingBuffer(streamer, request->size);
+    if (task->stagingBuffer == NULL) {
+        SDL_UnlockMutex(streamer->lock);
+        SDL_free(task);
+        return false;
+    }
+
+    // Staging buffers are only reused once their upload has completed, so no need to cycle
+    mapped = SDL_MapGPUTransferBuffer(streamer->device, task->stagingBuffer->transferBuffer, false);
+    if (mapped == NULL) {
+        SDL_GPU_ReturnStagingBuffer(streamer, task->stagingBuffer);
+        SDL_UnlockMutex(streamer->lock);
+        SDL_free(task);
+        return false;
+    }
+
+    if (!SDL_ReadAsyncIO(request->asyncio, mapped, request->offset, request->size, streamer->queue, task)) {
+        SDL_UnmapGPUTransferBuffer(streamer->device, task->stagingBuffer->transferBuffer);
+        SDL_GPU_ReturnStagingBuffer(streamer, task->stagingBuffer);
+        SDL_UnlockMutex(streamer->lock);
+        SDL_free(task);
+        return false;
+    }
+
+    streamer->pendingReadCount += 1;
+
+    SDL_UnlockMutex(streamer->lock);
+
+    return true;
+}
+
+bool SDL_FlushGPUTextureStreamer(
+    SDL_GPUTextureStreamer *streamer)
+{
+    SDL_AsyncIOOutcome outcome;
+    bool result = true;
+
+    if (streamer == NULL) {
+        return SDL_InvalidParamError("streamer");
+    }
+
+    SDL_LockMutex(streamer->lock);
+
+    while (SDL_GetAsyncIOResult(streamer->queue, &outcome)) {
+        SDL_GPU_CompleteStreamRead(streamer, &outcome);
+    }
+
+    SDL_GPU_RetireStreamBatches(streamer, false);
+
+    if (streamer->readTasks.head) {
+        result = SDL_GPU_SubmitStreamBatch(streamer);
+    }
+
+    SDL_UnlockMutex(streamer->lock);
+
+    return result;
+}
+
+bool SDL_GetGPUTextureStreamResult(
+    SDL_GPUTextureStreamer *streamer,
+    void **userdata,
+    bool *success)
+{
+    GPUStreamTask *task;
+
+    if (userdata) {
+        *userdata = NULL;
+    }
+    if (success) {
+        *success = false;
+    }
+
+    if (streamer == NULL) {
+        SDL_InvalidParamError("streamer");
+        return false;
+    }
+    if (userdata == NULL) {
+        SDL_InvalidParamError("userdata");
+        return false;
+    }
+
+    SDL_LockMutex(streamer->lock);
+
+    task = streamer->finishedTasks.head;
+    if (task) {
+        streamer->finishedTasks.head = task->next;
+        if (streamer->finishedTasks.head == NULL) {
+            streamer->finishedTasks.tail = NULL;
+        }
+    }
+
+    SDL_UnlockMutex(streamer->lock);
+
+    if (task == NULL) {
+        return false;
+    }
+
+    *userdata = task->request.userdata;
+    if (success) {
+        *success = task->success;
+    }
+    SDL_free(task);
+
+    return true;
+}
+
+void SDL_DestroyGPUTextureStreamer(
+    SDL_GPUTextureStreamer *streamer)
+{
+    SDL_AsyncIOOutcome outcome;
+    GPUStreamTask *task;
+    GPUStreamTask *next;
+
+    if (streamer == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(streamer->lock);
+
+    // The reads are writing into our transfer buffers, so they have to land first
+    while (streamer->pendingReadCount > 0 && SDL_WaitAsyncIOResult(streamer->queue, &outcome, -1)) {
+        SDL_GPU_CompleteStreamRead(streamer, &outcome);
+    }
+
+    SDL_GPU_RetireStreamBatches(streamer, true);
+
+    for (task = streamer->readTasks.head; task; task = next) {
+        next = task->next;
+        SDL_GPU_ReturnStagingBuffer(streamer, task->stagingBuffer);
+        SDL_free(task);
+    }
+
+    for (task = streamer->finishedTasks.head; task; task = next) {
+        next = task->next;
+        SDL_free(task);
+    }
+
+    while (streamer->freeStagingBuffers) {
+        GPUStagingBuffer *stagingBuffer = streamer->freeStagingBuffers;
+        streamer->freeStagingBuffers = stagingBuffer->next;
+        SDL_ReleaseGPUTransferBuffer(streamer->device, stagingBuffer->transferBuffer);
+        SDL_free(stagingBuffer);
+    }
+
+    SDL_UnlockMutex(streamer->lock);
+
+    SDL_DestroyAsyncIOQueue(streamer->queue);
+    SDL_DestroyMutex(streamer->lock);
+    SDL_free(streamer);
+}
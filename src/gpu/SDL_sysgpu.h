@@ -32,10 +32,25 @@ typedef struct Pass
     bool in_progress;
 } Pass;
 
+// Timestamps for the passes of one command buffer, see SDL_SetGPUPassTimingCallback()
+#define GPU_PASS_TIMER_MAX_PASSES 32
+
+typedef struct GPUPassTimer
+{
+    SDL_GPUQueryPool *query_pool;
+    Uint32 num_passes;
+    SDL_GPUPassType pass_types[GPU_PASS_TIMER_MAX_PASSES];
+    SDL_GPUPassTiming timings[GPU_PASS_TIMER_MAX_PASSES]; // filled in once the results are ready
+    struct GPUPassTimer *next;
+} GPUPassTimer;
+
 typedef struct CommandBufferCommonHeader
 {
     SDL_GPUDevice *device;
+    GPUPassTimer *pass_timer;
+    SDL_GPUCommandBuffer *parent; // non-NULL for secondary command buffers
     Pass render_pass;
+    bool parallel_render_pass;
     bool graphics_pipeline_bound;
     Pass compute_pass;
     bool compute_pipeline_bound;
@@ -49,6 +64,11 @@ typedef struct TextureCommonHeader
     SDL_GPUTextureCreateInfo info;
 } TextureCommonHeader;
 
+typedef struct QueryPoolCommonHeader
+{
+    Uint32 num_queries;
+} QueryPoolCommonHeader;
+
 typedef struct BlitFragmentUniforms
 {
     // texcoord space
@@ -382,6 +402,8 @@ static inline Uint32 BytesPerRow(
 #define MAX_COMPUTE_WRITE_TEXTURES     8
 #define MAX_COMPUTE_WRITE_BUFFERS      8
 #define UNIFORM_BUFFER_SIZE            32768
+#define TRANSIENT_BUFFER_SIZE          4194304
+#define TRANSIENT_BUFFER_ALIGNMENT     16
 #define MAX_VERTEX_BUFFERS             16
 #define MAX_VERTEX_ATTRIBUTES          16
 #define MAX_COLOR_TARGET_BINDINGS      4
@@ -863,6 +885,84 @@ struct SDL_GPUDevice
         SDL_GPUTextureFormat format,
         SDL_GPUSampleCount desiredSampleCount);
 
+    // Pipeline Cache
+
+    void *(*GetPipelineCacheData)(
+        SDL_GPURenderer *driverData,
+        size_t *size);
+
+    // Memory Statistics
+
+    SDL_GPUMemoryHeapStats *(*GetMemoryStats)(
+        SDL_GPURenderer *driverData,
+        int *count);
+
+    // Bindless Textures
+
+    Uint32 (*GetBindlessTextureCapacity)(
+        SDL_GPURenderer *driverData);
+
+    bool (*AddBindlessTexture)(
+        SDL_GPURenderer *driverData,
+        const SDL_GPUTextureSamplerBinding *binding,
+        Uint32 *index);
+
+    void (*RemoveBindlessTexture)(
+        SDL_GPURenderer *driverData,
+        Uint32 index);
+
+    // Queries
+
+    SDL_GPUQueryPool *(*CreateQueryPool)(
+        SDL_GPURenderer *driverData,
+        const SDL_GPUQueryPoolCreateInfo *createinfo);
+
+    void (*WriteTimestamp)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUQueryPool *queryPool,
+        Uint32 queryIndex);
+
+    bool (*QueryPoolResultsAvailable)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueryPool *queryPool);
+
+    bool (*GetQueryPoolResults)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueryPool *queryPool,
+        Uint32 firstQuery,
+        Uint32 numQueries,
+        Uint64 *results);
+
+    void (*ReleaseQueryPool)(
+        SDL_GPURenderer *driverData,
+        SDL_GPUQueryPool *queryPool);
+
+    // Secondary Command Buffers
+
+    bool (*BeginParallelRenderPass)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        const SDL_GPUColorTargetInfo *colorTargetInfos,
+        Uint32 numColorTargets,
+        const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo);
+
+    SDL_GPUCommandBuffer *(*AcquireSecondaryCommandBuffer)(
+        SDL_GPUCommandBuffer *commandBuffer);
+
+    bool (*EndSecondaryCommandBuffer)(
+        SDL_GPUCommandBuffer *commandBuffer);
+
+    void (*ExecuteSecondaryCommandBuffers)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        SDL_GPUCommandBuffer *const *secondaryCommandBuffers,
+        Uint32 numSecondaryCommandBuffers);
+
+    // Transient Memory
+
+    void *(*AllocateTransientMemory)(
+        SDL_GPUCommandBuffer *commandBuffer,
+        Uint32 size,
+        SDL_GPUBufferBinding *binding);
+
     // Opaque pointer for the Driver
     SDL_GPURenderer *driverData;
 
@@ -874,6 +974,13 @@ struct SDL_GPUDevice
 
     // Store this for SDL_gpu.c's debug layer
     bool debug_mode;
+
+    // Pass timing state for SDL_gpu.c, protected by pass_timer_lock
+    SDL_Mutex *pass_timer_lock;
+    SDL_GPUPassTimingCallback pass_timing_callback;
+    void *pass_timing_userdata;
+    GPUPassTimer *available_pass_timers;
+    GPUPassTimer *pending_pass_timers;
 };
 
 #define ASSIGN_DRIVER_FUNC(func, name) \
@@ -960,7 +1067,22 @@ struct SDL_GPUDevice
     ASSIGN_DRIVER_FUNC(QueryFence, name)                    \
     ASSIGN_DRIVER_FUNC(ReleaseFence, name)                  \
     ASSIGN_DRIVER_FUNC(SupportsTextureFormat, name)         \
-    ASSIGN_DRIVER_FUNC(SupportsSampleCount, name)
+    ASSIGN_DRIVER_FUNC(SupportsSampleCount, name)           \
+    ASSIGN_DRIVER_FUNC(GetPipelineCacheData, name)          \
+    ASSIGN_DRIVER_FUNC(GetMemoryStats, name)                \
+    ASSIGN_DRIVER_FUNC(GetBindlessTextureCapacity, name)    \
+    ASSIGN_DRIVER_FUNC(AddBindlessTexture, name)            \
+    ASSIGN_DRIVER_FUNC(RemoveBindlessTexture, name)         \
+    ASSIGN_DRIVER_FUNC(CreateQueryPool, name)               \
+    ASSIGN_DRIVER_FUNC(WriteTimestamp, name)                \
+    ASSIGN_DRIVER_FUNC(QueryPoolResultsAvailable, name)     \
+    ASSIGN_DRIVER_FUNC(GetQueryPoolResults, name)           \
+    ASSIGN_DRIVER_FUNC(ReleaseQueryPool, name)              \
+    ASSIGN_DRIVER_FUNC(BeginParallelRenderPass, name)       \
+    ASSIGN_DRIVER_FUNC(AcquireSecondaryCommandBuffer, name) \
+    ASSIGN_DRIVER_FUNC(EndSecondaryCommandBuffer, name)     \
+    ASSIGN_DRIVER_FUNC(ExecuteSecondaryCommandBuffers, name)\
+    ASSIGN_DRIVER_FUNC(AllocateTransientMemory, name)
 
 typedef struct SDL_GPUBootstrap
 {
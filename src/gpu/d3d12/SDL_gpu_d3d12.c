@@ -171,6 +171,7 @@ static const IID D3D_IID_ID3D12GraphicsCommandList = { 0x5b160d0f, 0xac1b, 0x418
 static const IID D3D_IID_ID3D12Fence = { 0x0a753dcf, 0xc4d8, 0x4b91, { 0xad, 0xf6, 0xbe, 0x5a, 0x60, 0xd9, 0x5a, 0x76 } };
 static const IID D3D_IID_ID3D12RootSignature = { 0xc54a6b66, 0x72df, 0x4ee8, { 0x8b, 0xe5, 0xa9, 0x46, 0xa1, 0x42, 0x92, 0x14 } };
 static const IID D3D_IID_ID3D12CommandSignature = { 0xc36a797c, 0xec80, 0x4f0a, { 0x89, 0x85, 0xa7, 0xb2, 0x47, 0x50, 0x82, 0xd1 } };
+static const IID D3D_IID_ID3D12QueryHeap = { 0x0d9658ae, 0xed45, 0x469e, { 0xa6, 0x1d, 0x97, 0x0e, 0xc5, 0x83, 0xca, 0xb4 } };
 static const IID D3D_IID_ID3D12PipelineState = { 0x765a30f3, 0xf624, 0x4c6f, { 0xa8, 0x28, 0xac, 0xe9, 0x48, 0x62, 0x24, 0x45 } };
 static const IID D3D_IID_ID3D12Debug = { 0x344488b7, 0x6846, 0x474b, { 0xb9, 0x89, 0xf0, 0x27, 0x44, 0x82, 0x45, 0xe0 } };
 static const IID D3D_IID_ID3D12InfoQueue = { 0x0742a90b, 0xc387, 0x483f, { 0xb9, 0x46, 0x30, 0xa7, 0xe4, 0xe6, 0x14, 0x58 } };
@@ -615,6 +616,7 @@ typedef struct D3D12UniformBuffer D3D12UniformBuffer;
 typedef struct D3D12DescriptorHeap D3D12DescriptorHeap;
 typedef struct D3D12StagingDescriptor D3D12StagingDescriptor;
 typedef struct D3D12TextureDownload D3D12TextureDownload;
+typedef struct D3D12QueryPool D3D12QueryPool;
 
 typedef struct D3D12Fence
 {
@@ -846,6 +848,10 @@ struct D3D12Renderer
     Uint32 computePipelinesToDestroyCount;
     Uint32 computePipelinesToDestroyCapacity;
 
+    D3D12QueryPool **queryPoolsToDestroy;
+    Uint32 queryPoolsToDestroyCount;
+    Uint32 queryPoolsToDestroyCapacity;
+
     // Locks
     SDL_Mutex *acquireCommandBufferLock;
     SDL_Mutex *acquireUniformBufferLock;
@@ -949,6 +955,10 @@ struct D3D12CommandBuffer
     Uint32 usedComputePipelineCount;
     Uint32 usedComputePipelineCapacity;
 
+    D3D12QueryPool **usedQueryPools;
+    Uint32 usedQueryPoolCount;
+    Uint32 usedQueryPoolCapacity;
+
     // Used for texture pitch hack
     D3D12TextureDownload **textureDownloads;
     Uint32 textureDownloadCount;
@@ -1036,6 +1046,16 @@ struct D3D12ComputePipeline
     SDL_AtomicInt referenceCount;
 };
 
+struct D3D12QueryPool
+{
+    QueryPoolCommonHeader header;
+    ID3D12QueryHeap *queryHeap;
+    D3D12Buffer *readbackBuffer; // resolved query results
+    Uint64 frequency;
+
+    SDL_AtomicInt referenceCount;
+};
+
 struct D3D12TextureDownload
 {
     D3D12Buffer *destinationBuffer;
@@ -1398,6 +1418,17 @@ static void D3D12_INTERNAL_DestroyComputePipeline(
     SDL_free(computePipeline);
 }
 
+static void D3D12_INTERNAL_DestroyQueryPool(
+    D3D12Renderer *renderer,
+    D3D12QueryPool *queryPool)
+{
+    if (queryPool->queryHeap) {
+        ID3D12QueryHeap_Release(queryPool->queryHeap);
+    }
+    D3D12_INTERNAL_DestroyBuffer(renderer, queryPool->readbackBuffer);
+    SDL_free(queryPool);
+}
+
 static void D3D12_INTERNAL_ReleaseFenceToPool(
     D3D12Renderer *renderer,
     D3D12Fence *fence)
@@ -1479,6 +1510,7 @@ static void D3D12_INTERNAL_DestroyCommandBuffer(D3D12CommandBuffer *commandBuffe
     SDL_free(commandBuffer->usedSamplers);
     SDL_free(commandBuffer->usedGraphicsPipelines);
     SDL_free(commandBuffer->usedComputePipelines);
+    SDL_free(commandBuffer->usedQueryPools);
     SDL_free(commandBuffer->usedUniformBuffers);
     SDL_free(commandBuffer->textureDownloads);
     SDL_free(commandBuffer);
@@ -1559,6 +1591,7 @@ static void D3D12_INTERNAL_DestroyRenderer(D3D12Renderer *renderer)
     SDL_free(renderer->samplersToDestroy);
     SDL_free(renderer->graphicsPipelinesToDestroy);
     SDL_free(renderer->computePipelinesToDestroy);
+    SDL_free(renderer->queryPoolsToDestroy);
 
     // Tear down D3D12 objects
     if (renderer->indirectDrawCommandSignature) {
@@ -1933,6 +1966,18 @@ static void D3D12_INTERNAL_TrackComputePipeline(
         usedComputePipelineCapacity)
 }
 
+static void D3D12_INTERNAL_TrackQueryPool(
+    D3D12CommandBuffer *commandBuffer,
+    D3D12QueryPool *queryPool)
+{
+    TRACK_RESOURCE(
+        queryPool,
+        D3D12QueryPool *,
+        usedQueryPools,
+        usedQueryPoolCount,
+        usedQueryPoolCapacity)
+}
+
 #undef TRACK_RESOURCE
 
 // Debug Naming
@@ -7126,6 +7171,11 @@ static bool D3D12_INTERNAL_AllocateCommandBuffer(
     commandBuffer->usedComputePipelines = (D3D12ComputePipeline **)SDL_calloc(
         commandBuffer->usedComputePipelineCapacity, sizeof(D3D12ComputePipeline *));
 
+    commandBuffer->usedQueryPoolCapacity = 4;
+    commandBuffer->usedQueryPoolCount = 0;
+    commandBuffer->usedQueryPools = (D3D12QueryPool **)SDL_calloc(
+        commandBuffer->usedQueryPoolCapacity, sizeof(D3D12QueryPool *));
+
     commandBuffer->usedUniformBufferCapacity = 4;
     commandBuffer->usedUniformBufferCount = 0;
     commandBuffer->usedUniformBuffers = (D3D12UniformBuffer **)SDL_calloc(
@@ -7143,6 +7193,7 @@ static bool D3D12_INTERNAL_AllocateCommandBuffer(
         (!commandBuffer->usedSamplers) ||
         (!commandBuffer->usedGraphicsPipelines) ||
         (!commandBuffer->usedComputePipelines) ||
+        (!commandBuffer->usedQueryPools) ||
         (!commandBuffer->usedUniformBuffers) ||
         (!commandBuffer->textureDownloads)) {
         D3D12_INTERNAL_DestroyCommandBuffer(commandBuffer);
@@ -7462,6 +7513,17 @@ static void D3D12_INTERNAL_PerformPendingDestroys(D3D12Renderer *renderer)
         }
     }
 
+    for (Sint32 i = renderer->queryPoolsToDestroyCount - 1; i >= 0; i -= 1) {
+        if (SDL_GetAtomicInt(&renderer->queryPoolsToDestroy[i]->referenceCount) == 0) {
+            D3D12_INTERNAL_DestroyQueryPool(
+                renderer,
+                renderer->queryPoolsToDestroy[i]);
+
+            renderer->queryPoolsToDestroy[i] = renderer->queryPoolsToDestroy[renderer->queryPoolsToDestroyCount - 1];
+            renderer->queryPoolsToDestroyCount -= 1;
+        }
+    }
+
     SDL_UnlockMutex(renderer->disposeLock);
 }
 
@@ -7595,6 +7657,11 @@ static bool D3D12_INTERNAL_CleanCommandBuffer(
     }
     commandBuffer->usedComputePipelineCount = 0;
 
+    for (i = 0; i < commandBuffer->usedQueryPoolCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedQueryPools[i]->referenceCount);
+    }
+    commandBuffer->usedQueryPoolCount = 0;
+
     // Reset presentation
     commandBuffer->presentDataCount = 0;
 
@@ -8057,6 +8124,269 @@ static bool D3D12_SupportsSampleCount(
     return SUCCEEDED(res) && featureData.NumQualityLevels > 0;
 }
 
+// Queries
+
+static SDL_GPUQueryPool *D3D12_CreateQueryPool(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUQueryPoolCreateInfo *createinfo)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    D3D12_QUERY_HEAP_DESC queryHeapDesc;
+    D3D12QueryPool *queryPool;
+    HRESULT res;
+
+    queryPool = (D3D12QueryPool *)SDL_calloc(1, sizeof(D3D12QueryPool));
+    if (!queryPool) {
+        return NULL;
+    }
+
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    queryHeapDesc.Count = createinfo->num_queries;
+    queryHeapDesc.NodeMask = 0;
+
+    res = ID3D12Device_CreateQueryHeap(
+        renderer->device,
+        &queryHeapDesc,
+        D3D_GUID(D3D_IID_ID3D12QueryHeap),
+        (void **)&queryPool->queryHeap);
+    if (FAILED(res)) {
+        D3D12_INTERNAL_SetError(renderer, "Could not create query heap!", res);
+        D3D12_INTERNAL_DestroyQueryPool(renderer, queryPool);
+        return NULL;
+    }
+
+    res = ID3D12CommandQueue_GetTimestampFrequency(
+        renderer->commandQueue,
+        &queryPool->frequency);
+    if (FAILED(res) || queryPool->frequency == 0) {
+        D3D12_INTERNAL_SetError(renderer, "Could not get timestamp frequency!", res);
+        D3D12_INTERNAL_DestroyQueryPool(renderer, queryPool);
+        return NULL;
+    }
+
+    queryPool->readbackBuffer = D3D12_INTERNAL_CreateBuffer(
+        renderer,
+        0,
+        createinfo->num_queries * sizeof(Uint64),
+        D3D12_BUFFER_TYPE_DOWNLOAD,
+        NULL);
+    if (!queryPool->readbackBuffer) {
+        D3D12_INTERNAL_DestroyQueryPool(renderer, queryPool);
+        return NULL;
+    }
+
+    queryPool->header.num_queries = createinfo->num_queries;
+    SDL_SetAtomicInt(&queryPool->referenceCount, 0);
+
+    return (SDL_GPUQueryPool *)queryPool;
+}
+
+static void D3D12_WriteTimestamp(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 queryIndex)
+{
+    D3D12CommandBuffer *d3d12CommandBuffer = (D3D12CommandBuffer *)commandBuffer;
+    D3D12Renderer *renderer = d3d12CommandBuffer->renderer;
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+
+    if (queryIndex >= d3d12QueryPool->header.num_queries) {
+        SET_ERROR_AND_RETURN("Query index %" SDL_PRIu32 " is out of range", queryIndex, );
+    }
+
+    ID3D12GraphicsCommandList_EndQuery(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12QueryPool->queryHeap,
+        D3D12_QUERY_TYPE_TIMESTAMP,
+        queryIndex);
+
+    // Resolve right away so the result lands in the readback buffer when this command buffer completes
+    ID3D12GraphicsCommandList_ResolveQueryData(
+        d3d12CommandBuffer->graphicsCommandList,
+        d3d12QueryPool->queryHeap,
+        D3D12_QUERY_TYPE_TIMESTAMP,
+        queryIndex,
+        1,
+        d3d12QueryPool->readbackBuffer->handle,
+        queryIndex * sizeof(Uint64));
+
+    D3D12_INTERNAL_TrackQueryPool(d3d12CommandBuffer, d3d12QueryPool);
+}
+
+static bool D3D12_QueryPoolResultsAvailable(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+    (void)driverData;
+
+    // Results land once every command buffer that writes to this pool has completed
+    return SDL_GetAtomicInt(&d3d12QueryPool->referenceCount) == 0;
+}
+
+static bool D3D12_GetQueryPoolResults(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 numQueries,
+    Uint64 *results)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    D3D12QueryPool *d3d12QueryPool = (D3D12QueryPool *)queryPool;
+    D3D12_RANGE readRange;
+    D3D12_RANGE writeRange;
+    Uint8 *data;
+    HRESULT res;
+
+    if (firstQuery >= d3d12QueryPool->header.num_queries ||
+        numQueries > d3d12QueryPool->header.num_queries - firstQuery) {
+        SET_STRING_ERROR_AND_RETURN("Query range exceeds the query pool size", false);
+    }
+
+    if (!D3D12_QueryPoolResultsAvailable(driverData, queryPool)) {
+        return SDL_SetError("Query results are not available yet");
+    }
+
+    readRange.Begin = firstQuery * sizeof(Uint64);
+    readRange.End = readRange.Begin + numQueries * sizeof(Uint64);
+
+    res = ID3D12Resource_Map(
+        d3d12QueryPool->readbackBuffer->handle,
+        0,
+        &readRange,
+        (void **)&data);
+    CHECK_D3D12_ERROR_AND_RETURN("Failed to map query readback buffer", false);
+
+    SDL_memcpy(results, data + readRange.Begin, numQueries * sizeof(Uint64));
+
+    writeRange.Begin = 0;
+    writeRange.End = 0;
+    ID3D12Resource_Unmap(
+        d3d12QueryPool->readbackBuffer->handle,
+        0,
+        &writeRange);
+
+    // Convert ticks to nanoseconds
+    for (Uint32 i = 0; i < numQueries; i += 1) {
+        results[i] = (Uint64)((double)results[i] * 1000000000.0 / (double)d3d12QueryPool->frequency);
+    }
+
+    return true;
+}
+
+static void D3D12_ReleaseQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+
+    SDL_LockMutex(renderer->disposeLock);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->queryPoolsToDestroy,
+        D3D12QueryPool *,
+        renderer->queryPoolsToDestroyCount + 1,
+        renderer->queryPoolsToDestroyCapacity,
+        renderer->queryPoolsToDestroyCapacity * 2);
+
+    renderer->queryPoolsToDestroy[renderer->queryPoolsToDestroyCount] = (D3D12QueryPool *)queryPool;
+    renderer->queryPoolsToDestroyCount += 1;
+
+    SDL_UnlockMutex(renderer->disposeLock);
+}
+
+static void *D3D12_GetPipelineCacheData(
+    SDL_GPURenderer *driverData,
+    size_t *size)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    (void)size;
+    SET_STRING_ERROR_AND_RETURN("Pipeline caches are not supported by the D3D12 backend", NULL);
+}
+
+static SDL_GPUMemoryHeapStats *D3D12_GetMemoryStats(
+    SDL_GPURenderer *driverData,
+    int *count)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    (void)count;
+    SET_STRING_ERROR_AND_RETURN("Memory statistics are not supported by the D3D12 backend", NULL);
+}
+
+static Uint32 D3D12_GetBindlessTextureCapacity(
+    SDL_GPURenderer *driverData)
+{
+    (void)driverData;
+    return 0;
+}
+
+static bool D3D12_AddBindlessTexture(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUTextureSamplerBinding *binding,
+    Uint32 *index)
+{
+    D3D12Renderer *renderer = (D3D12Renderer *)driverData;
+    (void)binding;
+    (void)index;
+    SET_STRING_ERROR_AND_RETURN("Bindless textures are not supported by the D3D12 backend", false);
+}
+
+static void D3D12_RemoveBindlessTexture(
+    SDL_GPURenderer *driverData,
+    Uint32 index)
+{
+    (void)driverData;
+    (void)index;
+}
+
+static bool D3D12_BeginParallelRenderPass(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUColorTargetInfo *colorTargetInfos,
+    Uint32 numColorTargets,
+    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo)
+{
+    D3D12Renderer *renderer = ((D3D12CommandBuffer *)commandBuffer)->renderer;
+    (void)colorTargetInfos;
+    (void)numColorTargets;
+    (void)depthStencilTargetInfo;
+    SET_STRING_ERROR_AND_RETURN("Parallel render passes are not supported by the D3D12 backend", false);
+}
+
+static SDL_GPUCommandBuffer *D3D12_AcquireSecondaryCommandBuffer(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    D3D12Renderer *renderer = ((D3D12CommandBuffer *)commandBuffer)->renderer;
+    SET_STRING_ERROR_AND_RETURN("Secondary command buffers are not supported by the D3D12 backend", NULL);
+}
+
+static bool D3D12_EndSecondaryCommandBuffer(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    (void)commandBuffer;
+    return false;
+}
+
+static void D3D12_ExecuteSecondaryCommandBuffers(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUCommandBuffer *const *secondaryCommandBuffers,
+    Uint32 numSecondaryCommandBuffers)
+{
+    (void)commandBuffer;
+    (void)secondaryCommandBuffers;
+    (void)numSecondaryCommandBuffers;
+}
+
+static void *D3D12_AllocateTransientMemory(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 size,
+    SDL_GPUBufferBinding *binding)
+{
+    D3D12Renderer *renderer = ((D3D12CommandBuffer *)commandBuffer)->renderer;
+    (void)size;
+    (void)binding;
+    SET_STRING_ERROR_AND_RETURN("Transient memory is not supported by the D3D12 backend", NULL);
+}
+
 static void D3D12_INTERNAL_InitBlitResources(
     D3D12Renderer *renderer)
 {
@@ -8962,6 +9292,15 @@ static SDL_GPUDevice *D3D12_CreateDevice(bool debugMode, bool preferLowPower, SD
         return NULL;
     }
 
+    renderer->queryPoolsToDestroyCapacity = 4;
+    renderer->queryPoolsToDestroyCount = 0;
+    renderer->queryPoolsToDestroy = (D3D12QueryPool **)SDL_calloc(
+        renderer->queryPoolsToDestroyCapacity, sizeof(D3D12QueryPool *));
+    if (!renderer->queryPoolsToDestroy) {
+        D3D12_INTERNAL_DestroyRenderer(renderer);
+        return NULL;
+    }
+
     // Locks
     renderer->acquireCommandBufferLock = SDL_CreateMutex();
     renderer->acquireUniformBufferLock = SDL_CreateMutex();
@@ -1477,6 +1477,152 @@ static bool METAL_SupportsSampleCount(
     }
 }
 
+// Queries
+
+static SDL_GPUQueryPool *METAL_CreateQueryPool(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUQueryPoolCreateInfo *createinfo)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    (void)createinfo;
+    SET_STRING_ERROR_AND_RETURN("Timestamp queries are not supported by the Metal backend", NULL);
+}
+
+static void METAL_WriteTimestamp(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 queryIndex)
+{
+    // Query pools can't be created on Metal, so this is never called
+    (void)commandBuffer;
+    (void)queryPool;
+    (void)queryIndex;
+}
+
+static bool METAL_QueryPoolResultsAvailable(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    (void)driverData;
+    (void)queryPool;
+    return false;
+}
+
+static bool METAL_GetQueryPoolResults(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 numQueries,
+    Uint64 *results)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    (void)queryPool;
+    (void)firstQuery;
+    (void)numQueries;
+    (void)results;
+    SET_STRING_ERROR_AND_RETURN("Timestamp queries are not supported by the Metal backend", false);
+}
+
+static void METAL_ReleaseQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    (void)driverData;
+    (void)queryPool;
+}
+
+static void *METAL_GetPipelineCacheData(
+    SDL_GPURenderer *driverData,
+    size_t *size)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    (void)size;
+    SET_STRING_ERROR_AND_RETURN("Pipeline caches are not supported by the Metal backend", NULL);
+}
+
+static SDL_GPUMemoryHeapStats *METAL_GetMemoryStats(
+    SDL_GPURenderer *driverData,
+    int *count)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    (void)count;
+    SET_STRING_ERROR_AND_RETURN("Memory statistics are not supported by the Metal backend", NULL);
+}
+
+static Uint32 METAL_GetBindlessTextureCapacity(
+    SDL_GPURenderer *driverData)
+{
+    (void)driverData;
+    return 0;
+}
+
+static bool METAL_AddBindlessTexture(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUTextureSamplerBinding *binding,
+    Uint32 *index)
+{
+    MetalRenderer *renderer = (MetalRenderer *)driverData;
+    (void)binding;
+    (void)index;
+    SET_STRING_ERROR_AND_RETURN("Bindless textures are not supported by the Metal backend", false);
+}
+
+static void METAL_RemoveBindlessTexture(
+    SDL_GPURenderer *driverData,
+    Uint32 index)
+{
+    (void)driverData;
+    (void)index;
+}
+
+static bool METAL_BeginParallelRenderPass(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUColorTargetInfo *colorTargetInfos,
+    Uint32 numColorTargets,
+    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo)
+{
+    MetalRenderer *renderer = ((MetalCommandBuffer *)commandBuffer)->renderer;
+    (void)colorTargetInfos;
+    (void)numColorTargets;
+    (void)depthStencilTargetInfo;
+    SET_STRING_ERROR_AND_RETURN("Parallel render passes are not supported by the Metal backend", false);
+}
+
+static SDL_GPUCommandBuffer *METAL_AcquireSecondaryCommandBuffer(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    MetalRenderer *renderer = ((MetalCommandBuffer *)commandBuffer)->renderer;
+    SET_STRING_ERROR_AND_RETURN("Secondary command buffers are not supported by the Metal backend", NULL);
+}
+
+static bool METAL_EndSecondaryCommandBuffer(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    (void)commandBuffer;
+    return false;
+}
+
+static void METAL_ExecuteSecondaryCommandBuffers(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUCommandBuffer *const *secondaryCommandBuffers,
+    Uint32 numSecondaryCommandBuffers)
+{
+    (void)commandBuffer;
+    (void)secondaryCommandBuffers;
+    (void)numSecondaryCommandBuffers;
+}
+
+static void *METAL_AllocateTransientMemory(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 size,
+    SDL_GPUBufferBinding *binding)
+{
+    MetalRenderer *renderer = ((MetalCommandBuffer *)commandBuffer)->renderer;
+    (void)size;
+    (void)binding;
+    SET_STRING_ERROR_AND_RETURN("Transient memory is not supported by the Metal backend", NULL);
+}
+
 static SDL_GPUTexture *METAL_CreateTexture(
     SDL_GPURenderer *driverData,
     const SDL_GPUTextureCreateInfo *createinfo)
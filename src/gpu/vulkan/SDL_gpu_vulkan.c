@@ -62,6 +62,12 @@ typedef struct VulkanExtensions
     Uint8 KHR_portability_subset;
     // Only required for decoding HDR ASTC textures
     Uint8 EXT_texture_compression_astc_hdr;
+    // Core since 1.2, needed for the bindless texture array
+    Uint8 EXT_descriptor_indexing;
+    // Core since 1.1, required by EXT_descriptor_indexing
+    Uint8 KHR_maintenance3;
+    // EXT, lets the allocator stay within the driver's heap budgets
+    Uint8 EXT_memory_budget;
 } VulkanExtensions;
 
 // Defines
@@ -554,7 +560,8 @@ typedef enum VulkanBufferType
 {
     VULKAN_BUFFER_TYPE_GPU,
     VULKAN_BUFFER_TYPE_UNIFORM,
-    VULKAN_BUFFER_TYPE_TRANSFER
+    VULKAN_BUFFER_TYPE_TRANSFER,
+    VULKAN_BUFFER_TYPE_TRANSIENT
 } VulkanBufferType;
 
 struct VulkanBuffer
@@ -760,6 +767,13 @@ typedef struct VulkanUniformBuffer
     Uint32 writeOffset;
 } VulkanUniformBuffer;
 
+typedef struct VulkanTransientBuffer
+{
+    VulkanBufferContainer *container; // handed to the client for binding
+    Uint32 size;
+    Uint32 writeOffset;
+} VulkanTransientBuffer;
+
 typedef struct VulkanDescriptorInfo
 {
     VkDescriptorType descriptorType;
@@ -842,6 +856,7 @@ typedef struct VulkanGraphicsPipelineResourceLayout
      * 1: vertex uniform buffers
      * 2: fragment resources
      * 3: fragment uniform buffers
+     * 4: bindless textures, if enabled (owned by the renderer)
      */
     DescriptorSetLayout *descriptorSetLayouts[4];
 
@@ -888,6 +903,7 @@ typedef struct VulkanComputePipelineResourceLayout
      * 0: samplers, then read-only textures, then read-only buffers
      * 1: write-only textures, then write-only buffers
      * 2: uniform buffers
+     * 3: bindless textures, if enabled (owned by the renderer)
      */
     DescriptorSetLayout *descriptorSetLayouts[3];
 
@@ -907,6 +923,13 @@ typedef struct VulkanComputePipeline
     SDL_AtomicInt referenceCount;
 } VulkanComputePipeline;
 
+typedef struct VulkanQueryPool
+{
+    QueryPoolCommonHeader header;
+    VkQueryPool queryPool;
+    SDL_AtomicInt referenceCount;
+} VulkanQueryPool;
+
 typedef struct RenderPassColorTargetDescription
 {
     VkFormat format;
@@ -976,6 +999,7 @@ typedef struct VulkanCommandBuffer
 
     VkCommandBuffer commandBuffer;
     VulkanCommandPool *commandPool;
+    bool isSecondary;
 
     VulkanPresentData *presentDatas;
     Uint32 presentDataCount;
@@ -1001,6 +1025,13 @@ typedef struct VulkanCommandBuffer
 
     VulkanTextureSubresource *depthStencilAttachmentSubresource; // may be NULL
 
+    // Current render pass objects, inherited by secondary command buffers
+
+    VkRenderPass currentRenderPass;
+    VulkanFramebuffer *currentFramebuffer;
+    Uint32 currentFramebufferWidth;
+    Uint32 currentFramebufferHeight;
+
     // Dynamic state
 
     VkViewport currentViewport;
@@ -1058,6 +1089,10 @@ typedef struct VulkanCommandBuffer
     VulkanUniformBuffer *fragmentUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
     VulkanUniformBuffer *computeUniformBuffers[MAX_UNIFORM_BUFFERS_PER_STAGE];
 
+    // Transient memory
+
+    VulkanTransientBuffer *currentTransientBuffer;
+
     // Track used resources
 
     VulkanBuffer **usedBuffers;
@@ -1088,6 +1123,18 @@ typedef struct VulkanCommandBuffer
     Sint32 usedUniformBufferCount;
     Sint32 usedUniformBufferCapacity;
 
+    VulkanTransientBuffer **usedTransientBuffers;
+    Sint32 usedTransientBufferCount;
+    Sint32 usedTransientBufferCapacity;
+
+    VulkanQueryPool **usedQueryPools;
+    Sint32 usedQueryPoolCount;
+    Sint32 usedQueryPoolCapacity;
+
+    struct VulkanCommandBuffer **executedSecondaryCommandBuffers;
+    Sint32 executedSecondaryCommandBufferCount;
+    Sint32 executedSecondaryCommandBufferCapacity;
+
     VulkanFenceHandle *inFlightFence;
     bool autoReleaseFence;
 
@@ -1102,6 +1149,10 @@ struct VulkanCommandPool
     VulkanCommandBuffer **inactiveCommandBuffers;
     Uint32 inactiveCommandBufferCapacity;
     Uint32 inactiveCommandBufferCount;
+
+    VulkanCommandBuffer **inactiveSecondaryCommandBuffers;
+    Uint32 inactiveSecondaryCommandBufferCapacity;
+    Uint32 inactiveSecondaryCommandBufferCount;
 };
 
 // Context
@@ -1128,9 +1179,23 @@ struct VulkanRenderer
     bool supportsFillModeNonSolid;
     bool supportsMultiDrawIndirect;
 
+    /* Bindless texture array, only created if the app asks for it and
+     * EXT_descriptor_indexing supports update-after-bind sampled images.
+     */
+    Uint32 bindlessTextureCapacity;
+    VkDescriptorSetLayout bindlessDescriptorSetLayout;
+    VkDescriptorPool bindlessDescriptorPool;
+    VkDescriptorSet bindlessDescriptorSet;
+    Uint32 *bindlessFreeSlots;
+    Uint32 bindlessFreeSlotCount;
+    bool *bindlessSlotUsed;
+    SDL_Mutex *bindlessLock;
+
     VulkanMemoryAllocator *memoryAllocator;
     VkPhysicalDeviceMemoryProperties memoryProperties;
 
+    VkPipelineCache pipelineCache;
+
     WindowData **claimedWindows;
     Uint32 claimedWindowCount;
     Uint32 claimedWindowCapacity;
@@ -1155,6 +1220,10 @@ struct VulkanRenderer
     Uint32 uniformBufferPoolCount;
     Uint32 uniformBufferPoolCapacity;
 
+    VulkanTransientBuffer **transientBufferPool;
+    Uint32 transientBufferPoolCount;
+    Uint32 transientBufferPoolCapacity;
+
     DescriptorSetCache **descriptorSetCachePool;
     Uint32 descriptorSetCachePoolCount;
     Uint32 descriptorSetCachePoolCapacity;
@@ -1193,15 +1262,21 @@ struct VulkanRenderer
     Uint32 framebuffersToDestroyCount;
     Uint32 framebuffersToDestroyCapacity;
 
+    VulkanQueryPool **queryPoolsToDestroy;
+    Uint32 queryPoolsToDestroyCount;
+    Uint32 queryPoolsToDestroyCapacity;
+
     SDL_Mutex *allocatorLock;
     SDL_Mutex *disposeLock;
     SDL_Mutex *submitLock;
     SDL_Mutex *acquireCommandBufferLock;
     SDL_Mutex *acquireUniformBufferLock;
+    SDL_Mutex *acquireTransientBufferLock;
     SDL_Mutex *framebufferFetchLock;
     SDL_Mutex *windowLock;
 
     Uint8 defragInProgress;
+    Uint64 defragBudgetNS; // 0 means one allocation per frame
 
     VulkanMemoryAllocation **allocationsToDefrag;
     Uint32 allocationsToDefragCount;
@@ -1915,6 +1990,74 @@ static Uint8 VULKAN_INTERNAL_BindImageMemory(
     return 1;
 }
 
+static bool VULKAN_INTERNAL_GetHeapBudget(
+    VulkanRenderer *renderer,
+    Uint32 heapIndex,
+    VkDeviceSize *budget,
+    VkDeviceSize *usage)
+{
+    VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties;
+    VkPhysicalDeviceMemoryProperties2KHR memoryProperties;
+
+    if (!renderer->supports.EXT_memory_budget) {
+        return false;
+    }
+
+    SDL_zero(budgetProperties);
+    budgetProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+
+    SDL_zero(memoryProperties);
+    memoryProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+    memoryProperties.pNext = &budgetProperties;
+
+    renderer->vkGetPhysicalDeviceMemoryProperties2KHR(
+        renderer->physicalDevice,
+        &memoryProperties);
+
+    *budget = budgetProperties.heapBudget[heapIndex];
+    *usage = budgetProperties.heapUsage[heapIndex];
+    return true;
+}
+
+// Returns true if allocating the given size from the heap would exceed its budget
+static bool VULKAN_INTERNAL_IsOverHeapBudget(
+    VulkanRenderer *renderer,
+    Uint32 heapIndex,
+    VkDeviceSize size)
+{
+    VkDeviceSize budget, usage;
+
+    if (!VULKAN_INTERNAL_GetHeapBudget(renderer, heapIndex, &budget, &usage)) {
+        return false;
+    }
+    return budget != 0 && usage + size > budget;
+}
+
+// Gives unused blocks in the heap back to the driver. The allocator lock must be held.
+static void VULKAN_INTERNAL_EvictEmptyAllocations(
+    VulkanRenderer *renderer,
+    Uint32 heapIndex)
+{
+    VulkanMemorySubAllocator *allocator;
+
+    for (Uint32 i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1) {
+        if (renderer->memoryProperties.memoryTypes[i].heapIndex != heapIndex) {
+            continue;
+        }
+
+        allocator = &renderer->memoryAllocator->subAllocators[i];
+
+        for (Sint32 j = allocator->allocationCount - 1; j >= 0; j -= 1) {
+            if (allocator->allocations[j]->usedRegionCount == 0) {
+                VULKAN_INTERNAL_DeallocateMemory(
+                    renderer,
+                    allocator,
+                    j);
+            }
+        }
+    }
+}
+
 static Uint8 VULKAN_INTERNAL_BindResourceMemory(
     VulkanRenderer *renderer,
     Uint32 memoryTypeIndex,
@@ -1923,6 +2066,7 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
     bool dedicated,            // the entire memory allocation should be used for this resource
     VkBuffer buffer,           // may be VK_NULL_HANDLE
     VkImage image,             // may be VK_NULL_HANDLE
+    bool allowOverBudget,      // if false, new blocks that exceed the heap budget fail
     VulkanMemoryUsedRegion **pMemoryUsedRegion)
 {
     VulkanMemoryAllocation *allocation;
@@ -2062,6 +2206,25 @@ static Uint8 VULKAN_INTERNAL_BindResourceMemory(
         }
     }
 
+    if (VULKAN_INTERNAL_IsOverHeapBudget(renderer, renderer->memoryProperties.memoryTypes[memoryTypeIndex].heapIndex, allocationSize)) {
+        Uint32 heapIndex = renderer->memoryProperties.memoryTypes[memoryTypeIndex].heapIndex;
+
+        // Make room by returning empty blocks, then by not rounding up large blocks
+        VULKAN_INTERNAL_EvictEmptyAllocations(renderer, heapIndex);
+
+        if (requiredSize > SMALL_ALLOCATION_THRESHOLD &&
+            VULKAN_INTERNAL_IsOverHeapBudget(renderer, heapIndex, allocationSize)) {
+            allocationSize = requiredSize;
+        }
+
+        if (!allowOverBudget && VULKAN_INTERNAL_IsOverHeapBudget(renderer, heapIndex, allocationSize)) {
+            SDL_UnlockMutex(renderer->allocatorLock);
+
+            // The caller will try a different memory type
+            return 2;
+        }
+    }
+
     allocationResult = VULKAN_INTERNAL_AllocateMemory(
         renderer,
         buffer,
@@ -2167,19 +2330,27 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForImage(
         &memoryRequirements,
         &memoryTypeCount);
 
-    for (i = 0; i < memoryTypeCount; i += 1) {
-        bindResult = VULKAN_INTERNAL_BindResourceMemory(
-            renderer,
-            memoryTypesToTry[i],
-            &memoryRequirements,
-            memoryRequirements.size,
-            false,
-            VK_NULL_HANDLE,
-            image,
-            usedRegion);
+    // Stay within the heap budgets if any memory type allows it, otherwise let the driver page
+    for (Uint32 pass = 0; pass < 2 && bindResult != 1; pass += 1) {
+        for (i = 0; i < memoryTypeCount; i += 1) {
+            bindResult = VULKAN_INTERNAL_BindResourceMemory(
+                renderer,
+                memoryTypesToTry[i],
+                &memoryRequirements,
+                memoryRequirements.size,
+                false,
+                VK_NULL_HANDLE,
+                image,
+                pass == 1,
+                usedRegion);
+
+            if (bindResult == 1) {
+                selectedMemoryTypeIndex = memoryTypesToTry[i];
+                break;
+            }
+        }
 
-        if (bindResult == 1) {
-            selectedMemoryTypeIndex = memoryTypesToTry[i];
+        if (!renderer->supports.EXT_memory_budget) {
             break;
         }
     }
@@ -2268,6 +2439,10 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForBuffer(
      * that is both device-local and host-visible
      * is often constrained, particularly on low-end devices.
      *
+     * Transient buffers are written by the client every frame and
+     * read directly by the GPU, so they get the same treatment as
+     * uniform buffers.
+     *
      * Transfer buffers must be host-visible and coherent because
      * the client uses them to stage data to be transferred
      * to device-local memory, or to read back data transferred
@@ -2281,7 +2456,7 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForBuffer(
     if (type == VULKAN_BUFFER_TYPE_GPU) {
         preferredMemoryPropertyFlags |=
             VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-    } else if (type == VULKAN_BUFFER_TYPE_UNIFORM) {
+    } else if (type == VULKAN_BUFFER_TYPE_UNIFORM || type == VULKAN_BUFFER_TYPE_TRANSIENT) {
         requiredMemoryPropertyFlags |=
             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
             VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
@@ -2312,19 +2487,27 @@ static Uint8 VULKAN_INTERNAL_BindMemoryForBuffer(
         &memoryRequirements,
         &memoryTypeCount);
 
-    for (i = 0; i < memoryTypeCount; i += 1) {
-        bindResult = VULKAN_INTERNAL_BindResourceMemory(
-            renderer,
-            memoryTypesToTry[i],
-            &memoryRequirements,
-            size,
-            dedicated,
-            buffer,
-            VK_NULL_HANDLE,
-            usedRegion);
+    // Stay within the heap budgets if any memory type allows it, otherwise let the driver page
+    for (Uint32 pass = 0; pass < 2 && bindResult != 1; pass += 1) {
+        for (i = 0; i < memoryTypeCount; i += 1) {
+            bindResult = VULKAN_INTERNAL_BindResourceMemory(
+                renderer,
+                memoryTypesToTry[i],
+                &memoryRequirements,
+                size,
+                dedicated,
+                buffer,
+                VK_NULL_HANDLE,
+                pass == 1,
+                usedRegion);
+
+            if (bindResult == 1) {
+                selectedMemoryTypeIndex = memoryTypesToTry[i];
+                break;
+            }
+        }
 
-        if (bindResult == 1) {
-            selectedMemoryTypeIndex = memoryTypesToTry[i];
+        if (!renderer->supports.EXT_memory_budget) {
             break;
         }
     }
@@ -2457,6 +2640,18 @@ static void VULKAN_INTERNAL_TrackComputePipeline(
         usedComputePipelineCapacity)
 }
 
+static void VULKAN_INTERNAL_TrackQueryPool(
+    VulkanCommandBuffer *commandBuffer,
+    VulkanQueryPool *queryPool)
+{
+    TRACK_RESOURCE(
+        queryPool,
+        VulkanQueryPool *,
+        usedQueryPools,
+        usedQueryPoolCount,
+        usedQueryPoolCapacity)
+}
+
 static void VULKAN_INTERNAL_TrackFramebuffer(
     VulkanRenderer *renderer,
     VulkanCommandBuffer *commandBuffer,
@@ -2494,6 +2689,24 @@ static void VULKAN_INTERNAL_TrackUniformBuffer(
         uniformBuffer->buffer);
 }
 
+static void VULKAN_INTERNAL_TrackTransientBuffer(
+    VulkanCommandBuffer *commandBuffer,
+    VulkanTransientBuffer *transientBuffer)
+{
+    if (commandBuffer->usedTransientBufferCount == commandBuffer->usedTransientBufferCapacity) {
+        commandBuffer->usedTransientBufferCapacity += 1;
+        commandBuffer->usedTransientBuffers = SDL_realloc(
+            commandBuffer->usedTransientBuffers,
+            commandBuffer->usedTransientBufferCapacity * sizeof(VulkanTransientBuffer *));
+    }
+    commandBuffer->usedTransientBuffers[commandBuffer->usedTransientBufferCount] = transientBuffer;
+    commandBuffer->usedTransientBufferCount += 1;
+
+    VULKAN_INTERNAL_TrackBuffer(
+        commandBuffer,
+        transientBuffer->container->activeBuffer);
+}
+
 #undef TRACK_RESOURCE
 
 // Memory Barriers
@@ -3051,12 +3264,43 @@ static void VULKAN_INTERNAL_DestroyBuffer(
     SDL_free(buffer);
 }
 
+static void VULKAN_INTERNAL_DestroyTransientBuffer(
+    VulkanRenderer *renderer,
+    VulkanTransientBuffer *transientBuffer)
+{
+    VULKAN_INTERNAL_DestroyBuffer(
+        renderer,
+        transientBuffer->container->activeBuffer);
+    SDL_free(transientBuffer->container->buffers);
+    SDL_free(transientBuffer->container);
+    SDL_free(transientBuffer);
+}
+
+static void VULKAN_INTERNAL_FreeCommandBuffer(
+    VulkanCommandBuffer *commandBuffer)
+{
+    SDL_free(commandBuffer->presentDatas);
+    SDL_free(commandBuffer->waitSemaphores);
+    SDL_free(commandBuffer->signalSemaphores);
+    SDL_free(commandBuffer->usedBuffers);
+    SDL_free(commandBuffer->usedTextures);
+    SDL_free(commandBuffer->usedSamplers);
+    SDL_free(commandBuffer->usedGraphicsPipelines);
+    SDL_free(commandBuffer->usedComputePipelines);
+    SDL_free(commandBuffer->usedFramebuffers);
+    SDL_free(commandBuffer->usedUniformBuffers);
+    SDL_free(commandBuffer->usedTransientBuffers);
+    SDL_free(commandBuffer->usedQueryPools);
+    SDL_free(commandBuffer->executedSecondaryCommandBuffers);
+
+    SDL_free(commandBuffer);
+}
+
 static void VULKAN_INTERNAL_DestroyCommandPool(
     VulkanRenderer *renderer,
     VulkanCommandPool *commandPool)
 {
     Uint32 i;
-    VulkanCommandBuffer *commandBuffer;
 
     renderer->vkDestroyCommandPool(
         renderer->logicalDevice,
@@ -3064,23 +3308,15 @@ static void VULKAN_INTERNAL_DestroyCommandPool(
         NULL);
 
     for (i = 0; i < commandPool->inactiveCommandBufferCount; i += 1) {
-        commandBuffer = commandPool->inactiveCommandBuffers[i];
-
-        SDL_free(commandBuffer->presentDatas);
-        SDL_free(commandBuffer->waitSemaphores);
-        SDL_free(commandBuffer->signalSemaphores);
-        SDL_free(commandBuffer->usedBuffers);
-        SDL_free(commandBuffer->usedTextures);
-        SDL_free(commandBuffer->usedSamplers);
-        SDL_free(commandBuffer->usedGraphicsPipelines);
-        SDL_free(commandBuffer->usedComputePipelines);
-        SDL_free(commandBuffer->usedFramebuffers);
-        SDL_free(commandBuffer->usedUniformBuffers);
+        VULKAN_INTERNAL_FreeCommandBuffer(commandPool->inactiveCommandBuffers[i]);
+    }
 
-        SDL_free(commandBuffer);
+    for (i = 0; i < commandPool->inactiveSecondaryCommandBufferCount; i += 1) {
+        VULKAN_INTERNAL_FreeCommandBuffer(commandPool->inactiveSecondaryCommandBuffers[i]);
     }
 
     SDL_free(commandPool->inactiveCommandBuffers);
+    SDL_free(commandPool->inactiveSecondaryCommandBuffers);
     SDL_free(commandPool);
 }
 
@@ -3138,6 +3374,18 @@ static void VULKAN_INTERNAL_DestroyComputePipeline(
     SDL_free(computePipeline);
 }
 
+static void VULKAN_INTERNAL_DestroyQueryPool(
+    VulkanRenderer *renderer,
+    VulkanQueryPool *queryPool)
+{
+    renderer->vkDestroyQueryPool(
+        renderer->logicalDevice,
+        queryPool->queryPool,
+        NULL);
+
+    SDL_free(queryPool);
+}
+
 static void VULKAN_INTERNAL_DestroyShader(
     VulkanRenderer *renderer,
     VulkanShader *vulkanShader)
@@ -3611,6 +3859,119 @@ static bool VULKAN_INTERNAL_AllocateDescriptorSets(
     return true;
 }
 
+static bool VULKAN_INTERNAL_CreateBindlessDescriptorSet(
+    VulkanRenderer *renderer)
+{
+    VkDescriptorSetLayoutBinding layoutBinding;
+    VkDescriptorBindingFlagsEXT bindingFlags;
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo;
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo;
+    VkDescriptorPoolSize poolSize;
+    VkDescriptorPoolCreateInfo poolCreateInfo;
+    VkResult vulkanResult;
+
+    layoutBinding.binding = 0;
+    layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    layoutBinding.descriptorCount = renderer->bindlessTextureCapacity;
+    layoutBinding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS | VK_SHADER_STAGE_COMPUTE_BIT;
+    layoutBinding.pImmutableSamplers = NULL;
+
+    // Slots that were never filled or have been removed are simply left stale
+    bindingFlags =
+        VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT;
+
+    bindingFlagsCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    bindingFlagsCreateInfo.pNext = NULL;
+    bindingFlagsCreateInfo.bindingCount = 1;
+    bindingFlagsCreateInfo.pBindingFlags = &bindingFlags;
+
+    layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+    layoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    layoutCreateInfo.bindingCount = 1;
+    layoutCreateInfo.pBindings = &layoutBinding;
+
+    vulkanResult = renderer->vkCreateDescriptorSetLayout(
+        renderer->logicalDevice,
+        &layoutCreateInfo,
+        NULL,
+        &renderer->bindlessDescriptorSetLayout);
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkCreateDescriptorSetLayout, false);
+
+    poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    poolSize.descriptorCount = renderer->bindlessTextureCapacity;
+
+    poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    poolCreateInfo.pNext = NULL;
+    poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    poolCreateInfo.maxSets = 1;
+    poolCreateInfo.poolSizeCount = 1;
+    poolCreateInfo.pPoolSizes = &poolSize;
+
+    vulkanResult = renderer->vkCreateDescriptorPool(
+        renderer->logicalDevice,
+        &poolCreateInfo,
+        NULL,
+        &renderer->bindlessDescriptorPool);
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkCreateDescriptorPool, false);
+
+    if (!VULKAN_INTERNAL_AllocateDescriptorSets(
+            renderer,
+            renderer->bindlessDescriptorPool,
+            renderer->bindlessDescriptorSetLayout,
+            1,
+            &renderer->bindlessDescriptorSet)) {
+        return false;
+    }
+
+    // Hand out the low slots first
+    renderer->bindlessFreeSlots = SDL_malloc(
+        renderer->bindlessTextureCapacity * sizeof(Uint32));
+    if (renderer->bindlessFreeSlots == NULL) {
+        return false;
+    }
+    renderer->bindlessSlotUsed = SDL_calloc(
+        renderer->bindlessTextureCapacity, sizeof(bool));
+    if (renderer->bindlessSlotUsed == NULL) {
+        return false;
+    }
+    for (Uint32 i = 0; i < renderer->bindlessTextureCapacity; i += 1) {
+        renderer->bindlessFreeSlots[i] = renderer->bindlessTextureCapacity - 1 - i;
+    }
+    renderer->bindlessFreeSlotCount = renderer->bindlessTextureCapacity;
+
+    return true;
+}
+
+static void VULKAN_INTERNAL_DestroyBindlessDescriptorSet(
+    VulkanRenderer *renderer)
+{
+    if (renderer->bindlessDescriptorPool != VK_NULL_HANDLE) {
+        renderer->vkDestroyDescriptorPool(
+            renderer->logicalDevice,
+            renderer->bindlessDescriptorPool,
+            NULL);
+        renderer->bindlessDescriptorPool = VK_NULL_HANDLE;
+    }
+
+    if (renderer->bindlessDescriptorSetLayout != VK_NULL_HANDLE) {
+        renderer->vkDestroyDescriptorSetLayout(
+            renderer->logicalDevice,
+            renderer->bindlessDescriptorSetLayout,
+            NULL);
+        renderer->bindlessDescriptorSetLayout = VK_NULL_HANDLE;
+    }
+
+    SDL_free(renderer->bindlessFreeSlots);
+    renderer->bindlessFreeSlots = NULL;
+    SDL_free(renderer->bindlessSlotUsed);
+    renderer->bindlessSlotUsed = NULL;
+    renderer->bindlessFreeSlotCount = 0;
+    renderer->bindlessDescriptorSet = VK_NULL_HANDLE;
+    renderer->bindlessTextureCapacity = 0;
+}
+
 static bool VULKAN_INTERNAL_AllocateDescriptorsFromPool(
     VulkanRenderer *renderer,
     DescriptorSetLayout *descriptorSetLayout,
@@ -3868,7 +4229,7 @@ static VulkanGraphicsPipelineResourceLayout *VULKAN_INTERNAL_FetchGraphicsPipeli
     }
 
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
-    VkDescriptorSetLayout descriptorSetLayouts[4];
+    VkDescriptorSetLayout descriptorSetLayouts[5];
     VkResult vulkanResult;
 
     pipelineResourceLayout = SDL_calloc(1, sizeof(VulkanGraphicsPipelineResourceLayout));
@@ -3917,6 +4278,7 @@ static VulkanGraphicsPipelineResourceLayout *VULKAN_INTERNAL_FetchGraphicsPipeli
     descriptorSetLayouts[1] = pipelineResourceLayout->descriptorSetLayouts[1]->descriptorSetLayout;
     descriptorSetLayouts[2] = pipelineResourceLayout->descriptorSetLayouts[2]->descriptorSetLayout;
     descriptorSetLayouts[3] = pipelineResourceLayout->descriptorSetLayouts[3]->descriptorSetLayout;
+    descriptorSetLayouts[4] = renderer->bindlessDescriptorSetLayout;
 
     pipelineResourceLayout->vertexSamplerCount = vertexShader->numSamplers;
     pipelineResourceLayout->vertexStorageTextureCount = vertexShader->numStorageTextures;
@@ -3933,7 +4295,7 @@ static VulkanGraphicsPipelineResourceLayout *VULKAN_INTERNAL_FetchGraphicsPipeli
     pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutCreateInfo.pNext = NULL;
     pipelineLayoutCreateInfo.flags = 0;
-    pipelineLayoutCreateInfo.setLayoutCount = 4;
+    pipelineLayoutCreateInfo.setLayoutCount = renderer->bindlessDescriptorSet != VK_NULL_HANDLE ? 5 : 4;
     pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts;
     pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
     pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
@@ -3982,7 +4344,7 @@ static VulkanComputePipelineResourceLayout *VULKAN_INTERNAL_FetchComputePipeline
         return pipelineResourceLayout;
     }
 
-    VkDescriptorSetLayout descriptorSetLayouts[3];
+    VkDescriptorSetLayout descriptorSetLayouts[4];
     VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo;
     VkResult vulkanResult;
 
@@ -4021,6 +4383,7 @@ static VulkanComputePipelineResourceLayout *VULKAN_INTERNAL_FetchComputePipeline
     descriptorSetLayouts[0] = pipelineResourceLayout->descriptorSetLayouts[0]->descriptorSetLayout;
     descriptorSetLayouts[1] = pipelineResourceLayout->descriptorSetLayouts[1]->descriptorSetLayout;
     descriptorSetLayouts[2] = pipelineResourceLayout->descriptorSetLayouts[2]->descriptorSetLayout;
+    descriptorSetLayouts[3] = renderer->bindlessDescriptorSetLayout;
 
     pipelineResourceLayout->numSamplers = createinfo->num_samplers;
     pipelineResourceLayout->numReadonlyStorageTextures = createinfo->num_readonly_storage_textures;
@@ -4034,7 +4397,7 @@ static VulkanComputePipelineResourceLayout *VULKAN_INTERNAL_FetchComputePipeline
     pipelineLayoutCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutCreateInfo.pNext = NULL;
     pipelineLayoutCreateInfo.flags = 0;
-    pipelineLayoutCreateInfo.setLayoutCount = 3;
+    pipelineLayoutCreateInfo.setLayoutCount = renderer->bindlessDescriptorSet != VK_NULL_HANDLE ? 4 : 3;
     pipelineLayoutCreateInfo.pSetLayouts = descriptorSetLayouts;
     pipelineLayoutCreateInfo.pushConstantRangeCount = 0;
     pipelineLayoutCreateInfo.pPushConstantRanges = NULL;
@@ -4858,6 +5221,13 @@ static void VULKAN_DestroyDevice(
     }
     SDL_free(renderer->uniformBufferPool);
 
+    for (Uint32 i = 0; i < renderer->transientBufferPoolCount; i += 1) {
+        VULKAN_INTERNAL_DestroyTransientBuffer(
+            renderer,
+            renderer->transientBufferPool[i]);
+    }
+    SDL_free(renderer->transientBufferPool);
+
     for (Uint32 i = 0; i < renderer->descriptorSetCachePoolCount; i += 1) {
         VULKAN_INTERNAL_DestroyDescriptorSetCache(
             renderer,
@@ -4916,6 +5286,7 @@ static void VULKAN_DestroyDevice(
     SDL_free(renderer->shadersToDestroy);
     SDL_free(renderer->samplersToDestroy);
     SDL_free(renderer->framebuffersToDestroy);
+    SDL_free(renderer->queryPoolsToDestroy);
     SDL_free(renderer->allocationsToDefrag);
 
     SDL_DestroyMutex(renderer->allocatorLock);
@@ -4923,9 +5294,20 @@ static void VULKAN_DestroyDevice(
     SDL_DestroyMutex(renderer->submitLock);
     SDL_DestroyMutex(renderer->acquireCommandBufferLock);
     SDL_DestroyMutex(renderer->acquireUniformBufferLock);
+    SDL_DestroyMutex(renderer->acquireTransientBufferLock);
     SDL_DestroyMutex(renderer->framebufferFetchLock);
     SDL_DestroyMutex(renderer->windowLock);
 
+    if (renderer->pipelineCache != VK_NULL_HANDLE) {
+        renderer->vkDestroyPipelineCache(
+            renderer->logicalDevice,
+            renderer->pipelineCache,
+            NULL);
+    }
+
+    VULKAN_INTERNAL_DestroyBindlessDescriptorSet(renderer);
+    SDL_DestroyMutex(renderer->bindlessLock);
+
     renderer->vkDestroyDevice(renderer->logicalDevice, NULL);
     renderer->vkDestroyInstance(renderer->instance, NULL);
 
@@ -5283,18 +5665,20 @@ static void VULKAN_INTERNAL_BindGraphicsDescriptorSets(
         0,
         NULL);
 
-    VkDescriptorSet sets[4];
+    // The bindless set never changes, but rebinding the others with a new layout can disturb it
+    VkDescriptorSet sets[5];
     sets[0] = commandBuffer->vertexResourceDescriptorSet;
     sets[1] = commandBuffer->vertexUniformDescriptorSet;
     sets[2] = commandBuffer->fragmentResourceDescriptorSet;
     sets[3] = commandBuffer->fragmentUniformDescriptorSet;
+    sets[4] = renderer->bindlessDescriptorSet;
 
     renderer->vkCmdBindDescriptorSets(
         commandBuffer->commandBuffer,
         VK_PIPELINE_BIND_POINT_GRAPHICS,
         resourceLayout->pipelineLayout,
         0,
-        4,
+        renderer->bindlessDescriptorSet != VK_NULL_HANDLE ? 5 : 4,
         sets,
         dynamicOffsetCount,
         dynamicOffsets);
@@ -6478,10 +6862,9 @@ static SDL_GPUGraphicsPipeline *VULKAN_CreateGraphicsPipeline(
     vkPipelineCreateInfo.basePipelineHandle = VK_NULL_HANDLE;
     vkPipelineCreateInfo.basePipelineIndex = 0;
 
-    // TODO: enable pipeline caching
     vulkanResult = renderer->vkCreateGraphicsPipelines(
         renderer->logicalDevice,
-        VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkPipelineCreateInfo,
         NULL,
@@ -6584,7 +6967,7 @@ static SDL_GPUComputePipeline *VULKAN_CreateComputePipeline(
 
     vulkanResult = renderer->vkCreateComputePipelines(
         renderer->logicalDevice,
-        (VkPipelineCache)VK_NULL_HANDLE,
+        renderer->pipelineCache,
         1,
         &vkShaderCreateInfo,
         NULL,
@@ -6816,6 +7199,40 @@ static VulkanUniformBuffer *VULKAN_INTERNAL_CreateUniformBuffer(
     return uniformBuffer;
 }
 
+static VulkanTransientBuffer *VULKAN_INTERNAL_CreateTransientBuffer(
+    VulkanRenderer *renderer,
+    Uint32 size)
+{
+    VulkanTransientBuffer *transientBuffer;
+    VulkanBufferContainer *container;
+
+    /* Dedicated, so that defrag never moves memory the client is writing to.
+     * Storage usage is included so the buffer can also be read by shaders.
+     */
+    container = VULKAN_INTERNAL_CreateBufferContainer(
+        renderer,
+        (VkDeviceSize)size,
+        SDL_GPU_BUFFERUSAGE_VERTEX |
+            SDL_GPU_BUFFERUSAGE_INDEX |
+            SDL_GPU_BUFFERUSAGE_INDIRECT |
+            SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ |
+            SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ,
+        VULKAN_BUFFER_TYPE_TRANSIENT,
+        true,
+        NULL);
+
+    if (container == NULL) {
+        return NULL;
+    }
+
+    transientBuffer = SDL_malloc(sizeof(VulkanTransientBuffer));
+    transientBuffer->container = container;
+    transientBuffer->size = size;
+    transientBuffer->writeOffset = 0;
+
+    return transientBuffer;
+}
+
 static SDL_GPUTransferBuffer *VULKAN_CreateTransferBuffer(
     SDL_GPURenderer *driverData,
     SDL_GPUTransferBufferUsage usage,
@@ -7572,6 +7989,109 @@ static void VULKAN_INTERNAL_ReturnUniformBufferToPool(
     uniformBuffer->drawOffset = 0;
 }
 
+static VulkanTransientBuffer *VULKAN_INTERNAL_AcquireTransientBufferFromPool(
+    VulkanCommandBuffer *commandBuffer,
+    Uint32 size)
+{
+    VulkanRenderer *renderer = commandBuffer->renderer;
+    VulkanTransientBuffer *transientBuffer = NULL;
+
+    SDL_LockMutex(renderer->acquireTransientBufferLock);
+
+    if (size <= TRANSIENT_BUFFER_SIZE) {
+        if (renderer->transientBufferPoolCount > 0) {
+            transientBuffer = renderer->transientBufferPool[renderer->transientBufferPoolCount - 1];
+            renderer->transientBufferPoolCount -= 1;
+        } else {
+            transientBuffer = VULKAN_INTERNAL_CreateTransientBuffer(
+                renderer,
+                TRANSIENT_BUFFER_SIZE);
+        }
+    } else {
+        // Oversized requests get a one-off buffer that is released instead of pooled
+        transientBuffer = VULKAN_INTERNAL_CreateTransientBuffer(
+            renderer,
+            size);
+    }
+
+    SDL_UnlockMutex(renderer->acquireTransientBufferLock);
+
+    if (transientBuffer == NULL) {
+        return NULL;
+    }
+
+    VULKAN_INTERNAL_TrackTransientBuffer(commandBuffer, transientBuffer);
+
+    return transientBuffer;
+}
+
+static void VULKAN_INTERNAL_ReturnTransientBufferToPool(
+    VulkanRenderer *renderer,
+    VulkanTransientBuffer *transientBuffer)
+{
+    if (transientBuffer->size != TRANSIENT_BUFFER_SIZE) {
+        VULKAN_INTERNAL_ReleaseBufferContainer(
+            renderer,
+            transientBuffer->container);
+        SDL_free(transientBuffer);
+        return;
+    }
+
+    if (renderer->transientBufferPoolCount >= renderer->transientBufferPoolCapacity) {
+        renderer->transientBufferPoolCapacity *= 2;
+        renderer->transientBufferPool = SDL_realloc(
+            renderer->transientBufferPool,
+            renderer->transientBufferPoolCapacity * sizeof(VulkanTransientBuffer *));
+    }
+
+    renderer->transientBufferPool[renderer->transientBufferPoolCount] = transientBuffer;
+    renderer->transientBufferPoolCount += 1;
+
+    transientBuffer->writeOffset = 0;
+}
+
+static void *VULKAN_AllocateTransientMemory(
+    SDL_GPUCommandBuffer *commandBuffer,
+    Uint32 size,
+    SDL_GPUBufferBinding *binding)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanTransientBuffer *transientBuffer = vulkanCommandBuffer->currentTransientBuffer;
+    VulkanBuffer *buffer;
+    Uint32 offset = 0;
+
+    if (transientBuffer != NULL) {
+        offset = VULKAN_INTERNAL_NextHighestAlignment32(
+            transientBuffer->writeOffset,
+            TRANSIENT_BUFFER_ALIGNMENT);
+    }
+
+    // If there is no more room, bump into a new transient buffer
+    if (transientBuffer == NULL || size > transientBuffer->size || offset > transientBuffer->size - size) {
+        transientBuffer = VULKAN_INTERNAL_AcquireTransientBufferFromPool(
+            vulkanCommandBuffer,
+            size);
+
+        if (transientBuffer == NULL) {
+            return NULL;
+        }
+
+        vulkanCommandBuffer->currentTransientBuffer = transientBuffer;
+        offset = 0;
+    }
+
+    transientBuffer->writeOffset = offset + size;
+
+    binding->buffer = (SDL_GPUBuffer *)transientBuffer->container;
+    binding->offset = offset;
+
+    buffer = transientBuffer->container->activeBuffer;
+
+    return buffer->usedRegion->allocation->mapPointer +
+           buffer->usedRegion->resourceOffset +
+           offset;
+}
+
 static void VULKAN_INTERNAL_PushUniformData(
     VulkanCommandBuffer *commandBuffer,
     VulkanUniformBufferStage uniformBufferStage,
@@ -7657,11 +8177,12 @@ static void VULKAN_INTERNAL_PushUniformData(
     }
 }
 
-static void VULKAN_BeginRenderPass(
+static bool VULKAN_INTERNAL_BeginRenderPass(
     SDL_GPUCommandBuffer *commandBuffer,
     const SDL_GPUColorTargetInfo *colorTargetInfos,
     Uint32 numColorTargets,
-    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo)
+    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo,
+    VkSubpassContents subpassContents)
 {
     VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
     VulkanRenderer *renderer = (VulkanRenderer *)vulkanCommandBuffer->renderer;
@@ -7673,9 +8194,6 @@ static void VULKAN_BeginRenderPass(
     Uint32 clearCount = 0;
     Uint32 totalColorAttachmentCount = 0;
     Uint32 i;
-    SDL_GPUViewport defaultViewport;
-    SDL_Rect defaultScissor;
-    SDL_FColor defaultBlendConstants;
     Uint32 framebufferWidth = SDL_MAX_UINT32;
     Uint32 framebufferHeight = SDL_MAX_UINT32;
 
@@ -7775,7 +8293,7 @@ static void VULKAN_BeginRenderPass(
         depthStencilTargetInfo);
 
     if (renderPass == VK_NULL_HANDLE) {
-        return;
+        return false;
     }
 
     framebuffer = VULKAN_INTERNAL_FetchFramebuffer(
@@ -7788,7 +8306,7 @@ static void VULKAN_BeginRenderPass(
         framebufferHeight);
 
     if (framebuffer == NULL) {
-        return;
+        return false;
     }
 
     VULKAN_INTERNAL_TrackFramebuffer(renderer, vulkanCommandBuffer, framebuffer);
@@ -7831,18 +8349,33 @@ static void VULKAN_BeginRenderPass(
     renderer->vkCmdBeginRenderPass(
         vulkanCommandBuffer->commandBuffer,
         &renderPassBeginInfo,
-        VK_SUBPASS_CONTENTS_INLINE);
+        subpassContents);
 
     SDL_stack_free(clearValues);
 
-    // Set sensible default states
-
-    defaultViewport.x = 0;
-    defaultViewport.y = 0;
-    defaultViewport.w = (float)framebufferWidth;
-    defaultViewport.h = (float)framebufferHeight;
-    defaultViewport.min_depth = 0;
-    defaultViewport.max_depth = 1;
+    vulkanCommandBuffer->currentRenderPass = renderPass;
+    vulkanCommandBuffer->currentFramebuffer = framebuffer;
+    vulkanCommandBuffer->currentFramebufferWidth = framebufferWidth;
+    vulkanCommandBuffer->currentFramebufferHeight = framebufferHeight;
+
+    return true;
+}
+
+static void VULKAN_INTERNAL_SetDefaultRenderPassState(
+    VulkanCommandBuffer *vulkanCommandBuffer,
+    Uint32 framebufferWidth,
+    Uint32 framebufferHeight)
+{
+    SDL_GPUViewport defaultViewport;
+    SDL_Rect defaultScissor;
+    SDL_FColor defaultBlendConstants;
+
+    defaultViewport.x = 0;
+    defaultViewport.y = 0;
+    defaultViewport.w = (float)framebufferWidth;
+    defaultViewport.h = (float)framebufferHeight;
+    defaultViewport.min_depth = 0;
+    defaultViewport.max_depth = 1;
 
     VULKAN_INTERNAL_SetCurrentViewport(
         vulkanCommandBuffer,
@@ -7871,6 +8404,48 @@ static void VULKAN_BeginRenderPass(
         0);
 }
 
+static void VULKAN_BeginRenderPass(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUColorTargetInfo *colorTargetInfos,
+    Uint32 numColorTargets,
+    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+
+    if (!VULKAN_INTERNAL_BeginRenderPass(
+            commandBuffer,
+            colorTargetInfos,
+            numColorTargets,
+            depthStencilTargetInfo,
+            VK_SUBPASS_CONTENTS_INLINE)) {
+        return;
+    }
+
+    // Set sensible default states
+
+    VULKAN_INTERNAL_SetDefaultRenderPassState(
+        vulkanCommandBuffer,
+        vulkanCommandBuffer->currentFramebufferWidth,
+        vulkanCommandBuffer->currentFramebufferHeight);
+}
+
+static bool VULKAN_BeginParallelRenderPass(
+    SDL_GPUCommandBuffer *commandBuffer,
+    const SDL_GPUColorTargetInfo *colorTargetInfos,
+    Uint32 numColorTargets,
+    const SDL_GPUDepthStencilTargetInfo *depthStencilTargetInfo)
+{
+    /* The pass contents come from secondary command buffers,
+     * which set their own dynamic state when they are acquired.
+     */
+    return VULKAN_INTERNAL_BeginRenderPass(
+        commandBuffer,
+        colorTargetInfos,
+        numColorTargets,
+        depthStencilTargetInfo,
+        VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+}
+
 static void VULKAN_BindGraphicsPipeline(
     SDL_GPUCommandBuffer *commandBuffer,
     SDL_GPUGraphicsPipeline *graphicsPipeline)
@@ -8031,6 +8606,8 @@ static void VULKAN_EndRenderPass(
     }
 
     vulkanCommandBuffer->currentGraphicsPipeline = NULL;
+    vulkanCommandBuffer->currentRenderPass = VK_NULL_HANDLE;
+    vulkanCommandBuffer->currentFramebuffer = NULL;
 
     vulkanCommandBuffer->vertexResourceDescriptorSet = VK_NULL_HANDLE;
     vulkanCommandBuffer->vertexUniformDescriptorSet = VK_NULL_HANDLE;
@@ -8467,17 +9044,18 @@ static void VULKAN_INTERNAL_BindComputeDescriptorSets(
         0,
         NULL);
 
-    VkDescriptorSet sets[3];
+    VkDescriptorSet sets[4];
     sets[0] = commandBuffer->computeReadOnlyDescriptorSet;
     sets[1] = commandBuffer->computeReadWriteDescriptorSet;
     sets[2] = commandBuffer->computeUniformDescriptorSet;
+    sets[3] = renderer->bindlessDescriptorSet;
 
     renderer->vkCmdBindDescriptorSets(
         commandBuffer->commandBuffer,
         VK_PIPELINE_BIND_POINT_COMPUTE,
         resourceLayout->pipelineLayout,
         0,
-        3,
+        renderer->bindlessDescriptorSet != VK_NULL_HANDLE ? 4 : 3,
         sets,
         dynamicOffsetCount,
         dynamicOffsets);
@@ -9170,25 +9748,35 @@ static void VULKAN_Blit(
 
 static bool VULKAN_INTERNAL_AllocateCommandBuffer(
     VulkanRenderer *renderer,
-    VulkanCommandPool *vulkanCommandPool)
+    VulkanCommandPool *vulkanCommandPool,
+    bool secondary)
 {
     VkCommandBufferAllocateInfo allocateInfo;
     VkResult vulkanResult;
     VkCommandBuffer commandBufferHandle;
     VulkanCommandBuffer *commandBuffer;
 
-    vulkanCommandPool->inactiveCommandBufferCapacity += 1;
+    if (secondary) {
+        vulkanCommandPool->inactiveSecondaryCommandBufferCapacity += 1;
 
-    vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
-        vulkanCommandPool->inactiveCommandBuffers,
-        sizeof(VulkanCommandBuffer *) *
-            vulkanCommandPool->inactiveCommandBufferCapacity);
+        vulkanCommandPool->inactiveSecondaryCommandBuffers = SDL_realloc(
+            vulkanCommandPool->inactiveSecondaryCommandBuffers,
+            sizeof(VulkanCommandBuffer *) *
+                vulkanCommandPool->inactiveSecondaryCommandBufferCapacity);
+    } else {
+        vulkanCommandPool->inactiveCommandBufferCapacity += 1;
+
+        vulkanCommandPool->inactiveCommandBuffers = SDL_realloc(
+            vulkanCommandPool->inactiveCommandBuffers,
+            sizeof(VulkanCommandBuffer *) *
+                vulkanCommandPool->inactiveCommandBufferCapacity);
+    }
 
     allocateInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocateInfo.pNext = NULL;
     allocateInfo.commandPool = vulkanCommandPool->commandPool;
     allocateInfo.commandBufferCount = 1;
-    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.level = secondary ? VK_COMMAND_BUFFER_LEVEL_SECONDARY : VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 
     vulkanResult = renderer->vkAllocateCommandBuffers(
         renderer->logicalDevice,
@@ -9201,6 +9789,7 @@ static bool VULKAN_INTERNAL_AllocateCommandBuffer(
     commandBuffer->renderer = renderer;
     commandBuffer->commandPool = vulkanCommandPool;
     commandBuffer->commandBuffer = commandBufferHandle;
+    commandBuffer->isSecondary = secondary;
 
     commandBuffer->inFlightFence = VK_NULL_HANDLE;
 
@@ -9281,10 +9870,29 @@ static bool VULKAN_INTERNAL_AllocateCommandBuffer(
     commandBuffer->usedUniformBuffers = SDL_malloc(
         commandBuffer->usedUniformBufferCapacity * sizeof(VulkanUniformBuffer *));
 
+    commandBuffer->usedTransientBufferCapacity = 4;
+    commandBuffer->usedTransientBufferCount = 0;
+    commandBuffer->usedTransientBuffers = SDL_malloc(
+        commandBuffer->usedTransientBufferCapacity * sizeof(VulkanTransientBuffer *));
+
+    commandBuffer->usedQueryPoolCapacity = 4;
+    commandBuffer->usedQueryPoolCount = 0;
+    commandBuffer->usedQueryPools = SDL_malloc(
+        commandBuffer->usedQueryPoolCapacity * sizeof(VulkanQueryPool *));
+
+    commandBuffer->executedSecondaryCommandBufferCapacity = 0;
+    commandBuffer->executedSecondaryCommandBufferCount = 0;
+    commandBuffer->executedSecondaryCommandBuffers = NULL;
+
     // Pool it!
 
-    vulkanCommandPool->inactiveCommandBuffers[vulkanCommandPool->inactiveCommandBufferCount] = commandBuffer;
-    vulkanCommandPool->inactiveCommandBufferCount += 1;
+    if (secondary) {
+        vulkanCommandPool->inactiveSecondaryCommandBuffers[vulkanCommandPool->inactiveSecondaryCommandBufferCount] = commandBuffer;
+        vulkanCommandPool->inactiveSecondaryCommandBufferCount += 1;
+    } else {
+        vulkanCommandPool->inactiveCommandBuffers[vulkanCommandPool->inactiveCommandBufferCount] = commandBuffer;
+        vulkanCommandPool->inactiveCommandBufferCount += 1;
+    }
 
     return true;
 }
@@ -9333,9 +9941,14 @@ static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
     vulkanCommandPool->inactiveCommandBufferCount = 0;
     vulkanCommandPool->inactiveCommandBuffers = NULL;
 
+    vulkanCommandPool->inactiveSecondaryCommandBufferCapacity = 0;
+    vulkanCommandPool->inactiveSecondaryCommandBufferCount = 0;
+    vulkanCommandPool->inactiveSecondaryCommandBuffers = NULL;
+
     if (!VULKAN_INTERNAL_AllocateCommandBuffer(
         renderer,
-        vulkanCommandPool)) {
+        vulkanCommandPool,
+        false)) {
         VULKAN_INTERNAL_DestroyCommandPool(renderer, vulkanCommandPool);
         return NULL;
     }
@@ -9353,7 +9966,8 @@ static VulkanCommandPool *VULKAN_INTERNAL_FetchCommandPool(
 
 static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
     VulkanRenderer *renderer,
-    SDL_ThreadID threadID)
+    SDL_ThreadID threadID,
+    bool secondary)
 {
     VulkanCommandPool *commandPool =
         VULKAN_INTERNAL_FetchCommandPool(renderer, threadID);
@@ -9363,10 +9977,27 @@ static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
         return NULL;
     }
 
+    if (secondary) {
+        if (commandPool->inactiveSecondaryCommandBufferCount == 0) {
+            if (!VULKAN_INTERNAL_AllocateCommandBuffer(
+                renderer,
+                commandPool,
+                true)) {
+                return NULL;
+            }
+        }
+
+        commandBuffer = commandPool->inactiveSecondaryCommandBuffers[commandPool->inactiveSecondaryCommandBufferCount - 1];
+        commandPool->inactiveSecondaryCommandBufferCount -= 1;
+
+        return commandBuffer;
+    }
+
     if (commandPool->inactiveCommandBufferCount == 0) {
         if (!VULKAN_INTERNAL_AllocateCommandBuffer(
             renderer,
-            commandPool)) {
+            commandPool,
+            false)) {
             return NULL;
         }
     }
@@ -9377,30 +10008,11 @@ static VulkanCommandBuffer *VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(
     return commandBuffer;
 }
 
-static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
-    SDL_GPURenderer *driverData)
+static void VULKAN_INTERNAL_ResetCommandBufferState(
+    VulkanCommandBuffer *commandBuffer)
 {
-    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
-    VkResult result;
     Uint32 i;
 
-    SDL_ThreadID threadID = SDL_GetCurrentThreadID();
-
-    SDL_LockMutex(renderer->acquireCommandBufferLock);
-
-    VulkanCommandBuffer *commandBuffer =
-        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID);
-
-    commandBuffer->descriptorSetCache = VULKAN_INTERNAL_AcquireDescriptorSetCache(renderer);
-
-    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
-
-    if (commandBuffer == NULL) {
-        return NULL;
-    }
-
-    // Reset state
-
     commandBuffer->currentComputePipeline = NULL;
     commandBuffer->currentGraphicsPipeline = NULL;
 
@@ -9416,6 +10028,8 @@ static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
         commandBuffer->computeUniformBuffers[i] = NULL;
     }
 
+    commandBuffer->currentTransientBuffer = NULL;
+
     commandBuffer->needNewVertexResourceDescriptorSet = true;
     commandBuffer->needNewVertexUniformDescriptorSet = true;
     commandBuffer->needNewVertexUniformOffsets = true;
@@ -9454,6 +10068,37 @@ static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
     SDL_zeroa(commandBuffer->readOnlyComputeStorageTextures);
     SDL_zeroa(commandBuffer->readOnlyComputeStorageBuffers);
 
+    commandBuffer->currentRenderPass = VK_NULL_HANDLE;
+    commandBuffer->currentFramebuffer = NULL;
+    commandBuffer->currentFramebufferWidth = 0;
+    commandBuffer->currentFramebufferHeight = 0;
+}
+
+static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
+    SDL_GPURenderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkResult result;
+
+    SDL_ThreadID threadID = SDL_GetCurrentThreadID();
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    VulkanCommandBuffer *commandBuffer =
+        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID, false);
+
+    commandBuffer->descriptorSetCache = VULKAN_INTERNAL_AcquireDescriptorSetCache(renderer);
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    if (commandBuffer == NULL) {
+        return NULL;
+    }
+
+    // Reset state
+
+    VULKAN_INTERNAL_ResetCommandBufferState(commandBuffer);
+
     commandBuffer->autoReleaseFence = true;
 
     commandBuffer->isDefrag = 0;
@@ -9474,6 +10119,125 @@ static SDL_GPUCommandBuffer *VULKAN_AcquireCommandBuffer(
     return (SDL_GPUCommandBuffer *)commandBuffer;
 }
 
+static SDL_GPUCommandBuffer *VULKAN_AcquireSecondaryCommandBuffer(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    VulkanCommandBuffer *primaryCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = primaryCommandBuffer->renderer;
+    VulkanCommandBuffer *secondaryCommandBuffer;
+    VkCommandBufferInheritanceInfo inheritanceInfo;
+    VkCommandBufferBeginInfo beginInfo;
+    VkResult result;
+
+    SDL_ThreadID threadID = SDL_GetCurrentThreadID();
+
+    SDL_LockMutex(renderer->acquireCommandBufferLock);
+
+    secondaryCommandBuffer =
+        VULKAN_INTERNAL_GetInactiveCommandBufferFromPool(renderer, threadID, true);
+
+    if (secondaryCommandBuffer == NULL) {
+        SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+        return NULL;
+    }
+
+    secondaryCommandBuffer->descriptorSetCache = VULKAN_INTERNAL_AcquireDescriptorSetCache(renderer);
+
+    SDL_UnlockMutex(renderer->acquireCommandBufferLock);
+
+    VULKAN_INTERNAL_ResetCommandBufferState(secondaryCommandBuffer);
+
+    // The primary command buffer owns the fence
+    secondaryCommandBuffer->autoReleaseFence = false;
+    secondaryCommandBuffer->isDefrag = 0;
+
+    result = renderer->vkResetCommandBuffer(
+        secondaryCommandBuffer->commandBuffer,
+        VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
+
+    CHECK_VULKAN_ERROR_AND_RETURN(result, vkResetCommandBuffer, NULL);
+
+    inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritanceInfo.pNext = NULL;
+    inheritanceInfo.renderPass = primaryCommandBuffer->currentRenderPass;
+    inheritanceInfo.subpass = 0;
+    inheritanceInfo.framebuffer = primaryCommandBuffer->currentFramebuffer->framebuffer;
+    inheritanceInfo.occlusionQueryEnable = VK_FALSE;
+    inheritanceInfo.queryFlags = 0;
+    inheritanceInfo.pipelineStatistics = 0;
+
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.pNext = NULL;
+    beginInfo.flags =
+        VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+        VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+    beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+    result = renderer->vkBeginCommandBuffer(
+        secondaryCommandBuffer->commandBuffer,
+        &beginInfo);
+
+    CHECK_VULKAN_ERROR_AND_RETURN(result, vkBeginCommandBuffer, NULL);
+
+    secondaryCommandBuffer->currentRenderPass = primaryCommandBuffer->currentRenderPass;
+    secondaryCommandBuffer->currentFramebufferWidth = primaryCommandBuffer->currentFramebufferWidth;
+    secondaryCommandBuffer->currentFramebufferHeight = primaryCommandBuffer->currentFramebufferHeight;
+
+    // Dynamic state is not inherited from the primary command buffer
+
+    VULKAN_INTERNAL_SetDefaultRenderPassState(
+        secondaryCommandBuffer,
+        secondaryCommandBuffer->currentFramebufferWidth,
+        secondaryCommandBuffer->currentFramebufferHeight);
+
+    return (SDL_GPUCommandBuffer *)secondaryCommandBuffer;
+}
+
+static bool VULKAN_EndSecondaryCommandBuffer(
+    SDL_GPUCommandBuffer *commandBuffer)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+
+    vulkanCommandBuffer->currentGraphicsPipeline = NULL;
+
+    return VULKAN_INTERNAL_EndCommandBuffer(
+        vulkanCommandBuffer->renderer,
+        vulkanCommandBuffer);
+}
+
+static void VULKAN_ExecuteSecondaryCommandBuffers(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUCommandBuffer *const *secondaryCommandBuffers,
+    Uint32 numSecondaryCommandBuffers)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VkCommandBuffer *commandBufferHandles = SDL_stack_alloc(VkCommandBuffer, numSecondaryCommandBuffers);
+
+    for (Uint32 i = 0; i < numSecondaryCommandBuffers; i += 1) {
+        VulkanCommandBuffer *secondaryCommandBuffer = (VulkanCommandBuffer *)secondaryCommandBuffers[i];
+
+        commandBufferHandles[i] = secondaryCommandBuffer->commandBuffer;
+
+        // The secondary command buffer is cleaned along with this one
+        if (vulkanCommandBuffer->executedSecondaryCommandBufferCount == vulkanCommandBuffer->executedSecondaryCommandBufferCapacity) {
+            vulkanCommandBuffer->executedSecondaryCommandBufferCapacity += 1;
+            vulkanCommandBuffer->executedSecondaryCommandBuffers = SDL_realloc(
+                vulkanCommandBuffer->executedSecondaryCommandBuffers,
+                vulkanCommandBuffer->executedSecondaryCommandBufferCapacity * sizeof(VulkanCommandBuffer *));
+        }
+        vulkanCommandBuffer->executedSecondaryCommandBuffers[vulkanCommandBuffer->executedSecondaryCommandBufferCount] = secondaryCommandBuffer;
+        vulkanCommandBuffer->executedSecondaryCommandBufferCount += 1;
+    }
+
+    renderer->vkCmdExecuteCommands(
+        vulkanCommandBuffer->commandBuffer,
+        numSecondaryCommandBuffers,
+        commandBufferHandles);
+
+    SDL_stack_free(commandBufferHandles);
+}
+
 static bool VULKAN_QueryFence(
     SDL_GPURenderer *driverData,
     SDL_GPUFence *fence)
@@ -9524,6 +10288,155 @@ static void VULKAN_ReleaseFence(
     }
 }
 
+// Queries
+
+static SDL_GPUQueryPool *VULKAN_CreateQueryPool(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUQueryPoolCreateInfo *createinfo)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkQueryPoolCreateInfo queryPoolCreateInfo;
+    VulkanQueryPool *queryPool;
+    VkResult vulkanResult;
+
+    if (!renderer->physicalDeviceProperties.properties.limits.timestampComputeAndGraphics) {
+        SET_STRING_ERROR_AND_RETURN("Timestamp queries are not supported by this device", NULL);
+    }
+
+    queryPool = SDL_malloc(sizeof(VulkanQueryPool));
+    if (queryPool == NULL) {
+        return NULL;
+    }
+
+    queryPoolCreateInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolCreateInfo.pNext = NULL;
+    queryPoolCreateInfo.flags = 0;
+    queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolCreateInfo.queryCount = createinfo->num_queries;
+    queryPoolCreateInfo.pipelineStatistics = 0;
+
+    vulkanResult = renderer->vkCreateQueryPool(
+        renderer->logicalDevice,
+        &queryPoolCreateInfo,
+        NULL,
+        &queryPool->queryPool);
+
+    if (vulkanResult != VK_SUCCESS) {
+        SDL_free(queryPool);
+        CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkCreateQueryPool, NULL);
+    }
+
+    queryPool->header.num_queries = createinfo->num_queries;
+    SDL_SetAtomicInt(&queryPool->referenceCount, 0);
+
+    return (SDL_GPUQueryPool *)queryPool;
+}
+
+static void VULKAN_WriteTimestamp(
+    SDL_GPUCommandBuffer *commandBuffer,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 queryIndex)
+{
+    VulkanCommandBuffer *vulkanCommandBuffer = (VulkanCommandBuffer *)commandBuffer;
+    VulkanRenderer *renderer = vulkanCommandBuffer->renderer;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+
+    if (queryIndex >= vulkanQueryPool->header.num_queries) {
+        SET_ERROR_AND_RETURN("Query index %" SDL_PRIu32 " is out of range", queryIndex, );
+    }
+
+    // Queries have to be reset before every use, and resets are not allowed inside a render pass
+    renderer->vkCmdResetQueryPool(
+        vulkanCommandBuffer->commandBuffer,
+        vulkanQueryPool->queryPool,
+        queryIndex,
+        1);
+
+    renderer->vkCmdWriteTimestamp(
+        vulkanCommandBuffer->commandBuffer,
+        VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+        vulkanQueryPool->queryPool,
+        queryIndex);
+
+    VULKAN_INTERNAL_TrackQueryPool(vulkanCommandBuffer, vulkanQueryPool);
+}
+
+static bool VULKAN_QueryPoolResultsAvailable(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+    (void)driverData;
+
+    // Results land once every command buffer that writes to this pool has completed
+    return SDL_GetAtomicInt(&vulkanQueryPool->referenceCount) == 0;
+}
+
+static bool VULKAN_GetQueryPoolResults(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool,
+    Uint32 firstQuery,
+    Uint32 numQueries,
+    Uint64 *results)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanQueryPool *vulkanQueryPool = (VulkanQueryPool *)queryPool;
+    double period = renderer->physicalDeviceProperties.properties.limits.timestampPeriod;
+    VkResult vulkanResult;
+
+    if (firstQuery >= vulkanQueryPool->header.num_queries ||
+        numQueries > vulkanQueryPool->header.num_queries - firstQuery) {
+        SET_STRING_ERROR_AND_RETURN("Query range exceeds the query pool size", false);
+    }
+
+    if (!VULKAN_QueryPoolResultsAvailable(driverData, queryPool)) {
+        return SDL_SetError("Query results are not available yet");
+    }
+
+    vulkanResult = renderer->vkGetQueryPoolResults(
+        renderer->logicalDevice,
+        vulkanQueryPool->queryPool,
+        firstQuery,
+        numQueries,
+        numQueries * sizeof(Uint64),
+        results,
+        sizeof(Uint64),
+        VK_QUERY_RESULT_64_BIT);
+
+    if (vulkanResult == VK_NOT_READY) {
+        return SDL_SetError("Query results are not available yet");
+    }
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetQueryPoolResults, false);
+
+    // Convert ticks to nanoseconds
+    for (Uint32 i = 0; i < numQueries; i += 1) {
+        results[i] = (Uint64)((double)results[i] * period);
+    }
+
+    return true;
+}
+
+static void VULKAN_ReleaseQueryPool(
+    SDL_GPURenderer *driverData,
+    SDL_GPUQueryPool *queryPool)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+
+    SDL_LockMutex(renderer->disposeLock);
+
+    EXPAND_ARRAY_IF_NEEDED(
+        renderer->queryPoolsToDestroy,
+        VulkanQueryPool *,
+        renderer->queryPoolsToDestroyCount + 1,
+        renderer->queryPoolsToDestroyCapacity,
+        renderer->queryPoolsToDestroyCapacity * 2);
+
+    renderer->queryPoolsToDestroy[renderer->queryPoolsToDestroyCount] = (VulkanQueryPool *)queryPool;
+    renderer->queryPoolsToDestroyCount += 1;
+
+    SDL_UnlockMutex(renderer->disposeLock);
+}
+
 static WindowData *VULKAN_INTERNAL_FetchWindowData(
     SDL_Window *window)
 {
@@ -10165,6 +11078,17 @@ static void VULKAN_INTERNAL_PerformPendingDestroys(
         }
     }
 
+    for (Sint32 i = renderer->queryPoolsToDestroyCount - 1; i >= 0; i -= 1) {
+        if (SDL_GetAtomicInt(&renderer->queryPoolsToDestroy[i]->referenceCount) == 0) {
+            VULKAN_INTERNAL_DestroyQueryPool(
+                renderer,
+                renderer->queryPoolsToDestroy[i]);
+
+            renderer->queryPoolsToDestroy[i] = renderer->queryPoolsToDestroy[renderer->queryPoolsToDestroyCount - 1];
+            renderer->queryPoolsToDestroyCount -= 1;
+        }
+    }
+
     for (Sint32 i = renderer->shadersToDestroyCount - 1; i >= 0; i -= 1) {
         if (SDL_GetAtomicInt(&renderer->shadersToDestroy[i]->referenceCount) == 0) {
             VULKAN_INTERNAL_DestroyShader(
@@ -10227,6 +11151,20 @@ static void VULKAN_INTERNAL_CleanCommandBuffer(
 
     SDL_UnlockMutex(renderer->acquireUniformBufferLock);
 
+    // Transient buffers are now available
+
+    SDL_LockMutex(renderer->acquireTransientBufferLock);
+
+    for (Sint32 i = 0; i < commandBuffer->usedTransientBufferCount; i += 1) {
+        VULKAN_INTERNAL_ReturnTransientBufferToPool(
+            renderer,
+            commandBuffer->usedTransientBuffers[i]);
+    }
+    commandBuffer->usedTransientBufferCount = 0;
+    commandBuffer->currentTransientBuffer = NULL;
+
+    SDL_UnlockMutex(renderer->acquireTransientBufferLock);
+
     // Decrement reference counts
 
     for (Sint32 i = 0; i < commandBuffer->usedBufferCount; i += 1) {
@@ -10259,6 +11197,11 @@ static void VULKAN_INTERNAL_CleanCommandBuffer(
     }
     commandBuffer->usedFramebufferCount = 0;
 
+    for (Sint32 i = 0; i < commandBuffer->usedQueryPoolCount; i += 1) {
+        (void)SDL_AtomicDecRef(&commandBuffer->usedQueryPools[i]->referenceCount);
+    }
+    commandBuffer->usedQueryPoolCount = 0;
+
     // Reset presentation data
 
     commandBuffer->presentDataCount = 0;
@@ -10271,19 +11214,41 @@ static void VULKAN_INTERNAL_CleanCommandBuffer(
         renderer->defragInProgress = 0;
     }
 
+    // Executed secondary command buffers are done too, they were never submitted on their own
+
+    for (Sint32 i = 0; i < commandBuffer->executedSecondaryCommandBufferCount; i += 1) {
+        VULKAN_INTERNAL_CleanCommandBuffer(
+            renderer,
+            commandBuffer->executedSecondaryCommandBuffers[i],
+            true);
+    }
+    commandBuffer->executedSecondaryCommandBufferCount = 0;
+
     // Return command buffer to pool
 
     SDL_LockMutex(renderer->acquireCommandBufferLock);
 
-    if (commandBuffer->commandPool->inactiveCommandBufferCount == commandBuffer->commandPool->inactiveCommandBufferCapacity) {
-        commandBuffer->commandPool->inactiveCommandBufferCapacity += 1;
-        commandBuffer->commandPool->inactiveCommandBuffers = SDL_realloc(
-            commandBuffer->commandPool->inactiveCommandBuffers,
-            commandBuffer->commandPool->inactiveCommandBufferCapacity * sizeof(VulkanCommandBuffer *));
-    }
+    if (commandBuffer->isSecondary) {
+        if (commandBuffer->commandPool->inactiveSecondaryCommandBufferCount == commandBuffer->commandPool->inactiveSecondaryCommandBufferCapacity) {
+            commandBuffer->commandPool->inactiveSecondaryCommandBufferCapacity += 1;
+            commandBuffer->commandPool->inactiveSecondaryCommandBuffers = SDL_realloc(
+                commandBuffer->commandPool->inactiveSecondaryCommandBuffers,
+                commandBuffer->commandPool->inactiveSecondaryCommandBufferCapacity * sizeof(VulkanCommandBuffer *));
+        }
+
+        commandBuffer->commandPool->inactiveSecondaryCommandBuffers[commandBuffer->commandPool->inactiveSecondaryCommandBufferCount] = commandBuffer;
+        commandBuffer->commandPool->inactiveSecondaryCommandBufferCount += 1;
+    } else {
+        if (commandBuffer->commandPool->inactiveCommandBufferCount == commandBuffer->commandPool->inactiveCommandBufferCapacity) {
+            commandBuffer->commandPool->inactiveCommandBufferCapacity += 1;
+            commandBuffer->commandPool->inactiveCommandBuffers = SDL_realloc(
+                commandBuffer->commandPool->inactiveCommandBuffers,
+                commandBuffer->commandPool->inactiveCommandBufferCapacity * sizeof(VulkanCommandBuffer *));
+        }
 
-    commandBuffer->commandPool->inactiveCommandBuffers[commandBuffer->commandPool->inactiveCommandBufferCount] = commandBuffer;
-    commandBuffer->commandPool->inactiveCommandBufferCount += 1;
+        commandBuffer->commandPool->inactiveCommandBuffers[commandBuffer->commandPool->inactiveCommandBufferCount] = commandBuffer;
+        commandBuffer->commandPool->inactiveCommandBufferCount += 1;
+    }
 
     // Release descriptor set cache
 
@@ -10614,6 +11579,9 @@ static bool VULKAN_INTERNAL_DefragmentMemory(
     VulkanTextureSubresource *srcSubresource;
     VulkanTextureSubresource *dstSubresource;
     Uint32 i, subresourceIndex;
+    Uint64 startTime = SDL_GetTicksNS();
+    Uint32 movedCount = 0;
+    bool outOfTime = false;
 
     renderer->defragInProgress = 1;
 
@@ -10625,155 +11593,177 @@ static bool VULKAN_INTERNAL_DefragmentMemory(
 
     SDL_LockMutex(renderer->allocatorLock);
 
-    allocation = renderer->allocationsToDefrag[renderer->allocationsToDefragCount - 1];
-    renderer->allocationsToDefragCount -= 1;
-
-    /* For each used region in the allocation
-     * create a new resource, copy the data
-     * and re-point the resource containers
+    /* Without a time budget, move one whole allocation per frame.
+     * With one, keep moving regions until the time runs out. Regions that
+     * were already moved are marked for destroy, so an allocation that is
+     * put back on the list picks up where it left off next frame.
      */
-    for (i = 0; i < allocation->usedRegionCount; i += 1) {
-        currentRegion = allocation->usedRegions[i];
-
-        if (currentRegion->isBuffer && !currentRegion->vulkanBuffer->markedForDestroy) {
-            currentRegion->vulkanBuffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+    while (renderer->allocationsToDefragCount > 0 && !outOfTime) {
+        allocation = renderer->allocationsToDefrag[renderer->allocationsToDefragCount - 1];
+        renderer->allocationsToDefragCount -= 1;
 
-            newBuffer = VULKAN_INTERNAL_CreateBuffer(
-                renderer,
-                currentRegion->vulkanBuffer->size,
-                currentRegion->vulkanBuffer->usage,
-                currentRegion->vulkanBuffer->type,
-                false,
-                currentRegion->vulkanBuffer->container != NULL ? currentRegion->vulkanBuffer->container->debugName : NULL);
-
-            if (newBuffer == NULL) {
-                SDL_UnlockMutex(renderer->allocatorLock);
-                return false;
+        /* For each used region in the allocation
+         * create a new resource, copy the data
+         * and re-point the resource containers
+         */
+        for (i = 0; i < allocation->usedRegionCount; i += 1) {
+            currentRegion = allocation->usedRegions[i];
+
+            if (renderer->defragBudgetNS > 0 && movedCount > 0 &&
+                SDL_GetTicksNS() - startTime >= renderer->defragBudgetNS) {
+                // Resume this allocation next frame
+                renderer->allocationsToDefrag[renderer->allocationsToDefragCount] = allocation;
+                renderer->allocationsToDefragCount += 1;
+                outOfTime = true;
+                break;
             }
 
-            // Copy buffer contents if necessary
-            if (
-                currentRegion->vulkanBuffer->type == VULKAN_BUFFER_TYPE_GPU && currentRegion->vulkanBuffer->transitioned) {
-                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
-                    currentRegion->vulkanBuffer);
+            if (currentRegion->isBuffer && !currentRegion->vulkanBuffer->markedForDestroy) {
+                currentRegion->vulkanBuffer->usage |= VK_BUFFER_USAGE_TRANSFER_DST_BIT;
 
-                VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
-                    newBuffer);
-
-                bufferCopy.srcOffset = 0;
-                bufferCopy.dstOffset = 0;
-                bufferCopy.size = currentRegion->resourceSize;
-
-                renderer->vkCmdCopyBuffer(
-                    commandBuffer->commandBuffer,
-                    currentRegion->vulkanBuffer->buffer,
-                    newBuffer->buffer,
-                    1,
-                    &bufferCopy);
-
-                VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+                newBuffer = VULKAN_INTERNAL_CreateBuffer(
                     renderer,
-                    commandBuffer,
-                    VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
-                    newBuffer);
+                    currentRegion->vulkanBuffer->size,
+                    currentRegion->vulkanBuffer->usage,
+                    currentRegion->vulkanBuffer->type,
+                    false,
+                    currentRegion->vulkanBuffer->container != NULL ? currentRegion->vulkanBuffer->container->debugName : NULL);
+
+                if (newBuffer == NULL) {
+                    SDL_UnlockMutex(renderer->allocatorLock);
+                    return false;
+                }
 
-                VULKAN_INTERNAL_TrackBuffer(commandBuffer, currentRegion->vulkanBuffer);
-                VULKAN_INTERNAL_TrackBuffer(commandBuffer, newBuffer);
-            }
+                // Copy buffer contents if necessary
+                if (
+                    currentRegion->vulkanBuffer->type == VULKAN_BUFFER_TYPE_GPU && currentRegion->vulkanBuffer->transitioned) {
+                    VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_BUFFER_USAGE_MODE_COPY_SOURCE,
+                        currentRegion->vulkanBuffer);
 
-            // re-point original container to new buffer
-            newBuffer->container = currentRegion->vulkanBuffer->container;
-            newBuffer->containerIndex = currentRegion->vulkanBuffer->containerIndex;
-            if (newBuffer->type == VULKAN_BUFFER_TYPE_UNIFORM) {
-                ((VulkanUniformBuffer *)newBuffer->container)->buffer = newBuffer;
-            } else {
-                newBuffer->container->buffers[newBuffer->containerIndex] = newBuffer;
-                if (newBuffer->container->activeBuffer == currentRegion->vulkanBuffer) {
-                    newBuffer->container->activeBuffer = newBuffer;
+                    VULKAN_INTERNAL_BufferTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+                        newBuffer);
+
+                    bufferCopy.srcOffset = 0;
+                    bufferCopy.dstOffset = 0;
+                    bufferCopy.size = currentRegion->resourceSize;
+
+                    renderer->vkCmdCopyBuffer(
+                        commandBuffer->commandBuffer,
+                        currentRegion->vulkanBuffer->buffer,
+                        newBuffer->buffer,
+                        1,
+                        &bufferCopy);
+
+                    VULKAN_INTERNAL_BufferTransitionToDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_BUFFER_USAGE_MODE_COPY_DESTINATION,
+                        newBuffer);
+
+                    VULKAN_INTERNAL_TrackBuffer(commandBuffer, currentRegion->vulkanBuffer);
+                    VULKAN_INTERNAL_TrackBuffer(commandBuffer, newBuffer);
                 }
-            }
 
-            VULKAN_INTERNAL_ReleaseBuffer(renderer, currentRegion->vulkanBuffer);
-        } else if (!currentRegion->isBuffer && !currentRegion->vulkanTexture->markedForDestroy) {
-            newTexture = VULKAN_INTERNAL_CreateTexture(
-                renderer,
-                &currentRegion->vulkanTexture->container->header.info);
+                // re-point original container to new buffer
+                newBuffer->container = currentRegion->vulkanBuffer->container;
+                newBuffer->containerIndex = currentRegion->vulkanBuffer->containerIndex;
+                if (newBuffer->type == VULKAN_BUFFER_TYPE_UNIFORM) {
+                    ((VulkanUniformBuffer *)newBuffer->container)->buffer = newBuffer;
+                } else {
+                    newBuffer->container->buffers[newBuffer->containerIndex] = newBuffer;
+                    if (newBuffer->container->activeBuffer == currentRegion->vulkanBuffer) {
+                        newBuffer->container->activeBuffer = newBuffer;
+                    }
+                }
 
-            if (newTexture == NULL) {
-                SDL_UnlockMutex(renderer->allocatorLock);
-                return false;
-            }
+                VULKAN_INTERNAL_ReleaseBuffer(renderer, currentRegion->vulkanBuffer);
+                movedCount += 1;
+            } else if (!currentRegion->isBuffer && !currentRegion->vulkanTexture->markedForDestroy) {
+                newTexture = VULKAN_INTERNAL_CreateTexture(
+                    renderer,
+                    &currentRegion->vulkanTexture->container->header.info);
 
-            SDL_GPUTextureCreateInfo info = currentRegion->vulkanTexture->container->header.info;
-            for (subresourceIndex = 0; subresourceIndex < currentRegion->vulkanTexture->subresourceCount; subresourceIndex += 1) {
-                // copy subresource if necessary
-                srcSubresource = &currentRegion->vulkanTexture->subresources[subresourceIndex];
-                dstSubresource = &newTexture->subresources[subresourceIndex];
+                if (newTexture == NULL) {
+                    SDL_UnlockMutex(renderer->allocatorLock);
+                    return false;
+                }
 
-                VULKAN_INTERNAL_TextureSubresourceTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
-                    srcSubresource);
+                SDL_GPUTextureCreateInfo info = currentRegion->vulkanTexture->container->header.info;
+                for (subresourceIndex = 0; subresourceIndex < currentRegion->vulkanTexture->subresourceCount; subresourceIndex += 1) {
+                    // copy subresource if necessary
+                    srcSubresource = &currentRegion->vulkanTexture->subresources[subresourceIndex];
+                    dstSubresource = &newTexture->subresources[subresourceIndex];
 
-                VULKAN_INTERNAL_TextureSubresourceTransitionFromDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                    dstSubresource);
-
-                imageCopy.srcOffset.x = 0;
-                imageCopy.srcOffset.y = 0;
-                imageCopy.srcOffset.z = 0;
-                imageCopy.srcSubresource.aspectMask = srcSubresource->parent->aspectFlags;
-                imageCopy.srcSubresource.baseArrayLayer = srcSubresource->layer;
-                imageCopy.srcSubresource.layerCount = 1;
-                imageCopy.srcSubresource.mipLevel = srcSubresource->level;
-                imageCopy.extent.width = SDL_max(1, info.width >> srcSubresource->level);
-                imageCopy.extent.height = SDL_max(1, info.height >> srcSubresource->level);
-                imageCopy.extent.depth = info.type == SDL_GPU_TEXTURETYPE_3D ? info.layer_count_or_depth : 1;
-                imageCopy.dstOffset.x = 0;
-                imageCopy.dstOffset.y = 0;
-                imageCopy.dstOffset.z = 0;
-                imageCopy.dstSubresource.aspectMask = dstSubresource->parent->aspectFlags;
-                imageCopy.dstSubresource.baseArrayLayer = dstSubresource->layer;
-                imageCopy.dstSubresource.layerCount = 1;
-                imageCopy.dstSubresource.mipLevel = dstSubresource->level;
-
-                renderer->vkCmdCopyImage(
-                    commandBuffer->commandBuffer,
-                    currentRegion->vulkanTexture->image,
-                    VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                    newTexture->image,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    1,
-                    &imageCopy);
-
-                VULKAN_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
-                    renderer,
-                    commandBuffer,
-                    VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
-                    dstSubresource);
+                    VULKAN_INTERNAL_TextureSubresourceTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_SOURCE,
+                        srcSubresource);
 
-                VULKAN_INTERNAL_TrackTexture(commandBuffer, srcSubresource->parent);
-                VULKAN_INTERNAL_TrackTexture(commandBuffer, dstSubresource->parent);
-            }
+                    VULKAN_INTERNAL_TextureSubresourceTransitionFromDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                        dstSubresource);
+
+                    imageCopy.srcOffset.x = 0;
+                    imageCopy.srcOffset.y = 0;
+                    imageCopy.srcOffset.z = 0;
+                    imageCopy.srcSubresource.aspectMask = srcSubresource->parent->aspectFlags;
+                    imageCopy.srcSubresource.baseArrayLayer = srcSubresource->layer;
+                    imageCopy.srcSubresource.layerCount = 1;
+                    imageCopy.srcSubresource.mipLevel = srcSubresource->level;
+                    imageCopy.extent.width = SDL_max(1, info.width >> srcSubresource->level);
+                    imageCopy.extent.height = SDL_max(1, info.height >> srcSubresource->level);
+                    imageCopy.extent.depth = info.type == SDL_GPU_TEXTURETYPE_3D ? info.layer_count_or_depth : 1;
+                    imageCopy.dstOffset.x = 0;
+                    imageCopy.dstOffset.y = 0;
+                    imageCopy.dstOffset.z = 0;
+                    imageCopy.dstSubresource.aspectMask = dstSubresource->parent->aspectFlags;
+                    imageCopy.dstSubresource.baseArrayLayer = dstSubresource->layer;
+                    imageCopy.dstSubresource.layerCount = 1;
+                    imageCopy.dstSubresource.mipLevel = dstSubresource->level;
+
+                    renderer->vkCmdCopyImage(
+                        commandBuffer->commandBuffer,
+                        currentRegion->vulkanTexture->image,
+                        VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                        newTexture->image,
+                        VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                        1,
+                        &imageCopy);
+
+                    VULKAN_INTERNAL_TextureSubresourceTransitionToDefaultUsage(
+                        renderer,
+                        commandBuffer,
+                        VULKAN_TEXTURE_USAGE_MODE_COPY_DESTINATION,
+                        dstSubresource);
+
+                    VULKAN_INTERNAL_TrackTexture(commandBuffer, srcSubresource->parent);
+                    VULKAN_INTERNAL_TrackTexture(commandBuffer, dstSubresource->parent);
+                }
 
-            // re-point original container to new texture
-            newTexture->container = currentRegion->vulkanTexture->container;
-            newTexture->containerIndex = currentRegion->vulkanTexture->containerIndex;
-            newTexture->container->textures[currentRegion->vulkanTexture->containerIndex] = newTexture;
-            if (currentRegion->vulkanTexture == currentRegion->vulkanTexture->container->activeTexture) {
-                newTexture->container->activeTexture = newTexture;
+                // re-point original container to new texture
+                newTexture->container = currentRegion->vulkanTexture->container;
+                newTexture->containerIndex = currentRegion->vulkanTexture->containerIndex;
+                newTexture->container->textures[currentRegion->vulkanTexture->containerIndex] = newTexture;
+                if (currentRegion->vulkanTexture == currentRegion->vulkanTexture->container->activeTexture) {
+                    newTexture->container->activeTexture = newTexture;
+                }
+
+                VULKAN_INTERNAL_ReleaseTexture(renderer, currentRegion->vulkanTexture);
+                movedCount += 1;
             }
+        }
 
-            VULKAN_INTERNAL_ReleaseTexture(renderer, currentRegion->vulkanTexture);
+        if (renderer->defragBudgetNS == 0 || SDL_GetTicksNS() - startTime >= renderer->defragBudgetNS) {
+            break;
         }
     }
 
@@ -10847,7 +11837,7 @@ static inline Uint8 CheckDeviceExtensions(
         supports->ext = 1;                   \
     }
         CHECK(KHR_swapchain)
-        else CHECK(KHR_maintenance1) else CHECK(KHR_driver_properties) else CHECK(EXT_vertex_attribute_divisor) else CHECK(KHR_portability_subset) else CHECK(EXT_texture_compression_astc_hdr)
+        else CHECK(KHR_maintenance1) else CHECK(KHR_driver_properties) else CHECK(EXT_vertex_attribute_divisor) else CHECK(KHR_portability_subset) else CHECK(EXT_texture_compression_astc_hdr) else CHECK(EXT_descriptor_indexing) else CHECK(KHR_maintenance3) else CHECK(EXT_memory_budget)
 #undef CHECK
     }
 
@@ -10863,7 +11853,10 @@ static inline Uint32 GetDeviceExtensionCount(VulkanExtensions *supports)
         supports->KHR_driver_properties +
         supports->EXT_vertex_attribute_divisor +
         supports->KHR_portability_subset +
-        supports->EXT_texture_compression_astc_hdr);
+        supports->EXT_texture_compression_astc_hdr +
+        supports->EXT_descriptor_indexing +
+        supports->KHR_maintenance3 +
+        supports->EXT_memory_budget);
 }
 
 static inline void CreateDeviceExtensionArray(
@@ -10881,6 +11874,9 @@ static inline void CreateDeviceExtensionArray(
     CHECK(EXT_vertex_attribute_divisor)
     CHECK(KHR_portability_subset)
     CHECK(EXT_texture_compression_astc_hdr)
+    CHECK(EXT_descriptor_indexing)
+    CHECK(KHR_maintenance3)
+    CHECK(EXT_memory_budget)
 #undef CHECK
 }
 
@@ -11374,14 +12370,75 @@ static Uint8 VULKAN_INTERNAL_DeterminePhysicalDevice(VulkanRenderer *renderer)
     return 1;
 }
 
+static Uint32 VULKAN_INTERNAL_QueryBindlessTextureCapacity(
+    VulkanRenderer *renderer,
+    Uint32 requestedCapacity)
+{
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures;
+    VkPhysicalDeviceFeatures2 features;
+    VkPhysicalDeviceDescriptorIndexingPropertiesEXT indexingProperties;
+    VkPhysicalDeviceProperties2 properties;
+    Uint32 capacity = requestedCapacity;
+
+    if (requestedCapacity == 0) {
+        return 0;
+    }
+
+    if (!renderer->supports.EXT_descriptor_indexing || !renderer->supports.KHR_maintenance3) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_GPU, "EXT_descriptor_indexing unsupported, bindless textures disabled");
+        return 0;
+    }
+
+    SDL_zero(indexingFeatures);
+    indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+    features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    features.pNext = &indexingFeatures;
+    renderer->vkGetPhysicalDeviceFeatures2KHR(
+        renderer->physicalDevice,
+        &features);
+
+    if (!indexingFeatures.runtimeDescriptorArray ||
+        !indexingFeatures.descriptorBindingPartiallyBound ||
+        !indexingFeatures.descriptorBindingSampledImageUpdateAfterBind ||
+        !indexingFeatures.shaderSampledImageArrayNonUniformIndexing) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_GPU, "Update-after-bind sampled images unsupported, bindless textures disabled");
+        return 0;
+    }
+
+    SDL_zero(indexingProperties);
+    indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+    properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+    properties.pNext = &indexingProperties;
+    renderer->vkGetPhysicalDeviceProperties2KHR(
+        renderer->physicalDevice,
+        &properties);
+
+    // Leave room for the regular per-stage samplers, which count against the same limits
+    capacity = SDL_min(capacity, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages - MAX_TEXTURE_SAMPLERS_PER_STAGE * 2);
+    capacity = SDL_min(capacity, indexingProperties.maxDescriptorSetUpdateAfterBindSamplers - MAX_TEXTURE_SAMPLERS_PER_STAGE * 2);
+    capacity = SDL_min(capacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages - MAX_TEXTURE_SAMPLERS_PER_STAGE);
+    capacity = SDL_min(capacity, indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers - MAX_TEXTURE_SAMPLERS_PER_STAGE);
+
+    if (capacity < requestedCapacity) {
+        SDL_LogInfo(
+            SDL_LOG_CATEGORY_GPU,
+            "Bindless texture array clamped to %" SDL_PRIu32 " slots",
+            capacity);
+    }
+
+    return capacity;
+}
+
 static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
-    VulkanRenderer *renderer)
+    VulkanRenderer *renderer,
+    Uint32 requestedBindlessTextureCapacity)
 {
     VkResult vulkanResult;
     VkDeviceCreateInfo deviceCreateInfo;
     VkPhysicalDeviceFeatures desiredDeviceFeatures;
     VkPhysicalDeviceFeatures haveDeviceFeatures;
     VkPhysicalDevicePortabilitySubsetFeaturesKHR portabilityFeatures;
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT indexingFeatures;
     const char **deviceExtensions;
 
     VkDeviceQueueCreateInfo queueCreateInfo;
@@ -11421,6 +12478,10 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
         renderer->supportsMultiDrawIndirect = true;
     }
 
+    renderer->bindlessTextureCapacity = VULKAN_INTERNAL_QueryBindlessTextureCapacity(
+        renderer,
+        requestedBindlessTextureCapacity);
+
     // creating the logical device
 
     deviceCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
@@ -11446,6 +12507,16 @@ static Uint8 VULKAN_INTERNAL_CreateLogicalDevice(
     } else {
         deviceCreateInfo.pNext = NULL;
     }
+    if (renderer->bindlessTextureCapacity > 0) {
+        SDL_zero(indexingFeatures);
+        indexingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+        indexingFeatures.pNext = (void *)deviceCreateInfo.pNext;
+        indexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        indexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        indexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        indexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        deviceCreateInfo.pNext = &indexingFeatures;
+    }
     deviceCreateInfo.flags = 0;
     deviceCreateInfo.queueCreateInfoCount = 1;
     deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
@@ -11570,6 +12641,267 @@ static bool VULKAN_PrepareDriver(SDL_VideoDevice *_this)
     return result;
 }
 
+static bool VULKAN_INTERNAL_IsPipelineCacheCompatible(
+    VulkanRenderer *renderer,
+    const void *data,
+    size_t size)
+{
+    VkPipelineCacheHeaderVersionOne header;
+
+    // Drivers are supposed to reject foreign data themselves, but not all of them do
+    if (size < sizeof(header)) {
+        return false;
+    }
+
+    SDL_memcpy(&header, data, sizeof(header));
+
+    return header.headerSize >= sizeof(header) &&
+           header.headerSize <= size &&
+           header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == renderer->physicalDeviceProperties.properties.vendorID &&
+           header.deviceID == renderer->physicalDeviceProperties.properties.deviceID &&
+           SDL_memcmp(header.pipelineCacheUUID, renderer->physicalDeviceProperties.properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+static void VULKAN_INTERNAL_CreatePipelineCache(
+    VulkanRenderer *renderer,
+    SDL_PropertiesID props)
+{
+    VkPipelineCacheCreateInfo pipelineCacheCreateInfo;
+    const void *data = SDL_GetPointerProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_POINTER, NULL);
+    size_t size = (size_t)SDL_GetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_PIPELINE_CACHE_SIZE_NUMBER, 0);
+    VkResult vulkanResult;
+
+    if (data != NULL && !VULKAN_INTERNAL_IsPipelineCacheCompatible(renderer, data, size)) {
+        SDL_LogInfo(SDL_LOG_CATEGORY_GPU, "Ignoring pipeline cache data from a different driver or device");
+        data = NULL;
+    }
+
+    pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCreateInfo.pNext = NULL;
+    pipelineCacheCreateInfo.flags = 0;
+    pipelineCacheCreateInfo.initialDataSize = data ? size : 0;
+    pipelineCacheCreateInfo.pInitialData = data;
+
+    vulkanResult = renderer->vkCreatePipelineCache(
+        renderer->logicalDevice,
+        &pipelineCacheCreateInfo,
+        NULL,
+        &renderer->pipelineCache);
+
+    if (vulkanResult != VK_SUCCESS && data != NULL) {
+        // The driver didn't like the data, start over with an empty cache
+        pipelineCacheCreateInfo.initialDataSize = 0;
+        pipelineCacheCreateInfo.pInitialData = NULL;
+
+        vulkanResult = renderer->vkCreatePipelineCache(
+            renderer->logicalDevice,
+            &pipelineCacheCreateInfo,
+            NULL,
+            &renderer->pipelineCache);
+    }
+
+    if (vulkanResult != VK_SUCCESS) {
+        // Not fatal, pipelines just won't be cached
+        renderer->pipelineCache = VK_NULL_HANDLE;
+    }
+}
+
+static void *VULKAN_GetPipelineCacheData(
+    SDL_GPURenderer *driverData,
+    size_t *size)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VkResult vulkanResult;
+    size_t dataSize = 0;
+    void *data;
+
+    if (renderer->pipelineCache == VK_NULL_HANDLE) {
+        SET_STRING_ERROR_AND_RETURN("Pipeline cache is not available", NULL);
+    }
+
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        &dataSize,
+        NULL);
+    CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetPipelineCacheData, NULL);
+
+    data = SDL_malloc(dataSize);
+    if (data == NULL) {
+        return NULL;
+    }
+
+    // The cache may grow between the two calls, in which case we get a partial but valid blob
+    vulkanResult = renderer->vkGetPipelineCacheData(
+        renderer->logicalDevice,
+        renderer->pipelineCache,
+        &dataSize,
+        data);
+    if (vulkanResult != VK_SUCCESS && vulkanResult != VK_INCOMPLETE) {
+        SDL_free(data);
+        CHECK_VULKAN_ERROR_AND_RETURN(vulkanResult, vkGetPipelineCacheData, NULL);
+    }
+
+    *size = dataSize;
+    return data;
+}
+
+// Memory Stats
+
+static SDL_GPUMemoryHeapStats *VULKAN_GetMemoryStats(
+    SDL_GPURenderer *driverData,
+    int *count)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    Uint32 heapCount = renderer->memoryProperties.memoryHeapCount;
+    SDL_GPUMemoryHeapStats *stats;
+    SDL_GPUMemoryHeapStats *heap;
+    VulkanMemorySubAllocator *allocator;
+    VulkanMemoryAllocation *allocation;
+    VkDeviceSize budget, usage;
+
+    stats = (SDL_GPUMemoryHeapStats *)SDL_calloc(heapCount, sizeof(SDL_GPUMemoryHeapStats));
+    if (!stats) {
+        return NULL;
+    }
+
+    for (Uint32 i = 0; i < heapCount; i += 1) {
+        stats[i].heap_size = renderer->memoryProperties.memoryHeaps[i].size;
+        stats[i].device_local = (renderer->memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+    }
+
+    SDL_LockMutex(renderer->allocatorLock);
+
+    for (Uint32 i = 0; i < renderer->memoryProperties.memoryTypeCount; i += 1) {
+        allocator = &renderer->memoryAllocator->subAllocators[i];
+        heap = &stats[renderer->memoryProperties.memoryTypes[i].heapIndex];
+
+        for (Uint32 j = 0; j < allocator->allocationCount; j += 1) {
+            allocation = allocator->allocations[j];
+
+            heap->allocated_bytes += allocation->size;
+            heap->used_bytes += allocation->usedSpace;
+            heap->block_count += 1;
+            heap->resource_count += allocation->usedRegionCount;
+            heap->free_region_count += allocation->freeRegionCount;
+
+            for (Uint32 k = 0; k < allocation->freeRegionCount; k += 1) {
+                heap->largest_free_region = SDL_max(heap->largest_free_region, allocation->freeRegions[k]->size);
+            }
+        }
+    }
+
+    for (Uint32 i = 0; i < renderer->allocationsToDefragCount; i += 1) {
+        allocation = renderer->allocationsToDefrag[i];
+        stats[renderer->memoryProperties.memoryTypes[allocation->allocator->memoryTypeIndex].heapIndex].defrag_block_count += 1;
+    }
+
+    SDL_UnlockMutex(renderer->allocatorLock);
+
+    for (Uint32 i = 0; i < heapCount; i += 1) {
+        if (VULKAN_INTERNAL_GetHeapBudget(renderer, i, &budget, &usage)) {
+            stats[i].budget = budget;
+            stats[i].usage = usage;
+        } else {
+            stats[i].usage = stats[i].allocated_bytes;
+        }
+    }
+
+    *count = (int)heapCount;
+    return stats;
+}
+
+// Bindless Textures
+
+static Uint32 VULKAN_GetBindlessTextureCapacity(
+    SDL_GPURenderer *driverData)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    return renderer->bindlessTextureCapacity;
+}
+
+static bool VULKAN_AddBindlessTexture(
+    SDL_GPURenderer *driverData,
+    const SDL_GPUTextureSamplerBinding *binding,
+    Uint32 *index)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+    VulkanTextureContainer *textureContainer = (VulkanTextureContainer *)binding->texture;
+    VkDescriptorImageInfo imageInfo;
+    VkWriteDescriptorSet writeDescriptorSet;
+    Uint32 slot;
+
+    if (renderer->bindlessTextureCapacity == 0) {
+        SET_STRING_ERROR_AND_RETURN("Bindless textures are not enabled on this device", false);
+    }
+
+    SDL_LockMutex(renderer->bindlessLock);
+
+    if (renderer->bindlessFreeSlotCount == 0) {
+        SDL_UnlockMutex(renderer->bindlessLock);
+        SET_STRING_ERROR_AND_RETURN("Bindless texture array is full", false);
+    }
+
+    renderer->bindlessFreeSlotCount -= 1;
+    slot = renderer->bindlessFreeSlots[renderer->bindlessFreeSlotCount];
+    renderer->bindlessSlotUsed[slot] = true;
+
+    imageInfo.sampler = ((VulkanSampler *)binding->sampler)->sampler;
+    imageInfo.imageView = textureContainer->activeTexture->fullView;
+    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    writeDescriptorSet.pNext = NULL;
+    writeDescriptorSet.dstSet = renderer->bindlessDescriptorSet;
+    writeDescriptorSet.dstBinding = 0;
+    writeDescriptorSet.dstArrayElement = slot;
+    writeDescriptorSet.descriptorCount = 1;
+    writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    writeDescriptorSet.pImageInfo = &imageInfo;
+    writeDescriptorSet.pBufferInfo = NULL;
+    writeDescriptorSet.pTexelBufferView = NULL;
+
+    // Update-after-bind lets this happen while other slots are in use by the GPU
+    renderer->vkUpdateDescriptorSets(
+        renderer->logicalDevice,
+        1,
+        &writeDescriptorSet,
+        0,
+        NULL);
+
+    SDL_UnlockMutex(renderer->bindlessLock);
+
+    *index = slot;
+    return true;
+}
+
+static void VULKAN_RemoveBindlessTexture(
+    SDL_GPURenderer *driverData,
+    Uint32 index)
+{
+    VulkanRenderer *renderer = (VulkanRenderer *)driverData;
+
+    if (index >= renderer->bindlessTextureCapacity) {
+        return;
+    }
+
+    SDL_LockMutex(renderer->bindlessLock);
+
+    // Freeing a slot twice would overflow the free list and hand the slot out twice
+    if (!renderer->bindlessSlotUsed[index]) {
+        SDL_UnlockMutex(renderer->bindlessLock);
+        SDL_assert(!"Bindless texture slot is not in use!");
+        SDL_SetError("Bindless texture slot %" SDL_PRIu32 " is not in use", index);
+        return;
+    }
+
+    renderer->bindlessSlotUsed[index] = false;
+    renderer->bindlessFreeSlots[renderer->bindlessFreeSlotCount] = index;
+    renderer->bindlessFreeSlotCount += 1;
+    SDL_UnlockMutex(renderer->bindlessLock);
+}
+
 static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, SDL_PropertiesID props)
 {
     VulkanRenderer *renderer;
@@ -11616,7 +12948,8 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
     }
 
     if (!VULKAN_INTERNAL_CreateLogicalDevice(
-            renderer)) {
+            renderer,
+            (Uint32)SDL_GetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_BINDLESS_TEXTURES_NUMBER, 0))) {
         SDL_free(renderer);
         SDL_Vulkan_UnloadLibrary();
         SET_STRING_ERROR_AND_RETURN("Failed to create logical device!", NULL);
@@ -11644,6 +12977,7 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
     renderer->submitLock = SDL_CreateMutex();
     renderer->acquireCommandBufferLock = SDL_CreateMutex();
     renderer->acquireUniformBufferLock = SDL_CreateMutex();
+    renderer->acquireTransientBufferLock = SDL_CreateMutex();
     renderer->framebufferFetchLock = SDL_CreateMutex();
     renderer->windowLock = SDL_CreateMutex();
 
@@ -11683,12 +13017,33 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
             UNIFORM_BUFFER_SIZE);
     }
 
+    // Transient buffers are created on first use
+
+    renderer->transientBufferPoolCount = 0;
+    renderer->transientBufferPoolCapacity = 4;
+    renderer->transientBufferPool = SDL_malloc(
+        renderer->transientBufferPoolCapacity * sizeof(VulkanTransientBuffer *));
+
     renderer->descriptorSetCachePoolCapacity = 8;
     renderer->descriptorSetCachePoolCount = 0;
     renderer->descriptorSetCachePool = SDL_calloc(renderer->descriptorSetCachePoolCapacity, sizeof(DescriptorSetCache *));
 
     SDL_SetAtomicInt(&renderer->layoutResourceID, 0);
 
+    // Pipeline cache
+
+    VULKAN_INTERNAL_CreatePipelineCache(renderer, props);
+
+    // Bindless textures
+
+    renderer->bindlessLock = SDL_CreateMutex();
+
+    if (renderer->bindlessTextureCapacity > 0 &&
+        !VULKAN_INTERNAL_CreateBindlessDescriptorSet(renderer)) {
+        SDL_LogWarn(SDL_LOG_CATEGORY_GPU, "Failed to create bindless texture array: %s", SDL_GetError());
+        VULKAN_INTERNAL_DestroyBindlessDescriptorSet(renderer);
+    }
+
     // Device limits
 
     renderer->minUBOAlignment = (Uint32)renderer->physicalDeviceProperties.properties.limits.minUniformBufferOffsetAlignment;
@@ -11808,9 +13163,16 @@ static SDL_GPUDevice *VULKAN_CreateDevice(bool debugMode, bool preferLowPower, S
         sizeof(VulkanFramebuffer *) *
         renderer->framebuffersToDestroyCapacity);
 
+    renderer->queryPoolsToDestroyCapacity = 4;
+    renderer->queryPoolsToDestroyCount = 0;
+    renderer->queryPoolsToDestroy = SDL_malloc(
+        sizeof(VulkanQueryPool *) *
+        renderer->queryPoolsToDestroyCapacity);
+
     // Defrag state
 
     renderer->defragInProgress = 0;
+    renderer->defragBudgetNS = SDL_MS_TO_NS((Uint64)SDL_GetNumberProperty(props, SDL_PROP_GPU_DEVICE_CREATE_VULKAN_DEFRAG_BUDGET_MS_NUMBER, 0));
 
     renderer->allocationsToDefragCount = 0;
     renderer->allocationsToDefragCapacity = 4;
@@ -51,7 +51,9 @@ VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceImageFormatProperties)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties)
 
-// VK_KHR_get_physical_device_properties2, needed for KHR_driver_properties
+// VK_KHR_get_physical_device_properties2, needed for KHR_driver_properties, EXT_descriptor_indexing and EXT_memory_budget
+VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceFeatures2KHR)
+VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceMemoryProperties2KHR)
 VULKAN_INSTANCE_FUNCTION(vkGetPhysicalDeviceProperties2KHR)
 
 // VK_KHR_surface
@@ -102,13 +104,16 @@ VULKAN_DEVICE_FUNCTION(vkCmdDrawIndexed)
 VULKAN_DEVICE_FUNCTION(vkCmdDrawIndexedIndirect)
 VULKAN_DEVICE_FUNCTION(vkCmdDrawIndirect)
 VULKAN_DEVICE_FUNCTION(vkCmdEndRenderPass)
+VULKAN_DEVICE_FUNCTION(vkCmdExecuteCommands)
 VULKAN_DEVICE_FUNCTION(vkCmdPipelineBarrier)
+VULKAN_DEVICE_FUNCTION(vkCmdResetQueryPool)
 VULKAN_DEVICE_FUNCTION(vkCmdResolveImage)
 VULKAN_DEVICE_FUNCTION(vkCmdSetBlendConstants)
 VULKAN_DEVICE_FUNCTION(vkCmdSetDepthBias)
 VULKAN_DEVICE_FUNCTION(vkCmdSetScissor)
 VULKAN_DEVICE_FUNCTION(vkCmdSetStencilReference)
 VULKAN_DEVICE_FUNCTION(vkCmdSetViewport)
+VULKAN_DEVICE_FUNCTION(vkCmdWriteTimestamp)
 VULKAN_DEVICE_FUNCTION(vkCreateBuffer)
 VULKAN_DEVICE_FUNCTION(vkCreateCommandPool)
 VULKAN_DEVICE_FUNCTION(vkCreateDescriptorPool)
@@ -121,6 +126,7 @@ VULKAN_DEVICE_FUNCTION(vkCreateImage)
 VULKAN_DEVICE_FUNCTION(vkCreateImageView)
 VULKAN_DEVICE_FUNCTION(vkCreatePipelineCache)
 VULKAN_DEVICE_FUNCTION(vkCreatePipelineLayout)
+VULKAN_DEVICE_FUNCTION(vkCreateQueryPool)
 VULKAN_DEVICE_FUNCTION(vkCreateRenderPass)
 VULKAN_DEVICE_FUNCTION(vkCreateSampler)
 VULKAN_DEVICE_FUNCTION(vkCreateSemaphore)
@@ -137,6 +143,7 @@ VULKAN_DEVICE_FUNCTION(vkDestroyImageView)
 VULKAN_DEVICE_FUNCTION(vkDestroyPipeline)
 VULKAN_DEVICE_FUNCTION(vkDestroyPipelineCache)
 VULKAN_DEVICE_FUNCTION(vkDestroyPipelineLayout)
+VULKAN_DEVICE_FUNCTION(vkDestroyQueryPool)
 VULKAN_DEVICE_FUNCTION(vkDestroyRenderPass)
 VULKAN_DEVICE_FUNCTION(vkDestroySampler)
 VULKAN_DEVICE_FUNCTION(vkDestroySemaphore)
@@ -147,6 +154,7 @@ VULKAN_DEVICE_FUNCTION(vkFreeCommandBuffers)
 VULKAN_DEVICE_FUNCTION(vkFreeMemory)
 VULKAN_DEVICE_FUNCTION(vkGetDeviceQueue)
 VULKAN_DEVICE_FUNCTION(vkGetPipelineCacheData)
+VULKAN_DEVICE_FUNCTION(vkGetQueryPoolResults)
 VULKAN_DEVICE_FUNCTION(vkGetFenceStatus)
 VULKAN_DEVICE_FUNCTION(vkGetBufferMemoryRequirements)
 VULKAN_DEVICE_FUNCTION(vkGetImageMemoryRequirements)
@@ -22,23 +22,24 @@
 #include "SDL_internal.h"
 #include "../SDL_main_callbacks.h"
 #include "../../video/SDL_sysvideo.h"
+#include "../../timer/SDL_timer_c.h"
 
 #ifndef SDL_PLATFORM_IOS
 
-static int callback_rate_increment = 0;
+static SDL_FramePacer callback_pacer;
 static bool iterate_after_waitevent = false;
 
 static void SDLCALL MainCallbackRateHintChanged(void *userdata, const char *name, const char *oldValue, const char *newValue)
 {
     iterate_after_waitevent = newValue && (SDL_strcmp(newValue, "waitevent") == 0);
     if (iterate_after_waitevent) {
-        callback_rate_increment = 0;
+        SDL_SetFramePacerPeriod(&callback_pacer, 0);
     } else {
         const int callback_rate = newValue ? SDL_atoi(newValue) : 0;
         if (callback_rate > 0) {
-            callback_rate_increment = ((Uint64) 1000000000) / ((Uint64) callback_rate);
+            SDL_SetFramePacerPeriod(&callback_pacer, SDL_NS_PER_SECOND / (Uint64)callback_rate);
         } else {
-            callback_rate_increment = 0;
+            SDL_SetFramePacerPeriod(&callback_pacer, 0);
         }
     }
 }
@@ -57,7 +58,8 @@ int SDL_EnterAppMainCallbacks(int argc, char* argv[], SDL_AppInit_func appinit,
     if (rc == 0) {
         SDL_AddHintCallback(SDL_HINT_MAIN_CALLBACK_RATE, MainCallbackRateHintChanged, NULL);
 
-        Uint64 next_iteration = callback_rate_increment ? (SDL_GetTicksNS() + callback_rate_increment) : 0;
+        // Start the pacing timeline now, so the first iteration is paced too
+        SDL_WaitFramePacer(&callback_pacer);
 
         while ((rc = GenericIterateMainCallbacks()) == SDL_APP_CONTINUE) {
             // !!! FIXME: this can be made more complicated if we decide to
@@ -73,20 +75,15 @@ int SDL_EnterAppMainCallbacks(int argc, char* argv[], SDL_AppInit_func appinit,
             //  vsync in common cases, and won't be restrained to vsync if the
             //  app is doing a benchmark or doesn't want to be, based on how
             // they've set up that window.
-            if (callback_rate_increment == 0) {
-                next_iteration = 0; // just clear the timer and run at the pace the video subsystem allows.
-            } else {
-                const Uint64 now = SDL_GetTicksNS();
-                if (next_iteration > now) {  // Running faster than the limit, sleep a little.
-                    SDL_DelayPrecise(next_iteration - now);
-                } else {
-                    next_iteration = now;  // if running behind, reset the timer. If right on time, `next_iteration` already equals `now`.
-                }
-                next_iteration += callback_rate_increment;
-            }
+            // If no rate is set, this returns right away and we run at the pace the video subsystem allows.
+            SDL_WaitFramePacer(&callback_pacer);
         }
 
         SDL_RemoveHintCallback(SDL_HINT_MAIN_CALLBACK_RATE, MainCallbackRateHintChanged, NULL);
+
+        if (callback_pacer.stats.frames > 0 && SDL_GetHintBoolean("SDL_FRAME_PACER_STATISTICS", false)) {
+            SDL_LogFramePacerStats(&callback_pacer, "main callbacks");
+        }
     }
     SDL_QuitMainCallbacks(rc);
 
@@ -45,6 +45,12 @@ this should probably be removed at some point in the future.  --ryan. */
 #define DONT_DRAW_WHILE_HIDDEN 0
 #endif
 
+// How many items of SDL_RenderTextureBatch() are sent to the backend in one draw
+#define SDL_RENDER_BATCH_MAX_ITEMS 4096
+
+// How far back a draw command can be moved when reordering commands by state
+#define SDL_RENDER_REORDER_WINDOW 256
+
 #define SDL_PROP_WINDOW_RENDERER_POINTER "SDL.internal.window.renderer"
 #define SDL_PROP_TEXTURE_PARENT_POINTER "SDL.internal.texture.parent"
 
@@ -305,6 +311,229 @@ static SDL_INLINE void DebugLogRenderCommands(const SDL_RenderCommand *cmd)
 #endif
 }
 
+static bool IsDrawCommand(const SDL_RenderCommand *cmd)
+{
+    switch (cmd->command) {
+    case SDL_RENDERCMD_DRAW_POINTS:
+    case SDL_RENDERCMD_DRAW_LINES:
+    case SDL_RENDERCMD_FILL_RECTS:
+    case SDL_RENDERCMD_COPY:
+    case SDL_RENDERCMD_COPY_EX:
+    case SDL_RENDERCMD_GEOMETRY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Two draws can be merged into one batch by the backend if they only differ by their vertices
+static bool SameDrawState(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    return a->command == b->command &&
+           a->data.draw.texture == b->data.draw.texture &&
+           a->data.draw.blend == b->data.draw.blend &&
+           a->data.draw.texture_address_mode == b->data.draw.texture_address_mode &&
+           a->data.draw.quads == b->data.draw.quads &&
+           a->data.draw.color_scale == b->data.draw.color_scale &&
+           a->data.draw.color.r == b->data.draw.color.r &&
+           a->data.draw.color.g == b->data.draw.color.g &&
+           a->data.draw.color.b == b->data.draw.color.b &&
+           a->data.draw.color.a == b->data.draw.color.a;
+}
+
+static bool DrawCommandsOverlap(const SDL_RenderCommand *a, const SDL_RenderCommand *b)
+{
+    const SDL_FRect *A = &a->data.draw.bounds;
+    const SDL_FRect *B = &b->data.draw.bounds;
+
+    if (!a->data.draw.has_bounds || !b->data.draw.has_bounds) {
+        return true;
+    }
+    return (A->x < B->x + B->w) && (B->x < A->x + A->w) &&
+           (A->y < B->y + B->h) && (B->y < A->y + A->h);
+}
+
+// The largest alignment (up to 16 bytes) that an offset in the vertex buffer is known to satisfy
+static size_t GetVertexOffsetAlignment(size_t offset)
+{
+    size_t alignment = 16;
+    while (alignment > 1 && (offset & (alignment - 1)) != 0) {
+        alignment >>= 1;
+    }
+    return alignment;
+}
+
+/* Sort a run of draw commands, which share a viewport, clip rect and draw color, so draws with
+   the same state end up next to each other. A command is only moved in front of commands it
+   doesn't overlap, so the final image is unchanged. The vertex data is repacked to match the
+   new order, so backends that merge adjacent draws with contiguous vertices can batch them. */
+static void ReorderDrawCommandRun(SDL_Renderer *renderer, SDL_RenderCommand *prev, SDL_RenderCommand *first, int count)
+{
+    SDL_RenderCommand **list;
+    SDL_RenderCommand *next;
+    SDL_RenderCommand *cmd;
+    size_t vertex_start = 0, vertex_offset;
+    bool have_vertices = false;
+    bool reordered = false;
+    int i, j, num_sorted;
+
+    if (count > renderer->reorder_list_allocation) {
+        int new_allocation = SDL_max(renderer->reorder_list_allocation * 2, 128);
+        while (new_allocation < count) {
+            new_allocation *= 2;
+        }
+        list = (SDL_RenderCommand **)SDL_realloc(renderer->reorder_list, new_allocation * sizeof(*list));
+        if (!list) {
+            SDL_ClearError();  // this is only an optimization, just run the commands as they are.
+            return;
+        }
+        renderer->reorder_list = list;
+        renderer->reorder_list_allocation = new_allocation;
+    }
+    list = renderer->reorder_list;
+
+    // Insertion pass: move each draw back next to the last draw with the same state, if nothing in between overlaps it.
+    num_sorted = 0;
+    cmd = first;
+    for (i = 0; i < count; ++i, cmd = cmd->next) {
+        int insert_at = num_sorted;
+        for (j = num_sorted - 1; j >= 0 && (num_sorted - j) <= SDL_RENDER_REORDER_WINDOW; --j) {
+            if (SameDrawState(list[j], cmd)) {
+                insert_at = j + 1;
+                break;
+            }
+            if (DrawCommandsOverlap(list[j], cmd)) {
+                break;
+            }
+        }
+        if (insert_at < num_sorted) {
+            SDL_memmove(&list[insert_at + 1], &list[insert_at], (num_sorted - insert_at) * sizeof(*list));
+            reordered = true;
+        }
+        list[insert_at] = cmd;
+        ++num_sorted;
+
+        if (cmd->data.draw.vertex_bytes) {
+            if (!have_vertices || cmd->data.draw.first < vertex_start) {
+                vertex_start = cmd->data.draw.first;
+            }
+            have_vertices = true;
+        }
+    }
+    next = cmd;
+
+    if (!reordered) {
+        return;
+    }
+
+    if (have_vertices) {
+        Uint8 *vertices;
+        Uint8 *dst;
+
+        // Make sure every draw keeps the alignment its backend asked for, otherwise leave this run alone.
+        vertex_offset = vertex_start;
+        for (i = 0; i < count; ++i) {
+            cmd = list[i];
+            if (cmd->data.draw.vertex_bytes) {
+                if ((vertex_offset & (GetVertexOffsetAlignment(cmd->data.draw.first) - 1)) != 0) {
+                    return;
+                }
+                vertex_offset += cmd->data.draw.vertex_bytes;
+            }
+        }
+
+        if (renderer->reorder_vertex_data_allocation < (vertex_offset - vertex_start)) {
+            const size_t needed = vertex_offset - vertex_start;
+            void *ptr = SDL_realloc(renderer->reorder_vertex_data, needed);
+            if (!ptr) {
+                SDL_ClearError();  // this is only an optimization, just run the commands as they are.
+                return;
+            }
+            renderer->reorder_vertex_data = ptr;
+            renderer->reorder_vertex_data_allocation = needed;
+        }
+
+        vertices = (Uint8 *)renderer->vertex_data;
+        dst = (Uint8 *)renderer->reorder_vertex_data;
+        vertex_offset = vertex_start;
+        for (i = 0; i < count; ++i) {
+            cmd = list[i];
+            if (cmd->data.draw.vertex_bytes) {
+                SDL_memcpy(dst, vertices + cmd->data.draw.first, cmd->data.draw.vertex_bytes);
+                dst += cmd->data.draw.vertex_bytes;
+                cmd->data.draw.first = vertex_offset;
+                vertex_offset += cmd->data.draw.vertex_bytes;
+            }
+        }
+        SDL_memcpy(vertices + vertex_start, renderer->reorder_vertex_data, vertex_offset - vertex_start);
+    }
+
+    // Relink the commands in their new order
+    if (prev) {
+        prev->next = list[0];
+    } else {
+        renderer->render_commands = list[0];
+    }
+    for (i = 0; i < count - 1; ++i) {
+        list[i]->next = list[i + 1];
+    }
+    list[count - 1]->next = next;
+    if (!next) {
+        renderer->render_commands_tail = list[count - 1];
+    }
+}
+
+static void ReorderRenderCommands(SDL_Renderer *renderer)
+{
+    SDL_RenderCommand *prev = NULL;
+    SDL_RenderCommand *cmd = renderer->render_commands;
+
+    while (cmd) {
+        if (IsDrawCommand(cmd)) {
+            SDL_RenderCommand *first = cmd;
+            SDL_RenderCommand *last = cmd;
+            int count = 1;
+
+            while (last->next && IsDrawCommand(last->next)) {
+                last = last->next;
+                ++count;
+            }
+            if (count > 2) {
+                ReorderDrawCommandRun(renderer, prev, first, count);
+
+                // The run may have been relinked, find the last command in it again.
+                last = prev ? prev->next : renderer->render_commands;
+                while (--count > 0) {
+                    last = last->next;
+                }
+            }
+            prev = last;
+            cmd = last->next;
+        } else {
+            prev = cmd;
+            cmd = cmd->next;
+        }
+    }
+}
+
+// Count how many draws were queued and how many batches the backend is expected to merge them into
+static void CountRenderBatches(SDL_Renderer *renderer)
+{
+    const SDL_RenderCommand *prev = NULL;
+    const SDL_RenderCommand *cmd;
+
+    for (cmd = renderer->render_commands; cmd; cmd = cmd->next) {
+        if (IsDrawCommand(cmd)) {
+            ++renderer->frame_draw_commands;
+            if (!prev || !IsDrawCommand(prev) || !SameDrawState(prev, cmd) ||
+                (prev->data.draw.vertex_bytes && (prev->data.draw.first + prev->data.draw.vertex_bytes) != cmd->data.draw.first)) {
+                ++renderer->frame_draw_batches;
+            }
+        }
+        prev = cmd;
+    }
+}
+
 static bool FlushRenderCommands(SDL_Renderer *renderer)
 {
     bool result;
@@ -316,6 +545,12 @@ static bool FlushRenderCommands(SDL_Renderer *renderer)
         return true;
     }
 
+    // The statistics are only kept when reordering, so the common path doesn't walk the queue again
+    if (renderer->reorder_commands) {
+        ReorderRenderCommands(renderer);
+        CountRenderBatches(renderer);
+    }
+
     DebugLogRenderCommands(renderer->render_commands);
 
     result = renderer->RunCommandQueue(renderer, renderer->render_commands, renderer->vertex_data, renderer->vertex_data_used);
@@ -572,19 +807,65 @@ static SDL_RenderCommand *PrepQueueCmdDraw(SDL_Renderer *renderer, const SDL_Ren
             cmd->data.draw.blend = blendMode;
             cmd->data.draw.texture = texture;
             cmd->data.draw.texture_address_mode = SDL_TEXTURE_ADDRESS_CLAMP;
+            cmd->data.draw.vertex_bytes = 0;
+            cmd->data.draw.has_bounds = false;
+            cmd->data.draw.quads = false;
         }
     }
     return cmd;
 }
 
+// Remember how much of the vertex buffer the backend used for this draw, so it can be moved around later.
+static void FinishQueueCmdDraw(SDL_Renderer *renderer, SDL_RenderCommand *cmd, size_t vertex_start)
+{
+    if (renderer->vertex_data_used > vertex_start) {
+        cmd->data.draw.vertex_bytes = renderer->vertex_data_used - cmd->data.draw.first;
+    }
+}
+
+static void SetDrawCommandBounds(SDL_RenderCommand *cmd, float minx, float miny, float maxx, float maxy)
+{
+    if (!(minx <= maxx) || !(miny <= maxy)) {
+        return;  // empty or not a number, treat it as touching everything.
+    }
+
+    // Pad by a pixel to cover rounding and texture filtering at the edges
+    cmd->data.draw.has_bounds = true;
+    cmd->data.draw.bounds.x = minx - 1.0f;
+    cmd->data.draw.bounds.y = miny - 1.0f;
+    cmd->data.draw.bounds.w = (maxx - minx) + 2.0f;
+    cmd->data.draw.bounds.h = (maxy - miny) + 2.0f;
+}
+
+static void SetDrawCommandBoundsFromRects(SDL_RenderCommand *cmd, const SDL_FRect *rects, int count)
+{
+    float minx, miny, maxx, maxy;
+    int i;
+
+    minx = rects[0].x;
+    miny = rects[0].y;
+    maxx = rects[0].x + rects[0].w;
+    maxy = rects[0].y + rects[0].h;
+    for (i = 1; i < count; ++i) {
+        minx = SDL_min(minx, rects[i].x);
+        miny = SDL_min(miny, rects[i].y);
+        maxx = SDL_max(maxx, rects[i].x + rects[i].w);
+        maxy = SDL_max(maxy, rects[i].y + rects[i].h);
+    }
+    SetDrawCommandBounds(cmd, minx, miny, maxx, maxy);
+}
+
 static bool QueueCmdDrawPoints(SDL_Renderer *renderer, const SDL_FPoint *points, const int count)
 {
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_POINTS, NULL);
     bool result = false;
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
         result = renderer->QueueDrawPoints(renderer, cmd, points, count);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            FinishQueueCmdDraw(renderer, cmd, vertex_start);
         }
     }
     return result;
@@ -595,9 +876,12 @@ static bool QueueCmdDrawLines(SDL_Renderer *renderer, const SDL_FPoint *points,
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_DRAW_LINES, NULL);
     bool result = false;
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
         result = renderer->QueueDrawLines(renderer, cmd, points, count);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            FinishQueueCmdDraw(renderer, cmd, vertex_start);
         }
     }
     return result;
@@ -612,6 +896,8 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
     cmd = PrepQueueCmdDraw(renderer, (use_rendergeometry ? SDL_RENDERCMD_GEOMETRY : SDL_RENDERCMD_FILL_RECTS), NULL);
 
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
+
         if (use_rendergeometry) {
             bool isstack1;
             bool isstack2;
@@ -672,6 +958,13 @@ static bool QueueCmdFillRects(SDL_Renderer *renderer, const SDL_FRect *rects, co
                 cmd->command = SDL_RENDERCMD_NO_OP;
             }
         }
+
+        if (result) {
+            FinishQueueCmdDraw(renderer, cmd, vertex_start);
+            if (renderer->reorder_commands) {
+                SetDrawCommandBoundsFromRects(cmd, rects, count);
+            }
+        }
     }
     return result;
 }
@@ -681,9 +974,15 @@ static bool QueueCmdCopy(SDL_Renderer *renderer, SDL_Texture *texture, const SDL
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_COPY, texture);
     bool result = false;
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
         result = renderer->QueueCopy(renderer, cmd, texture, srcrect, dstrect);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            FinishQueueCmdDraw(renderer, cmd, vertex_start);
+            if (renderer->reorder_commands) {
+                SetDrawCommandBoundsFromRects(cmd, dstrect, 1);
+            }
         }
     }
     return result;
@@ -696,9 +995,22 @@ static bool QueueCmdCopyEx(SDL_Renderer *renderer, SDL_Texture *texture,
     SDL_RenderCommand *cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_COPY_EX, texture);
     bool result = false;
     if (cmd) {
+        const size_t vertex_start = renderer->vertex_data_used;
         result = renderer->QueueCopyEx(renderer, cmd, texture, srcquad, dstrect, angle, center, flip, scale_x, scale_y);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            FinishQueueCmdDraw(renderer, cmd, vertex_start);
+            if (renderer->reorder_commands) {
+                // Any rotation stays inside the circle around the center that touches the farthest corner
+                const float dx = SDL_max(center->x, dstrect->w - center->x);
+                const float dy = SDL_max(center->y, dstrect->h - center->y);
+                const float radius = SDL_sqrtf(dx * dx + dy * dy);
+                const float cx = dstrect->x + center->x;
+                const float cy = dstrect->y + center->y;
+                SetDrawCommandBounds(cmd, (cx - radius) * scale_x, (cy - radius) * scale_y,
+                                     (cx + radius) * scale_x, (cy + radius) * scale_y);
+            }
         }
     }
     return result;
@@ -717,6 +1029,7 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
     cmd = PrepQueueCmdDraw(renderer, SDL_RENDERCMD_GEOMETRY, texture);
     if (cmd) {
         cmd->data.draw.texture_address_mode = texture_address_mode;
+        const size_t vertex_start = renderer->vertex_data_used;
         result = renderer->QueueGeometry(renderer, cmd, texture,
                                          xy, xy_stride,
                                          color, color_stride, uv, uv_stride,
@@ -724,6 +1037,21 @@ static bool QueueCmdGeometry(SDL_Renderer *renderer, SDL_Texture *texture,
                                          scale_x, scale_y);
         if (!result) {
             cmd->command = SDL_RENDERCMD_NO_OP;
+        } else {
+            FinishQueueCmdDraw(renderer, cmd, vertex_start);
+            if (renderer->reorder_commands && num_vertices > 0) {
+                const float *v = xy;
+                float minx = v[0], miny = v[1], maxx = v[0], maxy = v[1];
+                int i;
+                for (i = 1; i < num_vertices; ++i) {
+                    v = (const float *)((const Uint8 *)xy + i * xy_stride);
+                    minx = SDL_min(minx, v[0]);
+                    miny = SDL_min(miny, v[1]);
+                    maxx = SDL_max(maxx, v[0]);
+                    maxy = SDL_max(maxy, v[1]);
+                }
+                SetDrawCommandBounds(cmd, minx * scale_x, miny * scale_y, maxx * scale_x, maxy * scale_y);
+            }
         }
     }
     return result;
@@ -947,7 +1275,7 @@ static void SDL_CalculateSimulatedVSyncInterval(SDL_Renderer *renderer, SDL_Wind
         refresh_den = 1;
     }
     // Flip numerator and denominator to change from framerate to interval
-    renderer->simulate_vsync_interval_ns = (SDL_NS_PER_SECOND * refresh_den) / refresh_num;
+    SDL_SetFramePacerPeriod(&renderer->simulate_vsync_pacer, (SDL_NS_PER_SECOND * refresh_den) / refresh_num);
 }
 
 #endif // !SDL_RENDER_DISABLED
@@ -1046,6 +1374,12 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
 
     VerifyDrawQueueFunctions(renderer);
 
+    // This has to happen after picking a driver, a failed driver attempt zeroes the renderer
+    if (!SDL_GetPropertyKey(SDL_PROP_TEXTURE_PARENT_POINTER, &renderer->texture_parent_key) ||
+        !SDL_GetPropertyKey(SDL_PROP_WINDOW_SHAPE_POINTER, &renderer->window_shape_key)) {
+        goto error;
+    }
+
     renderer->window = window;
     renderer->target_mutex = SDL_CreateMutex();
     if (surface) {
@@ -1077,6 +1411,8 @@ SDL_Renderer *SDL_CreateRendererWithProperties(SDL_PropertiesID props)
         renderer->line_method = SDL_GetRenderLineMethod();
     }
 
+    renderer->reorder_commands = SDL_GetHintBoolean(SDL_HINT_RENDER_REORDER_COMMANDS, false);
+
     renderer->SDR_white_point = 1.0f;
     renderer->HDR_headroom = 1.0f;
     renderer->desired_color_scale = 1.0f;
@@ -2541,7 +2877,7 @@ SDL_Texture *SDL_GetRenderTarget(SDL_Renderer *renderer)
     if (!renderer->target) {
         return NULL;
     }
-    return (SDL_Texture *) SDL_GetPointerProperty(SDL_GetTextureProperties(renderer->target), SDL_PROP_TEXTURE_PARENT_POINTER, renderer->target);
+    return (SDL_Texture *) SDL_GetPointerPropertyByKey(SDL_GetTextureProperties(renderer->target), &renderer->texture_parent_key, renderer->target);
 }
 
 static void UpdateLogicalPresentation(SDL_Renderer *renderer)
@@ -4176,6 +4512,232 @@ bool SDL_RenderTextureRotated(SDL_Renderer *renderer, SDL_Texture *texture,
     return result;
 }
 
+// Clip an item's srcrect to the texture and shrink its dstrect by the same fraction, returns false if nothing is left
+static bool SDL_ClipTextureBatchItem(const SDL_TextureBatchItem *item, const SDL_FRect *texture_rect, SDL_FRect *srcrect, SDL_FRect *dstrect)
+{
+    float scale_x, scale_y;
+
+    if (!SDL_GetRectIntersectionFloat(&item->srcrect, texture_rect, srcrect)) {
+        return false;
+    }
+
+    scale_x = item->dstrect.w / item->srcrect.w;
+    scale_y = item->dstrect.h / item->srcrect.h;
+    dstrect->x = item->dstrect.x + (srcrect->x - item->srcrect.x) * scale_x;
+    dstrect->y = item->dstrect.y + (srcrect->y - item->srcrect.y) * scale_y;
+    dstrect->w = srcrect->w * scale_x;
+    dstrect->h = srcrect->h * scale_y;
+    return true;
+}
+
+// Used when the renderer can't take the whole batch as geometry, or the software renderer can blit the items directly
+static bool SDL_RenderTextureBatch_Loop(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureBatchItem *items, int count)
+{
+    SDL_Texture *draw_texture = texture->native ? texture->native : texture;
+    const SDL_FColor color = draw_texture->color;
+    SDL_FRect texture_rect;
+    bool result = true;
+    int i;
+
+    texture_rect.x = 0.0f;
+    texture_rect.y = 0.0f;
+    texture_rect.w = (float)texture->w;
+    texture_rect.h = (float)texture->h;
+
+    for (i = 0; i < count; ++i) {
+        const SDL_TextureBatchItem *item = &items[i];
+        SDL_FRect srcrect, dstrect;
+        SDL_FPoint center;
+
+        if (!SDL_ClipTextureBatchItem(item, &texture_rect, &srcrect, &dstrect)) {
+            continue;
+        }
+
+        // Still rotate around the center of the unclipped dstrect
+        center.x = item->dstrect.x + item->dstrect.w / 2.0f - dstrect.x;
+        center.y = item->dstrect.y + item->dstrect.h / 2.0f - dstrect.y;
+
+        draw_texture->color.r = color.r * item->color.r;
+        draw_texture->color.g = color.g * item->color.g;
+        draw_texture->color.b = color.b * item->color.b;
+        draw_texture->color.a = color.a * item->color.a;
+        if (!SDL_RenderTextureRotated(renderer, texture, &srcrect, &dstrect, item->angle, &center, SDL_FLIP_NONE)) {
+            result = false;
+            break;
+        }
+    }
+    draw_texture->color = color;
+
+    return result;
+}
+
+bool SDL_RenderTextureBatch(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_TextureBatchItem *items, int count)
+{
+    const int max_items = SDL_min(count, SDL_RENDER_BATCH_MAX_ITEMS);
+    const int xy_stride = 2 * sizeof(float);
+    const int uv_stride = 2 * sizeof(float);
+    const int color_stride = sizeof(SDL_FColor);
+    SDL_FRect texture_rect;
+    float *xy, *uv;
+    SDL_FColor *colors;
+    int *indices;
+    double last_angle = 0.0;
+    float s = 0.0f, c = 1.0f;
+    bool result = true;
+    int i, num_items;
+
+    CHECK_RENDERER_MAGIC(renderer, false);
+    CHECK_TEXTURE_MAGIC(texture, false);
+
+    if (renderer != texture->renderer) {
+        return SDL_SetError("Texture was not created with this renderer");
+    }
+    if (!items) {
+        return SDL_InvalidParamError("items");
+    }
+    if (count < 1) {
+        return true;
+    }
+
+#if DONT_DRAW_WHILE_HIDDEN
+    // Don't draw while we're hidden
+    if (renderer->hidden) {
+        return true;
+    }
+#endif
+
+    if (!renderer->QueueGeometry || renderer->software) {
+        return SDL_RenderTextureBatch_Loop(renderer, texture, items, count);
+    }
+
+    texture_rect.x = 0.0f;
+    texture_rect.y = 0.0f;
+    texture_rect.w = (float)texture->w;
+    texture_rect.h = (float)texture->h;
+
+    if (texture->native) {
+        texture = texture->native;
+    }
+
+    xy = (float *)SDL_malloc(max_items * (4 * xy_stride + 4 * uv_stride + 4 * color_stride + 6 * sizeof(int)));
+    if (!xy) {
+        return false;
+    }
+    uv = xy + max_items * 4 * 2;
+    colors = (SDL_FColor *)(uv + max_items * 4 * 2);
+    indices = (int *)(colors + max_items * 4);
+
+    texture->last_command_generation = renderer->render_command_generation;
+
+    num_items = 0;
+    for (i = 0; i < count; ++i) {
+        const SDL_TextureBatchItem *item = &items[i];
+        float *pxy = &xy[num_items * 4 * 2];
+        float *puv = &uv[num_items * 4 * 2];
+        SDL_FColor *pcolor = &colors[num_items * 4];
+        int *pindex = &indices[num_items * 6];
+        const int cur_index = num_items * 4;
+        SDL_FRect srcrect, dstrect;
+        SDL_FColor color;
+        float minu, minv, maxu, maxv;
+        float minx, miny, maxx, maxy;
+        int j;
+
+        if (!SDL_ClipTextureBatchItem(item, &texture_rect, &srcrect, &dstrect)) {
+            continue;
+        }
+
+        minu = srcrect.x / texture->w;
+        minv = srcrect.y / texture->h;
+        maxu = (srcrect.x + srcrect.w) / texture->w;
+        maxv = (srcrect.y + srcrect.h) / texture->h;
+        puv[0] = minu;
+        puv[1] = minv;
+        puv[2] = maxu;
+        puv[3] = minv;
+        puv[4] = maxu;
+        puv[5] = maxv;
+        puv[6] = minu;
+        puv[7] = maxv;
+
+        minx = dstrect.x;
+        miny = dstrect.y;
+        maxx = dstrect.x + dstrect.w;
+        maxy = dstrect.y + dstrect.h;
+        if (item->angle == 0.0) {
+            pxy[0] = minx;
+            pxy[1] = miny;
+            pxy[2] = maxx;
+            pxy[3] = miny;
+            pxy[4] = maxx;
+            pxy[5] = maxy;
+            pxy[6] = minx;
+            pxy[7] = maxy;
+        } else {
+            const float centerx = item->dstrect.x + item->dstrect.w / 2.0f;
+            const float centery = item->dstrect.y + item->dstrect.h / 2.0f;
+
+            // Particles often share an angle, only recalculate the rotation when it changes
+            if (item->angle != last_angle) {
+                const float radian_angle = (float)((SDL_PI_D * item->angle) / 180.0);
+                s = SDL_sinf(radian_angle);
+                c = SDL_cosf(radian_angle);
+                last_angle = item->angle;
+            }
+
+            minx -= centerx;
+            miny -= centery;
+            maxx -= centerx;
+            maxy -= centery;
+
+            /* apply rotation with 2x2 matrix ( c -s )
+             *                                ( s  c ) */
+            pxy[0] = (c * minx - s * miny) + centerx;
+            pxy[1] = (s * minx + c * miny) + centery;
+            pxy[2] = (c * maxx - s * miny) + centerx;
+            pxy[3] = (s * maxx + c * miny) + centery;
+            pxy[4] = (c * maxx - s * maxy) + centerx;
+            pxy[5] = (s * maxx + c * maxy) + centery;
+            pxy[6] = (c * minx - s * maxy) + centerx;
+            pxy[7] = (s * minx + c * maxy) + centery;
+        }
+
+        color.r = texture->color.r * item->color.r;
+        color.g = texture->color.g * item->color.g;
+        color.b = texture->color.b * item->color.b;
+        color.a = texture->color.a * item->color.a;
+        for (j = 0; j < 4; ++j) {
+            pcolor[j] = color;
+        }
+        for (j = 0; j < 6; ++j) {
+            pindex[j] = cur_index + rect_index_order[j];
+        }
+
+        if (++num_items == max_items) {
+            result = QueueCmdGeometry(renderer, texture,
+                                      xy, xy_stride, colors, color_stride, uv, uv_stride,
+                                      num_items * 4, indices, num_items * 6, sizeof(int),
+                                      renderer->view->current_scale.x, renderer->view->current_scale.y,
+                                      SDL_TEXTURE_ADDRESS_CLAMP);
+            if (!result) {
+                break;
+            }
+            num_items = 0;
+        }
+    }
+    if (result && num_items > 0) {
+        result = QueueCmdGeometry(renderer, texture,
+                                  xy, xy_stride, colors, color_stride, uv, uv_stride,
+                                  num_items * 4, indices, num_items * 6, sizeof(int),
+                                  renderer->view->current_scale.x, renderer->view->current_scale.y,
+                                  SDL_TEXTURE_ADDRESS_CLAMP);
+    }
+
+    SDL_free(xy);
+
+    return result;
+}
+
 static bool SDL_RenderTextureTiled_Wrap(SDL_Renderer *renderer, SDL_Texture *texture, const SDL_FRect *srcrect, float scale, const SDL_FRect *dstrect)
 {
     float xy[8];
@@ -5013,7 +5575,7 @@ SDL_Surface *SDL_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
 
 static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
 {
-    SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerProperty(SDL_GetWindowProperties(renderer->window), SDL_PROP_WINDOW_SHAPE_POINTER, NULL);
+    SDL_Surface *shape = (SDL_Surface *)SDL_GetPointerPropertyByKey(SDL_GetWindowProperties(renderer->window), &renderer->window_shape_key, NULL);
     if (shape != renderer->shape_surface) {
         if (renderer->shape_texture) {
             SDL_DestroyTexture(renderer->shape_texture);
@@ -5039,29 +5601,7 @@ static void SDL_RenderApplyWindowShape(SDL_Renderer *renderer)
 
 static void SDL_SimulateRenderVSync(SDL_Renderer *renderer)
 {
-    Uint64 now, elapsed;
-    const Uint64 interval = renderer->simulate_vsync_interval_ns;
-
-    if (!interval) {
-        // We can't do sub-ns delay, so just return here
-        return;
-    }
-
-    now = SDL_GetTicksNS();
-    elapsed = (now - renderer->last_present);
-    if (elapsed < interval) {
-        Uint64 duration = (interval - elapsed);
-        SDL_DelayPrecise(duration);
-        now = SDL_GetTicksNS();
-    }
-
-    elapsed = (now - renderer->last_present);
-    if (!renderer->last_present || elapsed > SDL_MS_TO_NS(1000)) {
-        // It's been too long, reset the presentation timeline
-        renderer->last_present = now;
-    } else {
-        renderer->last_present += (elapsed / interval) * interval;
-    }
+    SDL_WaitFramePacer(&renderer->simulate_vsync_pacer);
 }
 
 bool SDL_RenderPresent(SDL_Renderer *renderer)
@@ -5083,6 +5623,14 @@ bool SDL_RenderPresent(SDL_Renderer *renderer)
 
     FlushRenderCommands(renderer); // time to send everything to the GPU!
 
+    if (renderer->reorder_commands) {
+        SDL_PropertiesID props = SDL_GetRendererProperties(renderer);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_DRAW_COMMANDS_NUMBER, renderer->frame_draw_commands);
+        SDL_SetNumberProperty(props, SDL_PROP_RENDERER_DRAW_BATCHES_NUMBER, renderer->frame_draw_batches);
+        renderer->frame_draw_commands = 0;
+        renderer->frame_draw_batches = 0;
+    }
+
 #if DONT_DRAW_WHILE_HIDDEN
     // Don't present while we're hidden
     if (renderer->hidden) {
@@ -5191,6 +5739,10 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
 
     renderer->destroyed = true;
 
+    if (renderer->simulate_vsync_pacer.stats.frames > 0 && SDL_GetHintBoolean("SDL_FRAME_PACER_STATISTICS", false)) {
+        SDL_LogFramePacerStats(&renderer->simulate_vsync_pacer, "renderer vsync");
+    }
+
     SDL_RemoveEventWatch(SDL_RendererEventWatch, renderer);
 
     if (renderer->window) {
@@ -5227,6 +5779,14 @@ void SDL_DestroyRendererWithoutFreeing(SDL_Renderer *renderer)
         SDL_free(renderer->vertex_data);
         renderer->vertex_data = NULL;
     }
+    if (renderer->reorder_list) {
+        SDL_free(renderer->reorder_list);
+        renderer->reorder_list = NULL;
+    }
+    if (renderer->reorder_vertex_data) {
+        SDL_free(renderer->reorder_vertex_data);
+        renderer->reorder_vertex_data = NULL;
+    }
     if (renderer->texture_formats) {
         SDL_free(renderer->texture_formats);
         renderer->texture_formats = NULL;
@@ -23,7 +23,9 @@
 #ifndef SDL_sysrender_h_
 #define SDL_sysrender_h_
 
+#include "../SDL_properties_c.h"
 #include "../video/SDL_surface_c.h"
+#include "../timer/SDL_timer_c.h"
 
 #include "SDL_yuv_sw_c.h"
 
@@ -149,6 +151,10 @@ typedef struct SDL_RenderCommand
             SDL_BlendMode blend;
             SDL_Texture *texture;
             SDL_TextureAddressMode texture_address_mode;
+            size_t vertex_bytes;    // bytes used in the shared vertex buffer, starting at `first`.
+            bool has_bounds;        // true if `bounds` is valid, used when reordering draws.
+            SDL_FRect bounds;       // the area touched by this draw, in pixels relative to the viewport.
+            bool quads;             // set by the backend if `count` vertices are independent quads, 4 vertices each with no indices.
         } draw;
         struct
         {
@@ -245,8 +251,7 @@ struct SDL_Renderer
     // Whether we should simulate vsync
     bool wanted_vsync;
     bool simulate_vsync;
-    Uint64 simulate_vsync_interval_ns;
-    Uint64 last_present;
+    SDL_FramePacer simulate_vsync_pacer;
 
     // Support for logical output coordinates
     SDL_RendererLogicalPresentation logical_presentation_mode;
@@ -298,6 +303,15 @@ struct SDL_Renderer
     size_t vertex_data_used;
     size_t vertex_data_allocation;
 
+    // Support for reordering draw commands by state before they are run
+    bool reorder_commands;
+    SDL_RenderCommand **reorder_list;
+    int reorder_list_allocation;
+    void *reorder_vertex_data;
+    size_t reorder_vertex_data_allocation;
+    Sint64 frame_draw_commands;
+    Sint64 frame_draw_batches;
+
     // Shaped window support
     bool transparent_window;
     SDL_Surface *shape_surface;
@@ -305,6 +319,10 @@ struct SDL_Renderer
 
     SDL_PropertiesID props;
 
+    // Property keys looked up on every frame
+    SDL_PropertyKey texture_parent_key;
+    SDL_PropertyKey window_shape_key;
+
     SDL_Texture *debug_char_texture_atlas;
 
     bool destroyed;   // already destroyed by SDL_DestroyWindow; just free this struct in SDL_DestroyRenderer.
@@ -82,17 +82,34 @@ static void NukePipelineCacheEntry(const void *key, const void *value, void *dat
 
 bool GPU_InitPipelineCache(GPU_PipelineCache *cache, SDL_GPUDevice *device)
 {
+    SDL_zerop(cache);
+
     // FIXME how many buckets do we need?
     cache->table = SDL_CreateHashTable(device, 32, HashPassthrough, MatchPipelineCacheKey, NukePipelineCacheEntry, false, true);
     if (!cache->table) {
         return false;
     }
+
+    // Only contended while a prebuild thread is running
+    cache->lock = SDL_CreateMutex();
+    if (!cache->lock) {
+        SDL_DestroyHashTable(cache->table);
+        cache->table = NULL;
+        return false;
+    }
     return true;
 }
 
 void GPU_DestroyPipelineCache(GPU_PipelineCache *cache)
 {
+    if (cache->prebuild_thread) {
+        SDL_SetAtomicInt(&cache->prebuild_cancel, 1);
+        SDL_WaitThread(cache->prebuild_thread, NULL);
+        cache->prebuild_thread = NULL;
+    }
+
     SDL_DestroyHashTable(cache->table);
+    SDL_DestroyMutex(cache->lock);
 }
 
 static SDL_GPUGraphicsPipeline *MakePipeline(SDL_GPUDevice *device, GPU_Shaders *shaders, const GPU_PipelineParameters *params)
@@ -192,34 +209,164 @@ static GPU_PipelineCacheKey MakePipelineCacheKey(const GPU_PipelineParameters *p
     return key;
 }
 
-SDL_GPUGraphicsPipeline *GPU_GetPipeline(GPU_PipelineCache *cache, GPU_Shaders *shaders, SDL_GPUDevice *device, const GPU_PipelineParameters *params)
+// The cache lock must be held
+static SDL_GPUGraphicsPipeline *FindPipeline(GPU_PipelineCache *cache, const GPU_PipelineCacheKey *key)
 {
-    GPU_PipelineCacheKey key = MakePipelineCacheKey(params);
-    void *keyval = (void *)(uintptr_t)HashPipelineCacheKey(&key);
-    SDL_GPUGraphicsPipeline *pipeline = NULL;
-
+    void *keyval = (void *)(uintptr_t)HashPipelineCacheKey(key);
     void *iter = NULL;
     GPU_PipelineCacheEntry *entry = NULL;
 
     while (SDL_IterateHashTableKey(cache->table, keyval, (const void **)&entry, &iter)) {
-        if (entry->key.as_uint64 == key.as_uint64) {
+        if (entry->key.as_uint64 == key->as_uint64) {
             return entry->pipeline;
         }
     }
+    return NULL;
+}
 
-    pipeline = MakePipeline(device, shaders, params);
+// Pipelines are built outside of the lock, so whoever gets there first wins and the other copy is released
+static SDL_GPUGraphicsPipeline *InsertPipeline(GPU_PipelineCache *cache, SDL_GPUDevice *device, const GPU_PipelineCacheKey *key, SDL_GPUGraphicsPipeline *pipeline)
+{
+    void *keyval = (void *)(uintptr_t)HashPipelineCacheKey(key);
+    SDL_GPUGraphicsPipeline *existing;
+    GPU_PipelineCacheEntry *entry;
 
-    if (pipeline == NULL) {
-        return NULL;
+    SDL_LockMutex(cache->lock);
+
+    existing = FindPipeline(cache, key);
+    if (existing) {
+        SDL_UnlockMutex(cache->lock);
+        SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
+        return existing;
     }
 
     entry = SDL_malloc(sizeof(*entry));
-    entry->key = key;
+    if (!entry) {
+        SDL_UnlockMutex(cache->lock);
+        SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
+        return NULL;
+    }
+    entry->key = *key;
     entry->pipeline = pipeline;
 
     SDL_InsertIntoHashTable(cache->table, keyval, entry);
 
+    SDL_UnlockMutex(cache->lock);
+
     return pipeline;
 }
 
+SDL_GPUGraphicsPipeline *GPU_GetPipeline(GPU_PipelineCache *cache, GPU_Shaders *shaders, SDL_GPUDevice *device, const GPU_PipelineParameters *params)
+{
+    GPU_PipelineCacheKey key = MakePipelineCacheKey(params);
+    SDL_GPUGraphicsPipeline *pipeline = NULL;
+
+    SDL_LockMutex(cache->lock);
+    pipeline = FindPipeline(cache, &key);
+    SDL_UnlockMutex(cache->lock);
+
+    if (pipeline) {
+        return pipeline;
+    }
+
+    pipeline = MakePipeline(device, shaders, params);
+
+    if (pipeline == NULL) {
+        return NULL;
+    }
+
+    return InsertPipeline(cache, device, &key, pipeline);
+}
+
+static int SDLCALL PrebuildPipelinesThread(void *userdata)
+{
+    // Every shader combination the renderer draws with, see Draw() in SDL_render_gpu.c
+    static const struct
+    {
+        GPU_VertexShaderID vert_shader;
+        GPU_FragmentShaderID frag_shader;
+        SDL_GPUPrimitiveType primitive_type;
+    } combos[] = {
+        { VERT_SHADER_TRI_TEXTURE, FRAG_SHADER_TEXTURE_RGBA, SDL_GPU_PRIMITIVETYPE_TRIANGLELIST },
+        { VERT_SHADER_TRI_TEXTURE, FRAG_SHADER_TEXTURE_RGB, SDL_GPU_PRIMITIVETYPE_TRIANGLELIST },
+        { VERT_SHADER_TRI_COLOR, FRAG_SHADER_COLOR, SDL_GPU_PRIMITIVETYPE_TRIANGLELIST },
+        { VERT_SHADER_LINEPOINT, FRAG_SHADER_COLOR, SDL_GPU_PRIMITIVETYPE_LINELIST },
+        { VERT_SHADER_LINEPOINT, FRAG_SHADER_COLOR, SDL_GPU_PRIMITIVETYPE_LINESTRIP },
+        { VERT_SHADER_LINEPOINT, FRAG_SHADER_COLOR, SDL_GPU_PRIMITIVETYPE_POINTLIST },
+    };
+    static const SDL_BlendMode blend_modes[] = {
+        SDL_BLENDMODE_BLEND,
+        SDL_BLENDMODE_NONE,
+        SDL_BLENDMODE_BLEND_PREMULTIPLIED,
+        SDL_BLENDMODE_ADD,
+        SDL_BLENDMODE_ADD_PREMULTIPLIED,
+        SDL_BLENDMODE_MOD,
+        SDL_BLENDMODE_MUL,
+    };
+    GPU_PipelineCache *cache = (GPU_PipelineCache *)userdata;
+    int i, j, k;
+
+    // Most likely to be used first goes first: the first format, then blend mode, then shader
+    for (i = 0; i < cache->num_prebuild_formats; ++i) {
+        for (j = 0; j < SDL_arraysize(blend_modes); ++j) {
+            for (k = 0; k < SDL_arraysize(combos); ++k) {
+                GPU_PipelineParameters params;
+                GPU_PipelineCacheKey key;
+                SDL_GPUGraphicsPipeline *pipeline;
+                bool found;
+
+                if (SDL_GetAtomicInt(&cache->prebuild_cancel)) {
+                    return 0;
+                }
+
+                SDL_zero(params);
+                params.blend_mode = blend_modes[j];
+                params.vert_shader = combos[k].vert_shader;
+                params.frag_shader = combos[k].frag_shader;
+                params.attachment_format = cache->prebuild_formats[i];
+                params.primitive_type = combos[k].primitive_type;
+
+                key = MakePipelineCacheKey(&params);
+                SDL_LockMutex(cache->lock);
+                found = (FindPipeline(cache, &key) != NULL);
+                SDL_UnlockMutex(cache->lock);
+                if (found) {
+                    continue;
+                }
+
+                pipeline = MakePipeline(cache->prebuild_device, cache->prebuild_shaders, &params);
+                if (pipeline) {
+                    InsertPipeline(cache, cache->prebuild_device, &key, pipeline);
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+bool GPU_PrebuildPipelines(GPU_PipelineCache *cache, GPU_Shaders *shaders, SDL_GPUDevice *device, const SDL_GPUTextureFormat *formats, int num_formats)
+{
+    int i;
+
+    if (cache->prebuild_thread) {
+        return true; // already running
+    }
+
+    cache->prebuild_device = device;
+    cache->prebuild_shaders = shaders;
+    cache->num_prebuild_formats = 0;
+    for (i = 0; i < num_formats && cache->num_prebuild_formats < SDL_arraysize(cache->prebuild_formats); ++i) {
+        if (formats[i] != SDL_GPU_TEXTUREFORMAT_INVALID) {
+            cache->prebuild_formats[cache->num_prebuild_formats++] = formats[i];
+        }
+    }
+    SDL_SetAtomicInt(&cache->prebuild_cancel, 0);
+
+    cache->prebuild_thread = SDL_CreateThread(PrebuildPipelinesThread, "SDLPipelinePrebuild", cache);
+    if (!cache->prebuild_thread) {
+        return false;
+    }
+    return true;
+}
+
 #endif // SDL_VIDEO_RENDER_GPU
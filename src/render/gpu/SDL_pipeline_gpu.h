@@ -38,10 +38,20 @@ typedef struct GPU_PipelineParameters
 typedef struct GPU_PipelineCache
 {
     SDL_HashTable *table;
+    SDL_Mutex *lock;
+
+    // Background prebuild state
+    SDL_Thread *prebuild_thread;
+    SDL_AtomicInt prebuild_cancel;
+    SDL_GPUDevice *prebuild_device;
+    GPU_Shaders *prebuild_shaders;
+    SDL_GPUTextureFormat prebuild_formats[4];
+    int num_prebuild_formats;
 } GPU_PipelineCache;
 
 extern bool GPU_InitPipelineCache(GPU_PipelineCache *cache, SDL_GPUDevice *device);
 extern void GPU_DestroyPipelineCache(GPU_PipelineCache *cache);
 extern SDL_GPUGraphicsPipeline *GPU_GetPipeline(GPU_PipelineCache *cache, GPU_Shaders *shaders, SDL_GPUDevice *device, const GPU_PipelineParameters *params);
+extern bool GPU_PrebuildPipelines(GPU_PipelineCache *cache, GPU_Shaders *shaders, SDL_GPUDevice *device, const SDL_GPUTextureFormat *formats, int num_formats);
 
 #endif // SDL_pipeline_gpu_h_
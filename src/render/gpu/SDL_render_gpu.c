@@ -29,6 +29,9 @@
 #include "SDL_pipeline_gpu.h"
 #include "SDL_shaders_gpu.h"
 
+// Quads are drawn from a shared index buffer, 16-bit indices cover this many per draw call
+#define MAX_QUADS_PER_DRAW 16384
+
 typedef struct GPU_ShaderUniformData
 {
     Float4X4 mvp;
@@ -63,6 +66,8 @@ typedef struct GPU_RenderData
         Uint32 buffer_size;
     } vertices;
 
+    SDL_GPUBuffer *quad_indices;
+
     struct
     {
         SDL_GPURenderPass *render_pass;
@@ -121,17 +126,44 @@ static SDL_GPUTextureFormat PixFormatToTexFormat(SDL_PixelFormat pixel_format)
     case SDL_PIXELFORMAT_RGBX32:
         return SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
 
-    // YUV TODO
+    // Expanded to 32 bits per pixel while uploading, see GetUploadFormat()
+    case SDL_PIXELFORMAT_BGR24:
+        return SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM;
+    case SDL_PIXELFORMAT_RGB24:
+#ifdef SDL_HAVE_YUV
     case SDL_PIXELFORMAT_YV12:
     case SDL_PIXELFORMAT_IYUV:
     case SDL_PIXELFORMAT_NV12:
     case SDL_PIXELFORMAT_NV21:
+#endif
+        return SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM;
+
     case SDL_PIXELFORMAT_UYVY:
     default:
         return SDL_GPU_TEXTUREFORMAT_INVALID;
     }
 }
 
+/* The pixel layout that is written into the transfer buffer. Formats the GPU
+ * can't sample directly are converted straight into the mapped buffer, which
+ * saves the temporary conversion buffer SDL_render would otherwise need.
+ */
+static SDL_PixelFormat GetUploadFormat(SDL_PixelFormat pixel_format)
+{
+    switch (pixel_format) {
+    case SDL_PIXELFORMAT_BGR24:
+        return SDL_PIXELFORMAT_BGRA32;
+    case SDL_PIXELFORMAT_RGB24:
+    case SDL_PIXELFORMAT_YV12:
+    case SDL_PIXELFORMAT_IYUV:
+    case SDL_PIXELFORMAT_NV12:
+    case SDL_PIXELFORMAT_NV21:
+        return SDL_PIXELFORMAT_RGBA32;
+    default:
+        return pixel_format;
+    }
+}
+
 static SDL_PixelFormat TexFormatToPixFormat(SDL_GPUTextureFormat tex_format)
 {
     switch (tex_format) {
@@ -187,7 +219,8 @@ static bool GPU_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_
         return false;
     }
 
-    if (texture->access == SDL_TEXTUREACCESS_STREAMING) {
+    // YUV textures keep a copy of their planes so partial updates can be converted as a whole
+    if (texture->access == SDL_TEXTUREACCESS_STREAMING || SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
         size_t size;
         data->pitch = texture->w * SDL_BYTESPERPIXEL(texture->format);
         size = (size_t)texture->h * data->pitch;
@@ -241,12 +274,13 @@ static bool GPU_CreateTexture(SDL_Renderer *renderer, SDL_Texture *texture, SDL_
     return true;
 }
 
-static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
-                              const SDL_Rect *rect, const void *pixels, int pitch)
+static bool UploadTexture(SDL_Renderer *renderer, SDL_Texture *texture,
+                          const SDL_Rect *rect, const void *pixels, int pitch)
 {
     GPU_RenderData *renderdata = (GPU_RenderData *)renderer->internal;
     GPU_TextureData *data = (GPU_TextureData *)texture->internal;
-    const Uint32 texturebpp = SDL_BYTESPERPIXEL(texture->format);
+    const SDL_PixelFormat upload_format = GetUploadFormat(texture->format);
+    const Uint32 texturebpp = SDL_BYTESPERPIXEL(upload_format);
 
     size_t row_size, data_size;
 
@@ -268,7 +302,15 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
 
     Uint8 *output = SDL_MapGPUTransferBuffer(renderdata->device, tbuf, false);
 
-    if ((size_t)pitch == row_size) {
+    if (upload_format != texture->format) {
+        if (!SDL_ConvertPixelsAndColorspace(rect->w, rect->h,
+                                            texture->format, texture->colorspace, 0, pixels, pitch,
+                                            upload_format, SDL_COLORSPACE_SRGB, 0, output, (int)row_size)) {
+            SDL_UnmapGPUTransferBuffer(renderdata->device, tbuf);
+            SDL_ReleaseGPUTransferBuffer(renderdata->device, tbuf);
+            return false;
+        }
+    } else if ((size_t)pitch == row_size) {
         SDL_memcpy(output, pixels, data_size);
     } else {
         // FIXME is negative pitch supposed to work?
@@ -309,6 +351,94 @@ static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
     return true;
 }
 
+#ifdef SDL_HAVE_YUV
+static void CopyPlane(Uint8 *dst, int dst_pitch, const Uint8 *src, int src_pitch, int row_size, int rows)
+{
+    for (int i = 0; i < rows; ++i) {
+        SDL_memcpy(dst, src, row_size);
+        dst += dst_pitch;
+        src += src_pitch;
+    }
+}
+
+// YUV can't be converted a rectangle at a time in place, so refresh the whole texture from the plane copy
+static bool UploadYUVTexture(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    GPU_TextureData *data = (GPU_TextureData *)texture->internal;
+    SDL_Rect full_rect = { 0, 0, texture->w, texture->h };
+
+    return UploadTexture(renderer, texture, &full_rect, data->pixels, data->pitch);
+}
+
+static bool GPU_UpdateTextureYUV(SDL_Renderer *renderer, SDL_Texture *texture,
+                                 const SDL_Rect *rect,
+                                 const Uint8 *Yplane, int Ypitch,
+                                 const Uint8 *Uplane, int Upitch,
+                                 const Uint8 *Vplane, int Vpitch)
+{
+    GPU_TextureData *data = (GPU_TextureData *)texture->internal;
+    const int uv_pitch = (data->pitch + 1) / 2;
+    Uint8 *planes = (Uint8 *)data->pixels;
+    Uint8 *uplane = planes + texture->h * data->pitch;
+    Uint8 *vplane = uplane + ((texture->h + 1) / 2) * uv_pitch;
+
+    if (texture->format == SDL_PIXELFORMAT_YV12) {
+        Uint8 *tmp = uplane;
+        uplane = vplane;
+        vplane = tmp;
+    }
+
+    CopyPlane(planes + rect->y * data->pitch + rect->x, data->pitch, Yplane, Ypitch, rect->w, rect->h);
+    CopyPlane(uplane + (rect->y / 2) * uv_pitch + rect->x / 2, uv_pitch, Uplane, Upitch, (rect->w + 1) / 2, (rect->h + 1) / 2);
+    CopyPlane(vplane + (rect->y / 2) * uv_pitch + rect->x / 2, uv_pitch, Vplane, Vpitch, (rect->w + 1) / 2, (rect->h + 1) / 2);
+
+    return UploadYUVTexture(renderer, texture);
+}
+
+static bool GPU_UpdateTextureNV(SDL_Renderer *renderer, SDL_Texture *texture,
+                                const SDL_Rect *rect,
+                                const Uint8 *Yplane, int Ypitch,
+                                const Uint8 *UVplane, int UVpitch)
+{
+    GPU_TextureData *data = (GPU_TextureData *)texture->internal;
+    const int uv_pitch = 2 * ((data->pitch + 1) / 2);
+    Uint8 *planes = (Uint8 *)data->pixels;
+    Uint8 *uvplane = planes + texture->h * data->pitch;
+
+    CopyPlane(planes + rect->y * data->pitch + rect->x, data->pitch, Yplane, Ypitch, rect->w, rect->h);
+    CopyPlane(uvplane + (rect->y / 2) * uv_pitch + 2 * (rect->x / 2), uv_pitch, UVplane, UVpitch, 2 * ((rect->w + 1) / 2), (rect->h + 1) / 2);
+
+    return UploadYUVTexture(renderer, texture);
+}
+#endif // SDL_HAVE_YUV
+
+static bool GPU_UpdateTexture(SDL_Renderer *renderer, SDL_Texture *texture,
+                              const SDL_Rect *rect, const void *pixels, int pitch)
+{
+#ifdef SDL_HAVE_YUV
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        // The planes follow each other, laid out for the rectangle being updated
+        const Uint8 *Yplane = (const Uint8 *)pixels;
+        const Uint8 *UVplane = Yplane + rect->h * pitch;
+
+        if (texture->format == SDL_PIXELFORMAT_NV12 || texture->format == SDL_PIXELFORMAT_NV21) {
+            return GPU_UpdateTextureNV(renderer, texture, rect, Yplane, pitch, UVplane, 2 * ((pitch + 1) / 2));
+        } else {
+            const int uv_pitch = (pitch + 1) / 2;
+            const Uint8 *first = UVplane;
+            const Uint8 *second = UVplane + ((rect->h + 1) / 2) * uv_pitch;
+
+            if (texture->format == SDL_PIXELFORMAT_YV12) {
+                return GPU_UpdateTextureYUV(renderer, texture, rect, Yplane, pitch, second, uv_pitch, first, uv_pitch);
+            }
+            return GPU_UpdateTextureYUV(renderer, texture, rect, Yplane, pitch, first, uv_pitch, second, uv_pitch);
+        }
+    }
+#endif
+
+    return UploadTexture(renderer, texture, rect, pixels, pitch);
+}
+
 static bool GPU_LockTexture(SDL_Renderer *renderer, SDL_Texture *texture,
                             const SDL_Rect *rect, void **pixels, int *pitch)
 {
@@ -328,6 +458,14 @@ static void GPU_UnlockTexture(SDL_Renderer *renderer, SDL_Texture *texture)
     const SDL_Rect *rect;
     void *pixels;
 
+#ifdef SDL_HAVE_YUV
+    if (SDL_ISPIXELFORMAT_FOURCC(texture->format)) {
+        // The app wrote straight into the plane copy
+        UploadYUVTexture(renderer, texture);
+        return;
+    }
+#endif
+
     rect = &data->locked_rect;
     pixels =
         (void *)((Uint8 *)data->pixels + rect->y * data->pitch +
@@ -386,6 +524,33 @@ static bool GPU_QueueDrawPoints(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
     return true;
 }
 
+// Check for the 0,1,2,0,2,3 pattern that copies, filled rects and texture batches use for every quad
+static bool IsQuadList(int num_vertices, const void *indices, int num_indices, int size_indices)
+{
+    static const int quad_index_order[] = { 0, 1, 2, 0, 2, 3 };
+    int i;
+
+    if (!indices || num_vertices == 0 || num_vertices % 4 != 0 || num_indices != (num_vertices / 4) * 6) {
+        return false;
+    }
+
+    for (i = 0; i < num_indices; i++) {
+        int j;
+        if (size_indices == 4) {
+            j = ((const Uint32 *)indices)[i];
+        } else if (size_indices == 2) {
+            j = ((const Uint16 *)indices)[i];
+        } else {
+            j = ((const Uint8 *)indices)[i];
+        }
+
+        if (j != (i / 6) * 4 + quad_index_order[i % 6]) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static bool GPU_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL_Texture *texture,
                               const float *xy, int xy_stride, const SDL_FColor *color, int color_stride, const float *uv, int uv_stride,
                               int num_vertices, const void *indices, int num_indices, int size_indices,
@@ -398,6 +563,14 @@ static bool GPU_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SD
     const float color_scale = cmd->data.draw.color_scale;
     bool convert_color = SDL_RenderingLinearSpace(renderer);
 
+    /* Quads only need their 4 corners uploaded, the index buffer expands them to
+       triangles on the GPU. That's a third less vertex data to build and upload. */
+    if (IsQuadList(num_vertices, indices, num_indices, size_indices)) {
+        cmd->data.draw.quads = true;
+        count = num_vertices;
+        indices = NULL;
+    }
+
     verts = (float *)SDL_AllocateRenderVertices(renderer, count * sz, 0, &cmd->data.draw.first);
     if (!verts) {
         return false;
@@ -587,7 +760,24 @@ static void Draw(
 
     SDL_BindGPUVertexBuffers(pass, 0, &buffer_bind, 1);
     PushUniforms(data, cmd);
-    SDL_DrawGPUPrimitives(data->state.render_pass, num_verts, 1, 0, 0);
+
+    if (cmd->data.draw.quads) {
+        Uint32 num_quads = num_verts / 4;
+        Uint32 first_quad = 0;
+
+        SDL_GPUBufferBinding index_bind;
+        SDL_zero(index_bind);
+        index_bind.buffer = data->quad_indices;
+        SDL_BindGPUIndexBuffer(pass, &index_bind, SDL_GPU_INDEXELEMENTSIZE_16BIT);
+
+        while (first_quad < num_quads) {
+            Uint32 n = SDL_min(num_quads - first_quad, MAX_QUADS_PER_DRAW);
+            SDL_DrawGPUIndexedPrimitives(pass, n * 6, 1, 0, (Sint32)(first_quad * 4), 0);
+            first_quad += n;
+        }
+    } else {
+        SDL_DrawGPUPrimitives(data->state.render_pass, num_verts, 1, 0, 0);
+    }
 }
 
 static void ReleaseVertexBuffer(GPU_RenderData *data)
@@ -630,6 +820,73 @@ static bool InitVertexBuffer(GPU_RenderData *data, Uint32 size)
     return true;
 }
 
+static bool InitQuadIndexBuffer(GPU_RenderData *data)
+{
+    const Uint32 size = MAX_QUADS_PER_DRAW * 6 * sizeof(Uint16);
+
+    SDL_GPUBufferCreateInfo bci;
+    SDL_zero(bci);
+    bci.size = size;
+    bci.usage = SDL_GPU_BUFFERUSAGE_INDEX;
+
+    data->quad_indices = SDL_CreateGPUBuffer(data->device, &bci);
+
+    if (!data->quad_indices) {
+        return false;
+    }
+
+    SDL_GPUTransferBufferCreateInfo tbci;
+    SDL_zero(tbci);
+    tbci.size = size;
+    tbci.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+
+    SDL_GPUTransferBuffer *transfer_buf = SDL_CreateGPUTransferBuffer(data->device, &tbci);
+
+    if (!transfer_buf) {
+        return false;
+    }
+
+    Uint16 *indices = (Uint16 *)SDL_MapGPUTransferBuffer(data->device, transfer_buf, false);
+    if (!indices) {
+        SDL_ReleaseGPUTransferBuffer(data->device, transfer_buf);
+        return false;
+    }
+    for (Uint32 i = 0; i < MAX_QUADS_PER_DRAW; ++i) {
+        const Uint16 base = (Uint16)(i * 4);
+        *(indices++) = base + 0;
+        *(indices++) = base + 1;
+        *(indices++) = base + 2;
+        *(indices++) = base + 0;
+        *(indices++) = base + 2;
+        *(indices++) = base + 3;
+    }
+    SDL_UnmapGPUTransferBuffer(data->device, transfer_buf);
+
+    SDL_GPUCopyPass *pass = SDL_BeginGPUCopyPass(data->state.command_buffer);
+
+    if (!pass) {
+        SDL_ReleaseGPUTransferBuffer(data->device, transfer_buf);
+        return false;
+    }
+
+    SDL_GPUTransferBufferLocation src;
+    SDL_zero(src);
+    src.transfer_buffer = transfer_buf;
+
+    SDL_GPUBufferRegion dst;
+    SDL_zero(dst);
+    dst.buffer = data->quad_indices;
+    dst.size = size;
+
+    SDL_UploadToGPUBuffer(pass, &src, &dst, false);
+    SDL_EndGPUCopyPass(pass);
+
+    // The pending upload keeps the transfer buffer alive until it's done
+    SDL_ReleaseGPUTransferBuffer(data->device, transfer_buf);
+
+    return true;
+}
+
 static bool UploadVertices(GPU_RenderData *data, void *vertices, size_t vertsize)
 {
     if (vertsize == 0) {
@@ -798,6 +1055,8 @@ static bool GPU_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd,
                 } else if (nextcmd->data.draw.texture != thistexture || nextcmd->data.draw.blend != thisblend) {
                     // FIXME should we check address mode too?
                     break; // can't go any further on this draw call, different texture/blendmode copy up next.
+                } else if (nextcmd->data.draw.quads != cmd->data.draw.quads) {
+                    break; // can't go any further on this draw call, quads are drawn indexed.
                 } else {
                     finalcmd = nextcmd; // we can combine copy operations here. Mark this one as the furthest okay command.
                     count += (Uint32)nextcmd->data.draw.count;
@@ -1039,6 +1298,9 @@ static void GPU_DestroyRenderer(SDL_Renderer *renderer)
     }
 
     ReleaseVertexBuffer(data);
+    if (data->quad_indices) {
+        SDL_ReleaseGPUBuffer(data->device, data->quad_indices);
+    }
     GPU_DestroyPipelineCache(&data->pipeline_cache);
     GPU_ReleaseShaders(&data->shaders, data->device);
     SDL_DestroyGPUDevice(data->device);
@@ -1174,6 +1436,10 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
     renderer->SupportsBlendMode = GPU_SupportsBlendMode;
     renderer->CreateTexture = GPU_CreateTexture;
     renderer->UpdateTexture = GPU_UpdateTexture;
+#ifdef SDL_HAVE_YUV
+    renderer->UpdateTextureYUV = GPU_UpdateTextureYUV;
+    renderer->UpdateTextureNV = GPU_UpdateTextureNV;
+#endif
     renderer->LockTexture = GPU_LockTexture;
     renderer->UnlockTexture = GPU_UnlockTexture;
     renderer->SetTextureScaleMode = GPU_SetTextureScaleMode;
@@ -1246,6 +1512,14 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BGRA32);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_RGBX32);
     SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BGRX32);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_RGB24);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_BGR24);
+#ifdef SDL_HAVE_YUV
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_YV12);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_IYUV);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV12);
+    SDL_AddSupportedTextureFormat(renderer, SDL_PIXELFORMAT_NV21);
+#endif
 
     SDL_SetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 16384);
 
@@ -1257,6 +1531,10 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
     data->state.viewport.max_depth = 1;
     data->state.command_buffer = SDL_AcquireGPUCommandBuffer(data->device);
 
+    if (!InitQuadIndexBuffer(data)) {
+        return false;
+    }
+
     int w, h;
     SDL_GetWindowSizeInPixels(window, &w, &h);
 
@@ -1264,6 +1542,17 @@ static bool GPU_CreateRenderer(SDL_Renderer *renderer, SDL_Window *window, SDL_P
         return false;
     }
 
+    if (SDL_GetBooleanProperty(create_props, SDL_PROP_RENDERER_CREATE_GPU_PREBUILD_PIPELINES_BOOLEAN, false)) {
+        const SDL_GPUTextureFormat formats[] = {
+            data->backbuffer.format,
+            SDL_GPU_TEXTUREFORMAT_B8G8R8A8_UNORM,
+            SDL_GPU_TEXTUREFORMAT_R8G8B8A8_UNORM,
+        };
+
+        // Not fatal, anything missing is still built on first use
+        GPU_PrebuildPipelines(&data->pipeline_cache, &data->shaders, data->device, formats, SDL_arraysize(formats));
+    }
+
     SDL_SetPointerProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_GPU_DEVICE_POINTER, data->device);
 
     return true;
@@ -34,21 +34,57 @@
 #include "SDL_rotate.h"
 #include "SDL_triangle.h"
 #include "../../video/SDL_pixels_c.h"
+#include "../../video/SDL_RLEaccel_c.h"
+#include "../../SDL_hashtable.h"
 
 // SDL surface based renderer implementation
 
+// The height in rows of the bands the target is split into when drawing on multiple threads
+#define SW_RENDER_TILE_HEIGHT 64
+
 typedef struct
 {
     const SDL_Rect *viewport;
     const SDL_Rect *cliprect;
     bool surface_cliprect_dirty;
+    SDL_Rect clip_rect; // the surface clip rect before it's limited to the tile
     SDL_Color color;
 } SW_DrawStateCache;
 
+typedef struct SW_RenderJob
+{
+    SDL_RenderCommand *cmd;
+    void *vertices;
+    SDL_Surface *target;
+    SDL_HashTable *texture_map; // SDL_Texture -> index into SW_RenderPass::textures, plus one
+    int num_textures;
+    int num_tiles;
+    SDL_AtomicInt next_tile;
+} SW_RenderJob;
+
+typedef struct
+{
+    SDL_Surface *surface;   // the render target, or a view of it owned by this pass
+    SDL_Rect tile;          // the part of the surface this pass may draw to
+    SW_RenderJob *job;      // NULL when drawing the whole target on the calling thread
+    SDL_Surface **textures; // views of the texture surfaces owned by this pass, created on first use
+} SW_RenderPass;
+
 typedef struct
 {
     SDL_Surface *surface;
     SDL_Surface *window;
+
+    // Worker threads used to draw bands of the target in parallel
+    SDL_Thread **threads;
+    int num_threads;
+    SDL_Mutex *lock;
+    SDL_Condition *job_cond;
+    SDL_Condition *done_cond;
+    SW_RenderJob *job;
+    Uint32 job_serial;
+    int busy_threads;
+    bool quit;
 } SW_RenderData;
 
 static SDL_Surface *SW_ActivateRenderer(SDL_Renderer *renderer)
@@ -315,11 +351,10 @@ static bool Blit_to_Screen(SDL_Surface *src, SDL_Rect *srcrect, SDL_Surface *sur
     return result;
 }
 
-static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture,
+static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Texture *texture, SDL_Surface *src,
                             const SDL_Rect *srcrect, const SDL_Rect *final_rect,
                             const double angle, const SDL_FPoint *center, const SDL_FlipMode flip, float scale_x, float scale_y)
 {
-    SDL_Surface *src = (SDL_Surface *)texture->internal;
     SDL_Rect tmp_rect;
     SDL_Surface *src_clone, *src_rotated, *src_scaled;
     SDL_Surface *mask = NULL, *mask_rotated = NULL;
@@ -339,6 +374,27 @@ static bool SW_RenderCopyEx(SDL_Renderer *renderer, SDL_Surface *surface, SDL_Te
     tmp_rect.w = final_rect->w;
     tmp_rect.h = final_rect->h;
 
+    // Common cases are drawn straight into the target, without any intermediate surfaces
+    if (scale_x == 1.0f && scale_y == 1.0f && SDLgfx_canRotateSurfaceBlend(src, surface)) {
+        SDL_Rect rect_dest;
+        double cangle, sangle;
+
+        /* The pixels are sampled directly, so textures drawn this way stop being RLE encoded
+         * to avoid potentially frequent RLE encoding/decoding.
+         */
+        SDL_SetSurfaceRLE(src, false);
+#ifdef SDL_HAVE_RLE
+        if (src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+            SDL_UnRLESurface(src, true);
+        }
+#endif
+        SDLgfx_rotozoomSurfaceSizeTrig(final_rect->w, final_rect->h, angle, center,
+                                       &rect_dest, &cangle, &sangle);
+        return SDLgfx_rotateSurfaceBlend(src, srcrect, surface, final_rect, angle,
+                                         (texture->scaleMode == SDL_SCALEMODE_NEAREST) ? 0 : 1, flip & SDL_FLIP_HORIZONTAL, flip & SDL_FLIP_VERTICAL,
+                                         &rect_dest, cangle, sangle, center);
+    }
+
     /* It is possible to encounter an RLE encoded surface here and locking it is
      * necessary because this code is going to access the pixel buffer directly.
      */
@@ -620,15 +676,13 @@ static bool SW_QueueGeometry(SDL_Renderer *renderer, SDL_RenderCommand *cmd, SDL
     return true;
 }
 
-static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate)
+static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *drawstate, SDL_Surface *surface)
 {
     const Uint8 r = drawstate->color.r;
     const Uint8 g = drawstate->color.g;
     const Uint8 b = drawstate->color.b;
     const Uint8 a = drawstate->color.a;
     const SDL_BlendMode blend = cmd->data.draw.blend;
-    SDL_Texture *texture = cmd->data.draw.texture;
-    SDL_Surface *surface = (SDL_Surface *)texture->internal;
     const bool colormod = ((r & g & b) != 0xFF);
     const bool alphamod = (a != 0xFF);
     const bool blending = ((blend == SDL_BLENDMODE_ADD) || (blend == SDL_BLENDMODE_MOD) || (blend == SDL_BLENDMODE_MUL));
@@ -643,24 +697,28 @@ static void PrepTextureForCopy(const SDL_RenderCommand *cmd, SW_DrawStateCache *
     SDL_SetSurfaceBlendMode(surface, blend);
 }
 
-static void SetDrawState(SDL_Surface *surface, SW_DrawStateCache *drawstate)
+static void SetDrawState(SW_RenderPass *pass, SW_DrawStateCache *drawstate)
 {
     if (drawstate->surface_cliprect_dirty) {
         const SDL_Rect *viewport = drawstate->viewport;
         const SDL_Rect *cliprect = drawstate->cliprect;
+        SDL_Rect clip_rect;
         SDL_assert_release(viewport != NULL); // the higher level should have forced a SDL_RENDERCMD_SETVIEWPORT
 
         if (cliprect && viewport) {
-            SDL_Rect clip_rect;
             clip_rect.x = cliprect->x + viewport->x;
             clip_rect.y = cliprect->y + viewport->y;
             clip_rect.w = cliprect->w;
             clip_rect.h = cliprect->h;
             SDL_GetRectIntersection(viewport, &clip_rect, &clip_rect);
-            SDL_SetSurfaceClipRect(surface, &clip_rect);
         } else {
-            SDL_SetSurfaceClipRect(surface, drawstate->viewport);
+            clip_rect = *viewport;
+        }
+        drawstate->clip_rect = clip_rect;
+        if (!SDL_GetRectIntersection(&pass->tile, &clip_rect, &clip_rect)) {
+            SDL_zero(clip_rect);
         }
+        SDL_SetSurfaceClipRect(pass->surface, &clip_rect);
         drawstate->surface_cliprect_dirty = false;
     }
 }
@@ -670,16 +728,115 @@ static void SW_InvalidateCachedState(SDL_Renderer *renderer)
     // SW_DrawStateCache only lives during SW_RunCommandQueue, so nothing to do here!
 }
 
+// Move the vertices of every draw from viewport coordinates to surface coordinates
+static void SW_ApplyViewport(SDL_RenderCommand *cmd, void *vertices)
+{
+    const SDL_Rect *viewport = NULL;
 
-static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+    for (; cmd; cmd = cmd->next) {
+        const int count = (int)cmd->data.draw.count;
+        int i;
+
+        if (cmd->command == SDL_RENDERCMD_SETVIEWPORT) {
+            viewport = &cmd->data.viewport.rect;
+            continue;
+        }
+        if (!viewport || (!viewport->x && !viewport->y)) {
+            continue;
+        }
+
+        switch (cmd->command) {
+        case SDL_RENDERCMD_DRAW_POINTS:
+        case SDL_RENDERCMD_DRAW_LINES:
+        {
+            SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            for (i = 0; i < count; i++) {
+                verts[i].x += viewport->x;
+                verts[i].y += viewport->y;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_FILL_RECTS:
+        {
+            SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            for (i = 0; i < count; i++) {
+                verts[i].x += viewport->x;
+                verts[i].y += viewport->y;
+            }
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY:
+        {
+            SDL_Rect *dstrect = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first) + 1;
+            dstrect->x += viewport->x;
+            dstrect->y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_COPY_EX:
+        {
+            CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            copydata->dstrect.x += viewport->x;
+            copydata->dstrect.y += viewport->y;
+            break;
+        }
+
+        case SDL_RENDERCMD_GEOMETRY:
+        {
+            SDL_Point vp;
+            vp.x = viewport->x;
+            vp.y = viewport->y;
+            trianglepoint_2_fixedpoint(&vp);
+            if (cmd->data.draw.texture) {
+                GeometryCopyData *ptr = (GeometryCopyData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            } else {
+                GeometryFillData *ptr = (GeometryFillData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+                for (i = 0; i < count; i++) {
+                    ptr[i].dst.x += vp.x;
+                    ptr[i].dst.y += vp.y;
+                }
+            }
+            break;
+        }
+
+        default:
+            break;
+        }
+    }
+}
+
+// Get the surface a pass reads a texture from, each thread uses its own view so the blit state isn't shared
+static SDL_Surface *GetPassTexture(SW_RenderPass *pass, SDL_Texture *texture)
 {
-    SDL_Surface *surface = SW_ActivateRenderer(renderer);
-    SW_DrawStateCache drawstate;
+    SDL_Surface *src = (SDL_Surface *)texture->internal;
+    const void *value;
+    int index;
 
-    if (!SDL_SurfaceValid(surface)) {
-        return false;
+    if (!pass->job) {
+        return src;
     }
 
+    if (!SDL_FindInHashTable(pass->job->texture_map, texture, &value)) {
+        return NULL;
+    }
+    index = (int)(uintptr_t)value - 1;
+    if (!pass->textures[index]) {
+        pass->textures[index] = SDL_CreateSurfaceFrom(src->w, src->h, src->format, src->pixels, src->pitch);
+    }
+    return pass->textures[index];
+}
+
+static bool SW_RunCommands(SDL_Renderer *renderer, SW_RenderPass *pass, SDL_RenderCommand *cmd, void *vertices)
+{
+    SDL_Surface *surface = pass->surface;
+    SW_DrawStateCache drawstate;
+
     drawstate.viewport = NULL;
     drawstate.cliprect = NULL;
     drawstate.surface_cliprect_dirty = true;
@@ -721,7 +878,7 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const Uint8 a = (Uint8)SDL_roundf(SDL_clamp(cmd->data.color.color.a, 0.0f, 1.0f) * 255.0f);
             // By definition the clear ignores the clip rect
             SDL_SetSurfaceClipRect(surface, NULL);
-            SDL_FillSurfaceRect(surface, NULL, SDL_MapSurfaceRGBA(surface, r, g, b, a));
+            SDL_FillSurfaceRect(surface, &pass->tile, SDL_MapSurfaceRGBA(surface, r, g, b, a));
             drawstate.surface_cliprect_dirty = true;
             break;
         }
@@ -735,16 +892,7 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const int count = (int)cmd->data.draw.count;
             SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
+            SetDrawState(pass, &drawstate);
 
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawPoints(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
@@ -763,16 +911,7 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const int count = (int)cmd->data.draw.count;
             SDL_Point *verts = (SDL_Point *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
+            SetDrawState(pass, &drawstate);
 
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_DrawLines(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
@@ -791,16 +930,7 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const int count = (int)cmd->data.draw.count;
             SDL_Rect *verts = (SDL_Rect *)(((Uint8 *)vertices) + cmd->data.draw.first);
             const SDL_BlendMode blend = cmd->data.draw.blend;
-            SetDrawState(surface, &drawstate);
-
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                int i;
-                for (i = 0; i < count; i++) {
-                    verts[i].x += drawstate.viewport->x;
-                    verts[i].y += drawstate.viewport->y;
-                }
-            }
+            SetDrawState(pass, &drawstate);
 
             if (blend == SDL_BLENDMODE_NONE) {
                 SDL_FillSurfaceRects(surface, verts, count, SDL_MapSurfaceRGBA(surface, r, g, b, a));
@@ -816,21 +946,27 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             const SDL_Rect *srcrect = verts;
             SDL_Rect *dstrect = verts + 1;
             SDL_Texture *texture = cmd->data.draw.texture;
-            SDL_Surface *src = (SDL_Surface *)texture->internal;
+            SDL_Surface *src;
 
-            SetDrawState(surface, &drawstate);
-
-            PrepTextureForCopy(cmd, &drawstate);
+            if (pass->job && !SDL_HasRectIntersection(dstrect, &pass->tile)) {
+                break;  // this draw lands entirely in other bands
+            }
 
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                dstrect->x += drawstate.viewport->x;
-                dstrect->y += drawstate.viewport->y;
+            src = GetPassTexture(pass, texture);
+            if (!src) {
+                break;
             }
 
+            SetDrawState(pass, &drawstate);
+
+            PrepTextureForCopy(cmd, &drawstate, src);
+
             if (srcrect->w == dstrect->w && srcrect->h == dstrect->h) {
                 SDL_BlitSurface(src, srcrect, surface, dstrect);
             } else {
+                SDL_Rect region = *dstrect;
+                bool intermediate = false;
+
                 /* If scaling is ever done, permanently disable RLE (which doesn't support scaling)
                  * to avoid potentially frequent RLE encoding/decoding.
                  */
@@ -838,7 +974,21 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
 
                 // Prevent to do scaling + clipping on viewport boundaries as it may lose proportion
                 if (dstrect->x < 0 || dstrect->y < 0 || dstrect->x + dstrect->w > surface->w || dstrect->y + dstrect->h > surface->h) {
-                    SDL_Surface *tmp = SDL_CreateSurface(dstrect->w, dstrect->h, src->format);
+                    intermediate = true;
+                } else if (pass->job &&
+                           (dstrect->y < pass->tile.y || dstrect->y + dstrect->h > pass->tile.y + pass->tile.h)) {
+                    /* Scaling clipped to a band would sample the texture differently than the
+                     * single threaded blit, so scale the part inside the clip rect the same way
+                     * that would and let the band clip the unscaled copy of it.
+                     */
+                    if (!SDL_GetRectIntersection(dstrect, &drawstate.clip_rect, &region)) {
+                        break;
+                    }
+                    intermediate = true;
+                }
+
+                if (intermediate) {
+                    SDL_Surface *tmp = SDL_CreateSurface(region.w, region.h, src->format);
                     // Scale to an intermediate surface, then blit
                     if (tmp) {
                         SDL_Rect r;
@@ -849,8 +999,8 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
                         SDL_GetSurfaceAlphaMod(src, &alphaMod);
                         SDL_GetSurfaceColorMod(src, &rMod, &gMod, &bMod);
 
-                        r.x = 0;
-                        r.y = 0;
+                        r.x = dstrect->x - region.x;
+                        r.y = dstrect->y - region.y;
                         r.w = dstrect->w;
                         r.h = dstrect->h;
 
@@ -864,7 +1014,7 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
                         SDL_SetSurfaceAlphaMod(tmp, alphaMod);
                         SDL_SetSurfaceBlendMode(tmp, blendmode);
 
-                        SDL_BlitSurface(tmp, NULL, surface, dstrect);
+                        SDL_BlitSurface(tmp, NULL, surface, &region);
                         SDL_DestroySurface(tmp);
                         // No need to set back r/g/b/a/blendmode to 'src' since it's done in PrepTextureForCopy()
                     }
@@ -878,16 +1028,30 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
         case SDL_RENDERCMD_COPY_EX:
         {
             CopyExData *copydata = (CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
-            SetDrawState(surface, &drawstate);
-            PrepTextureForCopy(cmd, &drawstate);
+            SDL_Surface *src;
+
+            if (pass->job) {
+                SDL_Rect rect_dest;
+                double cangle, sangle;
+
+                SDLgfx_rotozoomSurfaceSizeTrig(copydata->dstrect.w, copydata->dstrect.h, copydata->angle, &copydata->center,
+                                               &rect_dest, &cangle, &sangle);
+                rect_dest.x += copydata->dstrect.x;
+                rect_dest.y += copydata->dstrect.y;
+                if (!SDL_HasRectIntersection(&rect_dest, &pass->tile)) {
+                    break;  // this draw lands entirely in other bands
+                }
+            }
 
-            // Apply viewport
-            if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                copydata->dstrect.x += drawstate.viewport->x;
-                copydata->dstrect.y += drawstate.viewport->y;
+            src = GetPassTexture(pass, cmd->data.draw.texture);
+            if (!src) {
+                break;
             }
 
-            SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, &copydata->srcrect,
+            SetDrawState(pass, &drawstate);
+            PrepTextureForCopy(cmd, &drawstate, src);
+
+            SW_RenderCopyEx(renderer, surface, cmd->data.draw.texture, src, &copydata->srcrect,
                             &copydata->dstrect, copydata->angle, &copydata->center, copydata->flip,
                             copydata->scale_x, copydata->scale_y);
             break;
@@ -901,51 +1065,33 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
             SDL_Texture *texture = cmd->data.draw.texture;
             const SDL_BlendMode blend = cmd->data.draw.blend;
 
-            SetDrawState(surface, &drawstate);
+            SetDrawState(pass, &drawstate);
 
             if (texture) {
-                SDL_Surface *src = (SDL_Surface *)texture->internal;
-
-                GeometryCopyData *ptr = (GeometryCopyData *)verts;
+                SDL_Surface *src = GetPassTexture(pass, texture);
+                const GeometryCopyData *ptr = (const GeometryCopyData *)verts;
 
-                PrepTextureForCopy(cmd, &drawstate);
-
-                // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
+                if (!src) {
+                    break;
                 }
 
+                PrepTextureForCopy(cmd, &drawstate, src);
+
                 for (i = 0; i < count; i += 3, ptr += 3) {
+                    // The triangle blitter adjusts the points it's given, so pass copies to leave the queue as-is
+                    SDL_Point s0 = ptr[0].src, s1 = ptr[1].src, s2 = ptr[2].src;
+                    SDL_Point d0 = ptr[0].dst, d1 = ptr[1].dst, d2 = ptr[2].dst;
                     SDL_SW_BlitTriangle(
                         src,
-                        &(ptr[0].src), &(ptr[1].src), &(ptr[2].src),
+                        &s0, &s1, &s2,
                         surface,
-                        &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst),
+                        &d0, &d1, &d2,
                         ptr[0].color, ptr[1].color, ptr[2].color,
                         cmd->data.draw.texture_address_mode);
                 }
             } else {
                 GeometryFillData *ptr = (GeometryFillData *)verts;
 
-                // Apply viewport
-                if (drawstate.viewport && (drawstate.viewport->x || drawstate.viewport->y)) {
-                    SDL_Point vp;
-                    vp.x = drawstate.viewport->x;
-                    vp.y = drawstate.viewport->y;
-                    trianglepoint_2_fixedpoint(&vp);
-                    for (i = 0; i < count; i++) {
-                        ptr[i].dst.x += vp.x;
-                        ptr[i].dst.y += vp.y;
-                    }
-                }
-
                 for (i = 0; i < count; i += 3, ptr += 3) {
                     SDL_SW_FillTriangle(surface, &(ptr[0].dst), &(ptr[1].dst), &(ptr[2].dst), blend, ptr[0].color, ptr[1].color, ptr[2].color);
                 }
@@ -963,6 +1109,190 @@ static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, v
     return true;
 }
 
+static void SW_RunRenderJob(SDL_Renderer *renderer, SW_RenderJob *job, SW_RenderPass *pass)
+{
+    SDL_Surface *target = job->target;
+    int tile, i;
+
+    for (tile = SDL_AddAtomicInt(&job->next_tile, 1); tile < job->num_tiles; tile = SDL_AddAtomicInt(&job->next_tile, 1)) {
+        pass->tile.x = 0;
+        pass->tile.y = tile * SW_RENDER_TILE_HEIGHT;
+        pass->tile.w = target->w;
+        pass->tile.h = SDL_min(SW_RENDER_TILE_HEIGHT, target->h - pass->tile.y);
+        SW_RunCommands(renderer, pass, job->cmd, job->vertices);
+    }
+
+    for (i = 0; i < job->num_textures; ++i) {
+        SDL_DestroySurface(pass->textures[i]);
+    }
+    SDL_free(pass->textures);
+    SDL_DestroySurface(pass->surface);
+}
+
+static bool SW_CreateRenderPass(SW_RenderJob *job, SW_RenderPass *pass)
+{
+    SDL_Surface *target = job->target;
+
+    SDL_zerop(pass);
+    pass->job = job;
+    pass->surface = SDL_CreateSurfaceFrom(target->w, target->h, target->format, target->pixels, target->pitch);
+    if (!pass->surface) {
+        return false;
+    }
+    pass->textures = (SDL_Surface **)SDL_calloc(SDL_max(job->num_textures, 1), sizeof(*pass->textures));
+    if (!pass->textures) {
+        SDL_DestroySurface(pass->surface);
+        return false;
+    }
+    return true;
+}
+
+static int SDLCALL SW_RenderThread(void *userdata)
+{
+    SDL_Renderer *renderer = (SDL_Renderer *)userdata;
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    Uint32 serial = 0;
+
+    SDL_LockMutex(data->lock);
+    for ( ; ; ) {
+        SW_RenderJob *job;
+        SW_RenderPass pass;
+
+        while (!data->quit && data->job_serial == serial) {
+            SDL_WaitCondition(data->job_cond, data->lock);
+        }
+        if (data->quit) {
+            break;
+        }
+        serial = data->job_serial;
+        job = data->job;
+        SDL_UnlockMutex(data->lock);
+
+        // If this fails the other threads pick up the bands this one would have drawn
+        if (SW_CreateRenderPass(job, &pass)) {
+            SW_RunRenderJob(renderer, job, &pass);
+        }
+
+        SDL_LockMutex(data->lock);
+        if (--data->busy_threads == 0) {
+            SDL_SignalCondition(data->done_cond);
+        }
+    }
+    SDL_UnlockMutex(data->lock);
+
+    return 0;
+}
+
+/* Set up drawing a command queue as bands on several threads, if it can be split that way.
+ * Everything but lines and scaled rotated copies clips exactly to a band, so those are
+ * the only draws that would look different if they were drawn piecewise.
+ */
+static bool SW_PrepareRenderJob(SW_RenderJob *job, SDL_RenderCommand *cmd, void *vertices, SDL_Surface *surface)
+{
+    SDL_RenderCommand *first = cmd;
+
+    if (surface->h < 2 * SW_RENDER_TILE_HEIGHT || SDL_MUSTLOCK(surface) || SDL_ISPIXELFORMAT_INDEXED(surface->format)) {
+        return false;
+    }
+
+    for (; cmd; cmd = cmd->next) {
+        if (cmd->command == SDL_RENDERCMD_DRAW_LINES) {
+            return false;
+        } else if (cmd->command == SDL_RENDERCMD_COPY_EX) {
+            const CopyExData *copydata = (const CopyExData *)(((Uint8 *)vertices) + cmd->data.draw.first);
+            if (copydata->scale_x != 1.0f || copydata->scale_y != 1.0f) {
+                return false;
+            }
+        }
+    }
+
+    SDL_zerop(job);
+    job->cmd = first;
+    job->vertices = vertices;
+    job->target = surface;
+    job->num_tiles = (surface->h + SW_RENDER_TILE_HEIGHT - 1) / SW_RENDER_TILE_HEIGHT;
+    job->texture_map = SDL_CreateHashTable(NULL, 16, SDL_HashPointer, SDL_KeyMatchPointer, NULL, false, false);
+    if (!job->texture_map) {
+        return false;
+    }
+
+    // Gather the textures used, each thread will need its own view of them
+    for (cmd = first; cmd; cmd = cmd->next) {
+        SDL_Texture *texture;
+        SDL_Surface *src;
+
+        if (cmd->command != SDL_RENDERCMD_COPY && cmd->command != SDL_RENDERCMD_COPY_EX && cmd->command != SDL_RENDERCMD_GEOMETRY) {
+            continue;
+        }
+        texture = cmd->data.draw.texture;
+        if (!texture || SDL_FindInHashTable(job->texture_map, texture, NULL)) {
+            continue;
+        }
+
+        src = (SDL_Surface *)texture->internal;
+        if (SDL_ISPIXELFORMAT_INDEXED(src->format) ||
+            !SDL_InsertIntoHashTable(job->texture_map, texture, (const void *)(uintptr_t)(job->num_textures + 1))) {
+            SDL_DestroyHashTable(job->texture_map);
+            return false;
+        }
+        ++job->num_textures;
+
+        // The threads read the pixels directly, so textures drawn this way stop being RLE encoded
+        SDL_SetSurfaceRLE(src, false);
+#ifdef SDL_HAVE_RLE
+        if (src->internal_flags & SDL_INTERNAL_SURFACE_RLEACCEL) {
+            SDL_UnRLESurface(src, true);
+        }
+#endif
+    }
+    return true;
+}
+
+static bool SW_RunCommandQueue(SDL_Renderer *renderer, SDL_RenderCommand *cmd, void *vertices, size_t vertsize)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    SDL_Surface *surface = SW_ActivateRenderer(renderer);
+    SW_RenderPass pass;
+    SW_RenderJob job;
+
+    if (!SDL_SurfaceValid(surface)) {
+        return false;
+    }
+
+    SW_ApplyViewport(cmd, vertices);
+
+    if (data->num_threads > 0 && SW_PrepareRenderJob(&job, cmd, vertices, surface)) {
+        if (SW_CreateRenderPass(&job, &pass)) {
+            SDL_LockMutex(data->lock);
+            data->job = &job;
+            data->busy_threads = data->num_threads;
+            ++data->job_serial;
+            SDL_BroadcastCondition(data->job_cond);
+            SDL_UnlockMutex(data->lock);
+
+            // This thread draws bands too, so every band is done even if a worker couldn't start
+            SW_RunRenderJob(renderer, &job, &pass);
+
+            SDL_LockMutex(data->lock);
+            while (data->busy_threads > 0) {
+                SDL_WaitCondition(data->done_cond, data->lock);
+            }
+            data->job = NULL;
+            SDL_UnlockMutex(data->lock);
+
+            SDL_DestroyHashTable(job.texture_map);
+            return true;
+        }
+        SDL_DestroyHashTable(job.texture_map);
+    }
+
+    SDL_zero(pass);
+    pass.surface = surface;
+    pass.tile.w = surface->w;
+    pass.tile.h = surface->h;
+    return SW_RunCommands(renderer, &pass, cmd, vertices);
+}
+
 static SDL_Surface *SW_RenderReadPixels(SDL_Renderer *renderer, const SDL_Rect *rect)
 {
     SDL_Surface *surface = SW_ActivateRenderer(renderer);
@@ -1011,12 +1341,67 @@ static void SW_DestroyRenderer(SDL_Renderer *renderer)
     SDL_Window *window = renderer->window;
     SW_RenderData *data = (SW_RenderData *)renderer->internal;
 
+    if (data->threads) {
+        int i;
+
+        SDL_LockMutex(data->lock);
+        data->quit = true;
+        SDL_BroadcastCondition(data->job_cond);
+        SDL_UnlockMutex(data->lock);
+
+        for (i = 0; i < data->num_threads; ++i) {
+            SDL_WaitThread(data->threads[i], NULL);
+        }
+        SDL_free(data->threads);
+    }
+    SDL_DestroyCondition(data->done_cond);
+    SDL_DestroyCondition(data->job_cond);
+    SDL_DestroyMutex(data->lock);
+
     if (window) {
         SDL_DestroyWindowSurface(window);
     }
     SDL_free(data);
 }
 
+static void SW_StartRenderThreads(SDL_Renderer *renderer)
+{
+    SW_RenderData *data = (SW_RenderData *)renderer->internal;
+    const char *hint = SDL_GetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+    int num_threads = 1;
+    int i;
+
+    if (hint && *hint) {
+        num_threads = SDL_atoi(hint);
+        if (num_threads <= 0) {
+            num_threads = SDL_GetNumLogicalCPUCores();
+        }
+    }
+    if (num_threads <= 1) {
+        return;
+    }
+
+    data->lock = SDL_CreateMutex();
+    data->job_cond = SDL_CreateCondition();
+    data->done_cond = SDL_CreateCondition();
+    data->threads = (SDL_Thread **)SDL_calloc(num_threads - 1, sizeof(*data->threads));
+    if (!data->lock || !data->job_cond || !data->done_cond || !data->threads) {
+        return;
+    }
+
+    // The thread flushing the command queue draws too, so start one less
+    for (i = 0; i < num_threads - 1; ++i) {
+        char name[32];
+
+        SDL_snprintf(name, sizeof(name), "SDLSWRender%d", i);
+        data->threads[i] = SDL_CreateThread(SW_RenderThread, name, renderer);
+        if (!data->threads[i]) {
+            break;
+        }
+        ++data->num_threads;
+    }
+}
+
 static void SW_SelectBestFormats(SDL_Renderer *renderer, SDL_PixelFormat format)
 {
     // Prefer the format used by the framebuffer by default.
@@ -1164,6 +1549,8 @@ bool SW_CreateRendererForSurface(SDL_Renderer *renderer, SDL_Surface *surface, S
         return SDL_SetError("Unsupported output colorspace");
     }
 
+    SW_StartRenderThreads(renderer);
+
     return true;
 }
 
@@ -39,6 +39,7 @@ Andreas Schiffler -- aschiffler at ferzkopp dot net
 #include "SDL_rotate.h"
 
 #include "../../video/SDL_surface_c.h"
+#include "../../video/SDL_pixels_c.h"
 
 // ---- Internally used structures
 
@@ -460,6 +461,326 @@ static void transformSurfaceY(SDL_Surface *src, SDL_Surface *dst, int isin, int
     }
 }
 
+/**
+Linearly interpolates two 32-bit pixels with 8 bit channels, two channels per multiply.
+
+\param a The pixel at weight 0.
+\param b The pixel at weight 256.
+\param f The weight of 'b', from 0 to 256.
+\return The interpolated pixel, in the same layout as the inputs.
+*/
+static SDL_INLINE Uint32 lerpPixel8888(Uint32 a, Uint32 b, int f)
+{
+    const Uint32 rb = ((((a & 0x00ff00ff) * (256 - f)) + ((b & 0x00ff00ff) * f)) >> 8) & 0x00ff00ff;
+    const Uint32 ga = ((((a >> 8) & 0x00ff00ff) * (256 - f)) + (((b >> 8) & 0x00ff00ff) * f)) & 0xff00ff00;
+    return rb | ga;
+}
+
+/**
+Checks whether SDLgfx_rotateSurfaceBlend() can draw 'src' onto 'dst'.
+
+The source must have a 32-bit 8888 layout (with or without alpha) without a colorkey,
+and the destination must not need locking. RLE acceleration of the source has to be
+turned off before drawing.
+
+\param src The surface to rotozoom.
+\param dst The surface to draw on.
+\return true if the surfaces are supported.
+*/
+bool SDLgfx_canRotateSurfaceBlend(SDL_Surface *src, SDL_Surface *dst)
+{
+    if (SDL_PIXELLAYOUT(src->format) != SDL_PACKEDLAYOUT_8888 || src->fmt->bits_per_pixel != 32) {
+        return false;
+    }
+    if (src->map.info.flags & SDL_COPY_COLORKEY) {
+        return false;
+    }
+    if (SDL_MUSTLOCK(dst)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+Narrows the pixel range [*start, *end) to the pixels 'i' where 0 <= pos + i * step <= max.
+
+This solves the coverage test of a whole row at once, so that only covered pixels are visited.
+*/
+static void clipRotateSpan(Sint64 pos, Sint64 step, Sint64 max, int *start, int *end)
+{
+    Sint64 first, last;
+
+    if (step == 0) {
+        if (pos < 0 || pos > max) {
+            *end = *start;
+        }
+        return;
+    }
+    if (step < 0) {
+        // Walk the row backwards: 0 <= pos' + i * step' <= max, with pos' = max - pos and step' = -step
+        pos = max - pos;
+        step = -step;
+    }
+    if (pos > max) {
+        *end = *start;
+        return;
+    }
+    first = (pos >= 0) ? 0 : ((-pos + step - 1) / step);
+    last = (max - pos) / step;
+    if (first > *start) {
+        *start = (int)SDL_min(first, (Sint64)*end);
+    }
+    if (last + 1 < *end) {
+        *end = (int)SDL_max(last + 1, (Sint64)*start);
+    }
+}
+
+/**
+Number of pixels sampled at a time by SDLgfx_rotateSurfaceBlend().
+*/
+#define ROTATE_SPAN_PIXELS 256
+
+/**
+Rotates, zooms and blends a 32-bit 'src' surface straight into 'dst'.
+
+The destination is scanned over the rotated bounding box, clipped to the clip rectangle of 'dst'.
+Covered pixels are sampled from 'srcrect' into a short span, which is drawn with the blitter
+that SDL_BlitSurface() would use, so color mod, alpha mod and blend mode behave the same.
+Stretching 'srcrect' to the size of 'final_rect' is folded into the sampling,
+so no intermediate surface is needed. Bilinear filtering interpolates two channels per multiply.
+The surfaces must pass SDLgfx_canRotateSurfaceBlend() and 'src' must not be RLE encoded.
+
+\param src The surface to rotozoom.
+\param srcrect The area of 'src' to draw.
+\param dst The surface to draw on.
+\param final_rect The unrotated destination rectangle on 'dst'.
+\param angle The angle to rotate in degrees.
+\param smooth Antialiasing flag; set to SMOOTHING_ON to enable.
+\param flipx Set to 1 to flip the image horizontally
+\param flipy Set to 1 to flip the image vertically
+\param rect_dest The rotated bounding box, relative to 'final_rect'
+\param cangle The angle cosine
+\param sangle The angle sine
+\param center The true coordinate of the center of rotation, relative to 'final_rect'
+\return true on success or false on failure; call SDL_GetError() for more information.
+*/
+bool SDLgfx_rotateSurfaceBlend(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *final_rect,
+                               double angle, int smooth, int flipx, int flipy,
+                               const SDL_Rect *rect_dest, double cangle, double sangle, const SDL_FPoint *center)
+{
+    Uint32 span[ROTATE_SPAN_PIXELS];
+    SDL_BlitInfo info;
+    SDL_BlitFunc blit;
+    const int dstbpp = dst->fmt->bytes_per_pixel;
+    const int src_pitch = src->pitch / 4;
+    const int fp_half = (1 << 15);
+    const int sw = srcrect->w - 1;
+    const int sh = srcrect->h - 1;
+    const Uint32 *src_pixels;
+    int sdx_row, sdy_row;
+    int step_xx, step_xy, step_yx, step_yy;
+    int angle90;
+    SDL_Rect box;
+    int y;
+
+    if (final_rect->w <= 0 || final_rect->h <= 0 || srcrect->w <= 0 || srcrect->h <= 0) {
+        return true;
+    }
+
+    box.x = final_rect->x + rect_dest->x;
+    box.y = final_rect->y + rect_dest->y;
+    box.w = rect_dest->w;
+    box.h = rect_dest->h;
+    if (!SDL_GetRectIntersection(&box, &dst->clip_rect, &box)) {
+        return true;
+    }
+
+    // Pick the blitter for this pair of surfaces, with the current modulation and blend mode
+    if (!SDL_ValidateMap(src, dst)) {
+        return false;
+    }
+    info = src->map.info;
+    blit = (SDL_BlitFunc)src->map.data;
+
+    /* Set up the source position of the first pixel and its increments along x and y.
+     * Positions are 16.16 fixed point, at half a pixel before the sampled pixel center,
+     * which is where bilinear filtering wants them.
+     */
+    angle90 = (int)(angle / 90);
+    if (angle90 == angle / 90) {
+        /* Rotations that are a multiple of 90 degrees map pixels exactly, the same way as
+         * transformSurfaceRGBA90() with a nearest stretch of 'srcrect' to 'final_rect'.
+         */
+        const int w = final_rect->w;
+        const int h = final_rect->h;
+        const int incx = (srcrect->w << 16) / w;
+        const int incy = (srcrect->h << 16) / h;
+        const int rx = box.x - final_rect->x - rect_dest->x;
+        const int ry = box.y - final_rect->y - rect_dest->y;
+        int ox, ax, bx, oy, ay, by; // unrotated pixel = (ox + ax * rx + bx * ry, oy + ay * rx + by * ry)
+
+        angle90 %= 4;
+        if (angle90 < 0) {
+            angle90 += 4; // 0:0 deg, 1:90 deg, 2:180 deg, 3:270 deg
+        }
+        switch (angle90) {
+        case 0:
+            ox = 0;
+            ax = 1;
+            bx = 0;
+            oy = 0;
+            ay = 0;
+            by = 1;
+            break;
+        case 1:
+            ox = 0;
+            ax = 0;
+            bx = 1;
+            oy = h - 1;
+            ay = -1;
+            by = 0;
+            break;
+        case 2:
+            ox = w - 1;
+            ax = -1;
+            bx = 0;
+            oy = h - 1;
+            ay = 0;
+            by = -1;
+            break;
+        case 3:
+        default:
+            ox = w - 1;
+            ax = 0;
+            bx = -1;
+            oy = 0;
+            ay = 1;
+            by = 0;
+            break;
+        }
+        if (flipx) {
+            ox = w - 1 - ox;
+            ax = -ax;
+            bx = -bx;
+            flipx = 0;
+        }
+        if (flipy) {
+            oy = h - 1 - oy;
+            ay = -ay;
+            by = -by;
+            flipy = 0;
+        }
+        sdx_row = (ox + ax * rx + bx * ry) * incx + incx / 2 - fp_half;
+        sdy_row = (oy + ay * rx + by * ry) * incy + incy / 2 - fp_half;
+        step_xx = ax * incx;
+        step_xy = ay * incy;
+        step_yx = bx * incx;
+        step_yy = by * incy;
+    } else {
+        // Calculate source increments from sine/cosine and the stretch of 'srcrect' onto 'final_rect'
+        const double rx = (double)srcrect->w / final_rect->w;
+        const double ry = (double)srcrect->h / final_rect->h;
+        const double src_x = ((double)rect_dest->x + 0.5 - center->x);
+        const double src_y = ((double)rect_dest->y + 0.5 - center->y);
+        const int skip_x = box.x - final_rect->x - rect_dest->x;
+        const int skip_y = box.y - final_rect->y - rect_dest->y;
+
+        step_xx = (int)(cangle * rx * 65536.0);
+        step_xy = (int)(sangle * ry * 65536.0);
+        step_yx = (int)(-sangle * rx * 65536.0);
+        step_yy = (int)(cangle * ry * 65536.0);
+
+        /* Start from the corner of the bounding box, so that clipping doesn't change
+         * the position of any pixel that is drawn.
+         */
+        sdx_row = (int)(((cangle * src_x - sangle * src_y) + center->x) * rx * 65536.0 - fp_half);
+        sdy_row = (int)(((sangle * src_x + cangle * src_y) + center->y) * ry * 65536.0 - fp_half);
+        sdx_row += skip_x * step_xx + skip_y * step_yx;
+        sdy_row += skip_x * step_xy + skip_y * step_yy;
+    }
+
+    src_pixels = (const Uint32 *)((const Uint8 *)src->pixels + srcrect->y * src->pitch) + srcrect->x;
+
+    for (y = 0; y < box.h; y++, sdx_row += step_yx, sdy_row += step_yy) {
+        Uint8 *row = (Uint8 *)dst->pixels + (box.y + y) * dst->pitch + box.x * dstbpp;
+        int start = 0, end = box.w;
+        int i;
+
+        // Only pixels with their center inside the source rectangle are drawn
+        clipRotateSpan((Sint64)sdx_row + fp_half, step_xx, ((Sint64)srcrect->w << 16) - 1, &start, &end);
+        clipRotateSpan((Sint64)sdy_row + fp_half, step_xy, ((Sint64)srcrect->h << 16) - 1, &start, &end);
+
+        for (i = start; i < end; i += ROTATE_SPAN_PIXELS) {
+            const int count = SDL_min(end - i, ROTATE_SPAN_PIXELS);
+            int sdx = sdx_row + i * step_xx;
+            int sdy = sdy_row + i * step_xy;
+            int n;
+
+            if (smooth) {
+                for (n = 0; n < count; n++, sdx += step_xx, sdy += step_xy) {
+                    const Uint32 *sp0, *sp1;
+                    const int ex = (sdx >> 8) & 0xff;
+                    const int ey = (sdy >> 8) & 0xff;
+                    int sx0 = (sdx >> 16), sx1 = sx0 + 1;
+                    int sy0 = (sdy >> 16), sy1 = sy0 + 1;
+
+                    // Clamp the filter to the edges of the source rectangle
+                    if (sx0 < 0) {
+                        sx0 = 0;
+                    }
+                    if (sx1 > sw) {
+                        sx1 = sw;
+                    }
+                    if (sy0 < 0) {
+                        sy0 = 0;
+                    }
+                    if (sy1 > sh) {
+                        sy1 = sh;
+                    }
+                    if (flipx) {
+                        sx0 = sw - sx0;
+                        sx1 = sw - sx1;
+                    }
+                    if (flipy) {
+                        sy0 = sh - sy0;
+                        sy1 = sh - sy1;
+                    }
+                    sp0 = src_pixels + sy0 * src_pitch;
+                    sp1 = src_pixels + sy1 * src_pitch;
+                    span[n] = lerpPixel8888(lerpPixel8888(sp0[sx0], sp0[sx1], ex),
+                                            lerpPixel8888(sp1[sx0], sp1[sx1], ex), ey);
+                }
+            } else {
+                for (n = 0; n < count; n++, sdx += step_xx, sdy += step_xy) {
+                    int dx = ((sdx + fp_half) >> 16);
+                    int dy = ((sdy + fp_half) >> 16);
+                    if (flipx) {
+                        dx = sw - dx;
+                    }
+                    if (flipy) {
+                        dy = sh - dy;
+                    }
+                    span[n] = src_pixels[dy * src_pitch + dx];
+                }
+            }
+
+            // Draw the sampled pixels
+            info.src = (Uint8 *)span;
+            info.src_w = count;
+            info.src_h = 1;
+            info.src_pitch = count * 4;
+            info.src_skip = 0;
+            info.dst = row + i * dstbpp;
+            info.dst_w = count;
+            info.dst_h = 1;
+            info.dst_pitch = dst->pitch;
+            info.dst_skip = dst->pitch - count * dstbpp;
+            blit(&info);
+        }
+    }
+    return true;
+}
+
 /**
 Rotates and zooms a surface with different horizontal and vertival scaling factors and optional anti-aliasing.
 
@@ -26,5 +26,9 @@ extern SDL_Surface *SDLgfx_rotateSurface(SDL_Surface *src, double angle, int smo
                                          const SDL_Rect *rect_dest, double cangle, double sangle, const SDL_FPoint *center);
 extern void SDLgfx_rotozoomSurfaceSizeTrig(int width, int height, double angle, const SDL_FPoint *center,
                                            SDL_Rect *rect_dest, double *cangle, double *sangle);
+extern bool SDLgfx_canRotateSurfaceBlend(SDL_Surface *src, SDL_Surface *dst);
+extern bool SDLgfx_rotateSurfaceBlend(SDL_Surface *src, const SDL_Rect *srcrect, SDL_Surface *dst, const SDL_Rect *final_rect,
+                                      double angle, int smooth, int flipx, int flipy,
+                                      const SDL_Rect *rect_dest, double cangle, double sangle, const SDL_FPoint *center);
 
 #endif // SDL_rotate_h_
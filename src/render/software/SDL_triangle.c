@@ -44,6 +44,13 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
                                   int s2s0_x, int s2s1_x, int s2s0_y, int s2s1_y, int w0_row, int w1_row, int w2_row,
                                   SDL_Color c0, SDL_Color c1, SDL_Color c2, bool is_uniform, SDL_TextureAddressMode texture_address_mode);
 
+static bool SDL_BlitTriangle_CanUseSpan8888(const SDL_BlitInfo *info);
+static void SDL_BlitTriangle_Span8888(SDL_BlitInfo *info,
+                                      SDL_Point s2_x_area, SDL_Rect dstrect, int area, int bias_w0, int bias_w1, int bias_w2,
+                                      int d2d1_y, int d1d2_x, int d0d2_y, int d2d0_x, int d1d0_y, int d0d1_x,
+                                      int s2s0_x, int s2s1_x, int s2s0_y, int s2s1_y, int w0_row, int w1_row, int w2_row,
+                                      SDL_Color c0, SDL_Color c1, SDL_Color c2, bool is_uniform, SDL_TextureAddressMode texture_address_mode);
+
 #if 0
 bool SDL_BlitTriangle(SDL_Surface *src, const SDL_Point srcpoints[3], SDL_Surface *dst, const SDL_Point dstpoints[3])
 {
@@ -163,21 +170,54 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
 /* Triangle rendering, using Barycentric coordinates (w0, w1, w2)
  *
  * The cross product isn't computed from scratch at each iteration,
- * but optimized using constant step increments
- *
+ * but optimized using constant step increments.
+ * Each row only visits the span of pixels that is inside all three edges.
  */
 
-#define TRIANGLE_BEGIN_LOOP                                                        \
-    {                                                                              \
-        int x, y;                                                                  \
-        for (y = 0; y < dstrect.h; y++) {                                          \
-            /* y start */                                                          \
-            Sint64 w0 = w0_row;                                                    \
-            Sint64 w1 = w1_row;                                                    \
-            Sint64 w2 = w2_row;                                                    \
-            for (x = 0; x < dstrect.w; x++) {                                      \
-                /* In triangle */                                                  \
-                if (w0 + bias_w0 >= 0 && w1 + bias_w1 >= 0 && w2 + bias_w2 >= 0) { \
+/* Narrow [*start, *end) to the pixels where w + x * step >= 0
+ * This is the same test as checking each pixel, solved once per row.
+ */
+static void triangle_clip_span(Sint64 w, Sint64 step, int *start, int *end)
+{
+    if (step == 0) {
+        if (w < 0) {
+            *end = *start;
+        }
+    } else if (step > 0) {
+        if (w < 0) {
+            const Sint64 first = (-w + step - 1) / step;
+            if (first > *start) {
+                *start = (int)SDL_min(first, (Sint64)*end);
+            }
+        }
+    } else {
+        if (w < 0) {
+            *end = *start;
+        } else {
+            const Sint64 last = w / -step;
+            if (last + 1 < *end) {
+                *end = (int)SDL_max(last + 1, (Sint64)*start);
+            }
+        }
+    }
+}
+
+#define TRIANGLE_BEGIN_LOOP                                                              \
+    {                                                                                    \
+        int x, y;                                                                        \
+        for (y = 0; y < dstrect.h; y++) {                                                \
+            /* y start */                                                                \
+            int x_start = 0, x_end = dstrect.w;                                          \
+            Sint64 w0, w1, w2;                                                           \
+            triangle_clip_span((Sint64)w0_row + bias_w0, d2d1_y, &x_start, &x_end);      \
+            triangle_clip_span((Sint64)w1_row + bias_w1, d0d2_y, &x_start, &x_end);      \
+            triangle_clip_span((Sint64)w2_row + bias_w2, d1d0_y, &x_start, &x_end);      \
+            w0 = w0_row + (Sint64)x_start * d2d1_y;                                      \
+            w1 = w1_row + (Sint64)x_start * d0d2_y;                                      \
+            w2 = w2_row + (Sint64)x_start * d1d0_y;                                      \
+            for (x = x_start; x < x_end; x++, w0 += d2d1_y, w1 += d0d2_y, w2 += d1d0_y) { \
+                /* In triangle */                                                        \
+                {                                                                        \
                     Uint8 *dptr = (Uint8 *)dst_ptr + x * dstbpp;
 
 // Use 64 bits precision to prevent overflow when interpolating color / texture with wide triangles
@@ -210,10 +250,6 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
 
 #define TRIANGLE_END_LOOP \
     }                     \
-    /* x += 1 */          \
-    w0 += d2d1_y;         \
-    w1 += d0d2_y;         \
-    w2 += d1d0_y;         \
     }                     \
     /* y += 1 */          \
     w0_row += d1d2_x;     \
@@ -223,6 +259,103 @@ static void bounding_rect(const SDL_Point *a, const SDL_Point *b, const SDL_Poin
     }                     \
     }
 
+/* Per-pixel modulation and blending, shared by the generic and span blitters
+ * Expects srcR/G/B/A, dstR/G/B/A, modulateR/G/B/A and flags in scope.
+ */
+#define TRIANGLE_MODULATE_AND_BLEND                                                  \
+    if (flags & SDL_COPY_MODULATE_COLOR) {                                           \
+        srcR = (srcR * modulateR) / 255;                                             \
+        srcG = (srcG * modulateG) / 255;                                             \
+        srcB = (srcB * modulateB) / 255;                                             \
+    }                                                                                \
+    if (flags & SDL_COPY_MODULATE_ALPHA) {                                           \
+        srcA = (srcA * modulateA) / 255;                                             \
+    }                                                                                \
+    if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {                                   \
+        /* This goes away if we ever use premultiplied alpha */                      \
+        if (srcA < 255) {                                                            \
+            srcR = (srcR * srcA) / 255;                                              \
+            srcG = (srcG * srcA) / 255;                                              \
+            srcB = (srcB * srcA) / 255;                                              \
+        }                                                                            \
+    }                                                                                \
+    switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) { \
+    case 0:                                                                          \
+        dstR = srcR;                                                                 \
+        dstG = srcG;                                                                 \
+        dstB = srcB;                                                                 \
+        dstA = srcA;                                                                 \
+        break;                                                                       \
+    case SDL_COPY_BLEND:                                                             \
+        dstR = srcR + ((255 - srcA) * dstR) / 255;                                   \
+        dstG = srcG + ((255 - srcA) * dstG) / 255;                                   \
+        dstB = srcB + ((255 - srcA) * dstB) / 255;                                   \
+        dstA = srcA + ((255 - srcA) * dstA) / 255;                                   \
+        break;                                                                       \
+    case SDL_COPY_ADD:                                                               \
+        dstR = srcR + dstR;                                                          \
+        if (dstR > 255) {                                                            \
+            dstR = 255;                                                              \
+        }                                                                            \
+        dstG = srcG + dstG;                                                          \
+        if (dstG > 255) {                                                            \
+            dstG = 255;                                                              \
+        }                                                                            \
+        dstB = srcB + dstB;                                                          \
+        if (dstB > 255) {                                                            \
+            dstB = 255;                                                              \
+        }                                                                            \
+        break;                                                                       \
+    case SDL_COPY_MOD:                                                               \
+        dstR = (srcR * dstR) / 255;                                                  \
+        dstG = (srcG * dstG) / 255;                                                  \
+        dstB = (srcB * dstB) / 255;                                                  \
+        break;                                                                       \
+    case SDL_COPY_MUL:                                                               \
+        dstR = ((srcR * dstR) + (dstR * (255 - srcA))) / 255;                        \
+        if (dstR > 255) {                                                            \
+            dstR = 255;                                                              \
+        }                                                                            \
+        dstG = ((srcG * dstG) + (dstG * (255 - srcA))) / 255;                        \
+        if (dstG > 255) {                                                            \
+            dstG = 255;                                                              \
+        }                                                                            \
+        dstB = ((srcB * dstB) + (dstB * (255 - srcA))) / 255;                        \
+        if (dstB > 255) {                                                            \
+            dstB = 255;                                                              \
+        }                                                                            \
+        break;                                                                       \
+    }
+
+/* Exact incremental evaluation of (n + x * dn) / d, for d > 0
+ * The value is kept as a floored quotient and a remainder in [0, d),
+ * and converted back to the truncated result of the integer division it replaces.
+ */
+typedef struct
+{
+    Sint64 q;
+    Sint64 r;
+} TriangleFraction;
+
+static void triangle_fraction(Sint64 n, Sint64 d, TriangleFraction *f)
+{
+    f->q = n / d;
+    f->r = n % d;
+    if (f->r < 0) {
+        f->q--;
+        f->r += d;
+    }
+}
+
+#define TRIANGLE_FRACTION_VALUE(f) ((int)((f).q + ((f).q < 0 && (f).r != 0)))
+
+#define TRIANGLE_FRACTION_STEP(f, step, d)          \
+    {                                               \
+        const Sint64 carry = ((f).r + (step).r >= (d)); \
+        (f).q += (step).q + carry;                  \
+        (f).r += (step).r - ((d) & -carry);         \
+    }
+
 bool SDL_SW_FillTriangle(SDL_Surface *dst, SDL_Point *d0, SDL_Point *d1, SDL_Point *d2, SDL_BlendMode blend, SDL_Color c0, SDL_Color c1, SDL_Color c2)
 {
     bool result = true;
@@ -713,10 +846,17 @@ bool SDL_SW_BlitTriangle(
         CHECK_INT_RANGE(w0_row);
         CHECK_INT_RANGE(w1_row);
         CHECK_INT_RANGE(w2_row);
-        SDL_BlitTriangle_Slow(&tmp_info, s2_x_area, dstrect, (int)area, bias_w0, bias_w1, bias_w2,
-                              d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
-                              s2s0_x, s2s1_x, s2s0_y, s2s1_y, (int)w0_row, (int)w1_row, (int)w2_row,
-                              c0, c1, c2, is_uniform, texture_address_mode);
+        if (SDL_BlitTriangle_CanUseSpan8888(&tmp_info)) {
+            SDL_BlitTriangle_Span8888(&tmp_info, s2_x_area, dstrect, (int)area, bias_w0, bias_w1, bias_w2,
+                                      d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
+                                      s2s0_x, s2s1_x, s2s0_y, s2s1_y, (int)w0_row, (int)w1_row, (int)w2_row,
+                                      c0, c1, c2, is_uniform, texture_address_mode);
+        } else {
+            SDL_BlitTriangle_Slow(&tmp_info, s2_x_area, dstrect, (int)area, bias_w0, bias_w1, bias_w2,
+                                  d2d1_y, d1d2_x, d0d2_y, d2d0_x, d1d0_y, d0d1_x,
+                                  s2s0_x, s2s1_x, s2s0_y, s2s1_y, (int)w0_row, (int)w1_row, (int)w2_row,
+                                  c0, c1, c2, is_uniform, texture_address_mode);
+        }
 
         goto end;
     }
@@ -865,69 +1005,7 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
             modulateA = a;
         }
 
-        if (flags & SDL_COPY_MODULATE_COLOR) {
-            srcR = (srcR * modulateR) / 255;
-            srcG = (srcG * modulateG) / 255;
-            srcB = (srcB * modulateB) / 255;
-        }
-        if (flags & SDL_COPY_MODULATE_ALPHA) {
-            srcA = (srcA * modulateA) / 255;
-        }
-        if (flags & (SDL_COPY_BLEND | SDL_COPY_ADD)) {
-            // This goes away if we ever use premultiplied alpha
-            if (srcA < 255) {
-                srcR = (srcR * srcA) / 255;
-                srcG = (srcG * srcA) / 255;
-                srcB = (srcB * srcA) / 255;
-            }
-        }
-        switch (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) {
-        case 0:
-            dstR = srcR;
-            dstG = srcG;
-            dstB = srcB;
-            dstA = srcA;
-            break;
-        case SDL_COPY_BLEND:
-            dstR = srcR + ((255 - srcA) * dstR) / 255;
-            dstG = srcG + ((255 - srcA) * dstG) / 255;
-            dstB = srcB + ((255 - srcA) * dstB) / 255;
-            dstA = srcA + ((255 - srcA) * dstA) / 255;
-            break;
-        case SDL_COPY_ADD:
-            dstR = srcR + dstR;
-            if (dstR > 255) {
-                dstR = 255;
-            }
-            dstG = srcG + dstG;
-            if (dstG > 255) {
-                dstG = 255;
-            }
-            dstB = srcB + dstB;
-            if (dstB > 255) {
-                dstB = 255;
-            }
-            break;
-        case SDL_COPY_MOD:
-            dstR = (srcR * dstR) / 255;
-            dstG = (srcG * dstG) / 255;
-            dstB = (srcB * dstB) / 255;
-            break;
-        case SDL_COPY_MUL:
-            dstR = ((srcR * dstR) + (dstR * (255 - srcA))) / 255;
-            if (dstR > 255) {
-                dstR = 255;
-            }
-            dstG = ((srcG * dstG) + (dstG * (255 - srcA))) / 255;
-            if (dstG > 255) {
-                dstG = 255;
-            }
-            dstB = ((srcB * dstB) + (dstB * (255 - srcA))) / 255;
-            if (dstB > 255) {
-                dstB = 255;
-            }
-            break;
-        }
+        TRIANGLE_MODULATE_AND_BLEND
         if (FORMAT_HAS_ALPHA(dstfmt_val)) {
             ASSEMBLE_RGBA(dst, dstbpp, dst_fmt, dstR, dstG, dstB, dstA);
         } else if (FORMAT_HAS_NO_ALPHA(dstfmt_val)) {
@@ -942,4 +1020,157 @@ static void SDL_BlitTriangle_Slow(SDL_BlitInfo *info,
     TRIANGLE_END_LOOP
 }
 
+
+static bool SDL_BlitTriangle_CanUseSpan8888(const SDL_BlitInfo *info)
+{
+    const SDL_PixelFormatDetails *src_fmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
+
+    if (info->flags & SDL_COPY_COLORKEY) {
+        return false;
+    }
+    if (src_fmt->bytes_per_pixel != 4 || dst_fmt->bytes_per_pixel != 4) {
+        return false;
+    }
+    if (src_fmt->Rbits != 8 || src_fmt->Gbits != 8 || src_fmt->Bbits != 8 || (src_fmt->Amask && src_fmt->Abits != 8)) {
+        return false;
+    }
+    if (dst_fmt->Rbits != 8 || dst_fmt->Gbits != 8 || dst_fmt->Bbits != 8 || (dst_fmt->Amask && dst_fmt->Abits != 8)) {
+        return false;
+    }
+    return true;
+}
+
+/* Same output as SDL_BlitTriangle_Slow, for 32-bit formats with 8 bits per channel
+ * Texture coordinates and colors are stepped along each span instead of
+ * being divided out at every pixel, and pixels are unpacked with plain shifts.
+ */
+static void SDL_BlitTriangle_Span8888(SDL_BlitInfo *info,
+                                      SDL_Point s2_x_area, SDL_Rect dstrect, int area, int bias_w0, int bias_w1, int bias_w2,
+                                      int d2d1_y, int d1d2_x, int d0d2_y, int d2d0_x, int d1d0_y, int d0d1_x,
+                                      int s2s0_x, int s2s1_x, int s2s0_y, int s2s1_y, int w0_row, int w1_row, int w2_row,
+                                      SDL_Color c0, SDL_Color c1, SDL_Color c2, bool is_uniform, SDL_TextureAddressMode texture_address_mode)
+{
+    const int flags = info->flags;
+    const bool wrap = (texture_address_mode == SDL_TEXTURE_ADDRESS_WRAP);
+    const bool read_dst = (flags & (SDL_COPY_BLEND | SDL_COPY_ADD | SDL_COPY_MOD | SDL_COPY_MUL)) != 0;
+    const int src_w = info->src_surface->w;
+    const int src_h = info->src_surface->h;
+    const Uint8 *src_pixels = info->src;
+    const int src_pitch = info->src_pitch;
+    const SDL_PixelFormatDetails *src_fmt = info->src_fmt;
+    const SDL_PixelFormatDetails *dst_fmt = info->dst_fmt;
+    const Uint8 src_Rshift = src_fmt->Rshift, src_Gshift = src_fmt->Gshift, src_Bshift = src_fmt->Bshift, src_Ashift = src_fmt->Ashift;
+    const Uint8 dst_Rshift = dst_fmt->Rshift, dst_Gshift = dst_fmt->Gshift, dst_Bshift = dst_fmt->Bshift, dst_Ashift = dst_fmt->Ashift;
+    const bool src_has_alpha = (src_fmt->Amask != 0);
+    const bool dst_has_alpha = (dst_fmt->Amask != 0);
+    Uint32 modulateR = info->r;
+    Uint32 modulateG = info->g;
+    Uint32 modulateB = info->b;
+    Uint32 modulateA = info->a;
+    Uint32 srcpixel;
+    Uint32 srcR, srcG, srcB, srcA;
+    Uint32 dstpixel;
+    Uint32 dstR, dstG, dstB, dstA;
+    TriangleFraction step_u, step_v, step_r, step_g, step_b, step_a;
+    Uint8 *dst_ptr = info->dst;
+    const int dst_pitch = info->dst_pitch;
+    int x, y;
+
+    // Per-pixel increments of the interpolated numerators
+    triangle_fraction((Sint64)d2d1_y * s2s0_x + (Sint64)d0d2_y * s2s1_x, area, &step_u);
+    triangle_fraction((Sint64)d2d1_y * s2s0_y + (Sint64)d0d2_y * s2s1_y, area, &step_v);
+    triangle_fraction((Sint64)d2d1_y * c0.r + (Sint64)d0d2_y * c1.r + (Sint64)d1d0_y * c2.r, area, &step_r);
+    triangle_fraction((Sint64)d2d1_y * c0.g + (Sint64)d0d2_y * c1.g + (Sint64)d1d0_y * c2.g, area, &step_g);
+    triangle_fraction((Sint64)d2d1_y * c0.b + (Sint64)d0d2_y * c1.b + (Sint64)d1d0_y * c2.b, area, &step_b);
+    triangle_fraction((Sint64)d2d1_y * c0.a + (Sint64)d0d2_y * c1.a + (Sint64)d1d0_y * c2.a, area, &step_a);
+
+    for (y = 0; y < dstrect.h; y++) {
+        int x_start = 0, x_end = dstrect.w;
+
+        triangle_clip_span((Sint64)w0_row + bias_w0, d2d1_y, &x_start, &x_end);
+        triangle_clip_span((Sint64)w1_row + bias_w1, d0d2_y, &x_start, &x_end);
+        triangle_clip_span((Sint64)w2_row + bias_w2, d1d0_y, &x_start, &x_end);
+
+        if (x_start < x_end) {
+            const Sint64 w0 = w0_row + (Sint64)x_start * d2d1_y;
+            const Sint64 w1 = w1_row + (Sint64)x_start * d0d2_y;
+            const Sint64 w2 = w2_row + (Sint64)x_start * d1d0_y;
+            Uint32 *dst = (Uint32 *)(dst_ptr + x_start * 4);
+            TriangleFraction u, v, r, g, b, a;
+
+            triangle_fraction(w0 * s2s0_x + w1 * s2s1_x + s2_x_area.x, area, &u);
+            triangle_fraction(w0 * s2s0_y + w1 * s2s1_y + s2_x_area.y, area, &v);
+            if (!is_uniform) {
+                triangle_fraction(w0 * c0.r + w1 * c1.r + w2 * c2.r, area, &r);
+                triangle_fraction(w0 * c0.g + w1 * c1.g + w2 * c2.g, area, &g);
+                triangle_fraction(w0 * c0.b + w1 * c1.b + w2 * c2.b, area, &b);
+                triangle_fraction(w0 * c0.a + w1 * c1.a + w2 * c2.a, area, &a);
+            } else {
+                SDL_zero(r);
+                SDL_zero(g);
+                SDL_zero(b);
+                SDL_zero(a);
+            }
+
+            for (x = x_start; x < x_end; x++, dst++) {
+                int srcx = TRIANGLE_FRACTION_VALUE(u);
+                int srcy = TRIANGLE_FRACTION_VALUE(v);
+                if (wrap) {
+                    srcx %= src_w;
+                    if (srcx < 0) {
+                        srcx += (src_w - 1);
+                    }
+                    srcy %= src_h;
+                    if (srcy < 0) {
+                        srcy += (src_h - 1);
+                    }
+                }
+                TRIANGLE_FRACTION_STEP(u, step_u, area);
+                TRIANGLE_FRACTION_STEP(v, step_v, area);
+
+                srcpixel = *(const Uint32 *)(src_pixels + srcy * src_pitch + srcx * 4);
+                srcR = (srcpixel >> src_Rshift) & 0xFF;
+                srcG = (srcpixel >> src_Gshift) & 0xFF;
+                srcB = (srcpixel >> src_Bshift) & 0xFF;
+                srcA = src_has_alpha ? ((srcpixel >> src_Ashift) & 0xFF) : 0xFF;
+
+                if (read_dst) {
+                    dstpixel = *dst;
+                    dstR = (dstpixel >> dst_Rshift) & 0xFF;
+                    dstG = (dstpixel >> dst_Gshift) & 0xFF;
+                    dstB = (dstpixel >> dst_Bshift) & 0xFF;
+                    dstA = dst_has_alpha ? ((dstpixel >> dst_Ashift) & 0xFF) : 0xFF;
+                } else {
+                    dstR = dstG = dstB = dstA = 0;
+                }
+
+                if (!is_uniform) {
+                    modulateR = TRIANGLE_FRACTION_VALUE(r);
+                    modulateG = TRIANGLE_FRACTION_VALUE(g);
+                    modulateB = TRIANGLE_FRACTION_VALUE(b);
+                    modulateA = TRIANGLE_FRACTION_VALUE(a);
+                    TRIANGLE_FRACTION_STEP(r, step_r, area);
+                    TRIANGLE_FRACTION_STEP(g, step_g, area);
+                    TRIANGLE_FRACTION_STEP(b, step_b, area);
+                    TRIANGLE_FRACTION_STEP(a, step_a, area);
+                }
+
+                TRIANGLE_MODULATE_AND_BLEND
+
+                dstpixel = (dstR << dst_Rshift) | (dstG << dst_Gshift) | (dstB << dst_Bshift);
+                if (dst_has_alpha) {
+                    dstpixel |= (dstA << dst_Ashift);
+                }
+                *dst = dstpixel;
+            }
+        }
+
+        w0_row += d1d2_x;
+        w1_row += d2d0_x;
+        w2_row += d0d1_x;
+        dst_ptr += dst_pitch;
+    }
+}
+
 #endif // SDL_VIDEO_RENDER_SW
@@ -21,10 +21,14 @@
 #include "SDL_internal.h"
 
 #include "SDL_timer_c.h"
+#include "../SDL_hashtable.h"
 #include "../thread/SDL_systhread.h"
 
 // #define DEBUG_TIMERS
 
+// The most worker threads SDL_HINT_TIMER_WORKER_THREADS can ask for
+#define SDL_MAX_TIMER_WORKER_THREADS 64
+
 #if !defined(SDL_PLATFORM_EMSCRIPTEN) || !defined(SDL_THREADS_DISABLED)
 
 typedef struct SDL_Timer
@@ -35,24 +39,20 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 dispatched;
     SDL_AtomicInt canceled;
+    SDL_SpinLock stats_lock;
+    SDL_TimerStats stats;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-// The timers are kept in a sorted list
+// The timers are kept in a binary min-heap ordered by scheduling time
 typedef struct
 {
     // Data used by the main thread
     SDL_InitState init;
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     // Padding to separate cache lines between threads
@@ -65,8 +65,18 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    // List of timers - this is only touched by the timer thread
-    SDL_Timer *timers;
+    // Heap of timers - this is only touched by the timer thread
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+
+    // Worker threads running timer callbacks, if SDL_HINT_TIMER_WORKER_THREADS is set
+    SDL_Thread **workers;
+    int num_workers;
+    SDL_Mutex *work_lock;
+    SDL_Condition *work_cond;
+    SDL_Timer *work_head;
+    SDL_Timer *work_tail;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -77,24 +87,140 @@ static SDL_TimerData SDL_timer_data;
  * Timers are removed by simply setting a canceled flag
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+static bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
 {
-    SDL_Timer *prev, *curr;
+    int i;
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+    if (data->num_timers == data->max_timers) {
+        const int max_timers = data->max_timers ? data->max_timers * 2 : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return false;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    // Sift the new timer up from the bottom of the heap
+    for (i = data->num_timers++; i > 0; ) {
+        const int parent = (i - 1) / 2;
+        if (data->timers[parent]->scheduled <= timer->scheduled) {
             break;
         }
+        data->timers[i] = data->timers[parent];
+        i = parent;
     }
+    data->timers[i] = timer;
+    return true;
+}
+
+static SDL_Timer *SDL_RemoveFirstTimer(SDL_TimerData *data)
+{
+    SDL_Timer *first = data->timers[0];
+    SDL_Timer *last = data->timers[--data->num_timers];
+    const int count = data->num_timers;
+    int i = 0;
+
+    // Sift the last timer down from the top of the heap
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1 < count && data->timers[child + 1]->scheduled < data->timers[child]->scheduled) {
+            ++child;
+        }
+        if (last->scheduled <= data->timers[child]->scheduled) {
+            break;
+        }
+        data->timers[i] = data->timers[child];
+        i = child;
+    }
+    if (count > 0) {
+        data->timers[i] = last;
+    }
+    return first;
+}
 
-    // Insert the timer here!
-    if (prev) {
-        prev->next = timer;
+// Run a timer's callback, returns the interval until it should run again, or 0 if it's done
+static Uint64 SDL_DispatchTimer(SDL_Timer *timer)
+{
+    Uint64 now, lateness;
+
+    if (SDL_GetAtomicInt(&timer->canceled)) {
+        return 0;
+    }
+
+    now = SDL_GetTicksNS();
+    lateness = (now > timer->scheduled) ? (now - timer->scheduled) : 0;
+    SDL_LockSpinlock(&timer->stats_lock);
+    {
+        ++timer->stats.count;
+        timer->stats.last_lateness_ns = lateness;
+        if (lateness > timer->stats.max_lateness_ns) {
+            timer->stats.max_lateness_ns = lateness;
+        }
+        timer->stats.total_lateness_ns += lateness;
+    }
+    SDL_UnlockSpinlock(&timer->stats_lock);
+
+    if (timer->callback_ms) {
+        return SDL_MS_TO_NS(timer->callback_ms(timer->userdata, timer->timerID, (Uint32)SDL_NS_TO_MS(timer->interval)));
     } else {
-        data->timers = timer;
+        return timer->callback_ns(timer->userdata, timer->timerID, timer->interval);
     }
-    timer->next = curr;
+}
+
+/* With worker threads, the timer thread hands each expired timer to the work
+ * queue. A timer is out of the heap while its callback runs, so it can't be
+ * dispatched again until the worker passes it back through the pending list.
+ */
+static int SDLCALL SDL_TimerWorkerThread(void *_data)
+{
+    SDL_TimerData *data = (SDL_TimerData *)_data;
+    SDL_Timer *current;
+    Uint64 interval;
+
+    for (;;) {
+        SDL_LockMutex(data->work_lock);
+        while (!data->work_head && SDL_GetAtomicInt(&data->active)) {
+            SDL_WaitCondition(data->work_cond, data->work_lock);
+        }
+        current = NULL;
+        if (SDL_GetAtomicInt(&data->active)) {
+            current = data->work_head;
+            data->work_head = current->next;
+            if (!data->work_head) {
+                data->work_tail = NULL;
+            }
+        }
+        SDL_UnlockMutex(data->work_lock);
+
+        if (!current) {
+            break; // shutting down
+        }
+
+        interval = SDL_DispatchTimer(current);
+
+        SDL_LockSpinlock(&data->lock);
+        if (interval > 0) {
+            // Send the timer back to the timer thread to be rescheduled
+            current->interval = interval;
+            current->scheduled = current->dispatched + interval;
+            current->next = data->pending;
+            data->pending = current;
+        } else {
+            SDL_SetAtomicInt(&current->canceled, 1);
+            current->next = data->freelist;
+            data->freelist = current;
+        }
+        SDL_UnlockSpinlock(&data->lock);
+
+        if (interval > 0) {
+            SDL_SignalSemaphore(data->sem);
+        }
+    }
+    return 0;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -102,6 +228,8 @@ static int SDLCALL SDL_TimerThread(void *_data)
     SDL_TimerData *data = (SDL_TimerData *)_data;
     SDL_Timer *pending;
     SDL_Timer *current;
+    SDL_Timer *expired;
+    SDL_Timer *expired_last;
     SDL_Timer *freelist_head = NULL;
     SDL_Timer *freelist_tail = NULL;
     Uint64 tick, now, interval, delay;
@@ -127,64 +255,95 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_UnlockSpinlock(&data->lock);
 
-        // Sort the pending timers into our list
+        freelist_head = NULL;
+        freelist_tail = NULL;
+
+        // Sort the pending timers into our heap
         while (pending) {
             current = pending;
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
+            if (!SDL_AddTimerInternal(data, current)) {
+                // Out of memory, the timer can't be scheduled
+                SDL_SetAtomicInt(&current->canceled, 1);
+                current->next = freelist_head;
+                freelist_head = current;
+                if (!freelist_tail) {
+                    freelist_tail = current;
+                }
+            }
         }
-        freelist_head = NULL;
-        freelist_tail = NULL;
 
         // Check to see if we're still running, after maintenance
         if (!SDL_GetAtomicInt(&data->active)) {
             break;
         }
 
-        // Initial delay if there are no timers
-        delay = (Uint64)-1;
-
         tick = SDL_GetTicksNS();
 
-        // Process all the pending timers for this tick
-        while (data->timers) {
-            current = data->timers;
-
-            if (tick < current->scheduled) {
-                // Scheduled for the future, wait a bit
-                delay = (current->scheduled - tick);
-                break;
+        // Take all the timers that expire this tick out of the heap
+        expired = NULL;
+        expired_last = NULL;
+        while (data->num_timers > 0 && data->timers[0]->scheduled <= tick) {
+            current = SDL_RemoveFirstTimer(data);
+            current->dispatched = tick;
+            current->next = NULL;
+            if (expired_last) {
+                expired_last->next = current;
+            } else {
+                expired = current;
             }
+            expired_last = current;
+        }
 
-            // We're going to do something with this timer
-            data->timers = current->next;
-
-            if (SDL_GetAtomicInt(&current->canceled)) {
-                interval = 0;
+        if (expired && data->num_workers > 0) {
+            // Hand them to the worker threads, they come back through the pending list
+            SDL_LockMutex(data->work_lock);
+            if (data->work_tail) {
+                data->work_tail->next = expired;
             } else {
-                if (current->callback_ms) {
-                    interval = SDL_MS_TO_NS(current->callback_ms(current->userdata, current->timerID, (Uint32)SDL_NS_TO_MS(current->interval)));
-                } else {
-                    interval = current->callback_ns(current->userdata, current->timerID, current->interval);
-                }
+                data->work_head = expired;
             }
+            data->work_tail = expired_last;
+            SDL_BroadcastCondition(data->work_cond);
+            SDL_UnlockMutex(data->work_lock);
+            expired = NULL;
+        }
+
+        // Dispatch them in scheduling order, then put back the ones that repeat
+        while (expired) {
+            current = expired;
+            expired = current->next;
+
+            interval = SDL_DispatchTimer(current);
 
             if (interval > 0) {
                 // Reschedule this timer
                 current->interval = interval;
                 current->scheduled = tick + interval;
-                SDL_AddTimerInternal(data, current);
-            } else {
-                if (!freelist_head) {
-                    freelist_head = current;
-                }
-                if (freelist_tail) {
-                    freelist_tail->next = current;
+                if (SDL_AddTimerInternal(data, current)) {
+                    continue;
                 }
-                freelist_tail = current;
+                // Out of memory, the timer can't be rescheduled
+            }
 
-                SDL_SetAtomicInt(&current->canceled, 1);
+            current->next = NULL;
+            if (!freelist_head) {
+                freelist_head = current;
+            }
+            if (freelist_tail) {
+                freelist_tail->next = current;
             }
+            freelist_tail = current;
+
+            SDL_SetAtomicInt(&current->canceled, 1);
+        }
+
+        if (data->num_timers > 0) {
+            // Wait until the next timer is scheduled
+            delay = (data->timers[0]->scheduled - tick);
+        } else {
+            // No timers, wait until one is added
+            delay = (Uint64)-1;
         }
 
         // Adjust the delay based on processing time
@@ -209,6 +368,8 @@ static int SDLCALL SDL_TimerThread(void *_data)
 bool SDL_InitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
+    const char *hint;
+    int i, num_workers;
 
     if (!SDL_ShouldInit(&data->init)) {
         return true;
@@ -219,6 +380,11 @@ bool SDL_InitTimers(void)
         goto error;
     }
 
+    data->timermap = SDL_CreateHashTable(NULL, 64, SDL_HashID, SDL_KeyMatchID, NULL, false, false);
+    if (!data->timermap) {
+        goto error;
+    }
+
     data->sem = SDL_CreateSemaphore(0);
     if (!data->sem) {
         goto error;
@@ -226,6 +392,37 @@ bool SDL_InitTimers(void)
 
     SDL_SetAtomicInt(&data->active, true);
 
+    // Start the worker threads first, the timer thread hands timers to them if there are any
+    hint = SDL_GetHint(SDL_HINT_TIMER_WORKER_THREADS);
+    num_workers = hint ? SDL_atoi(hint) : 0;
+    num_workers = SDL_min(num_workers, SDL_MAX_TIMER_WORKER_THREADS);
+    if (num_workers > 0) {
+        data->work_lock = SDL_CreateMutex();
+        if (!data->work_lock) {
+            goto error;
+        }
+        data->work_cond = SDL_CreateCondition();
+        if (!data->work_cond) {
+            goto error;
+        }
+        data->workers = (SDL_Thread **)SDL_calloc(num_workers, sizeof(*data->workers));
+        if (!data->workers) {
+            goto error;
+        }
+        for (i = 0; i < num_workers; ++i) {
+            char name[32];
+
+            SDL_snprintf(name, sizeof(name), "SDLTimerWorker%d", i);
+
+            // Timer threads use a callback into the app, so we can't set a limited stack size here.
+            data->workers[i] = SDL_CreateThread(SDL_TimerWorkerThread, name, data);
+            if (!data->workers[i]) {
+                goto error;
+            }
+            ++data->num_workers;
+        }
+    }
+
     // Timer threads use a callback into the app, so we can't set a limited stack size here.
     data->thread = SDL_CreateThread(SDL_TimerThread, "SDLTimer", data);
     if (!data->thread) {
@@ -245,7 +442,7 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    int i;
 
     if (!SDL_ShouldQuit(&data->init)) {
         return;
@@ -260,15 +457,50 @@ void SDL_QuitTimers(void)
         data->thread = NULL;
     }
 
+    // Shutdown the worker threads, after the timer thread so nothing else is queued for them
+    if (data->workers) {
+        SDL_LockMutex(data->work_lock);
+        SDL_BroadcastCondition(data->work_cond);
+        SDL_UnlockMutex(data->work_lock);
+        for (i = 0; i < data->num_workers; ++i) {
+            SDL_WaitThread(data->workers[i], NULL);
+        }
+        SDL_free(data->workers);
+        data->workers = NULL;
+        data->num_workers = 0;
+    }
+    if (data->work_cond) {
+        SDL_DestroyCondition(data->work_cond);
+        data->work_cond = NULL;
+    }
+    if (data->work_lock) {
+        SDL_DestroyMutex(data->work_lock);
+        data->work_lock = NULL;
+    }
+
     if (data->sem) {
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
     }
 
     // Clean up the timer entries
-    while (data->timers) {
-        timer = data->timers;
-        data->timers = timer->next;
+    for (i = 0; i < data->num_timers; ++i) {
+        SDL_free(data->timers[i]);
+    }
+    SDL_free(data->timers);
+    data->timers = NULL;
+    data->num_timers = 0;
+    data->max_timers = 0;
+
+    while (data->work_head) {
+        timer = data->work_head;
+        data->work_head = timer->next;
+        SDL_free(timer);
+    }
+    data->work_tail = NULL;
+    while (data->pending) {
+        timer = data->pending;
+        data->pending = timer->next;
         SDL_free(timer);
     }
     while (data->freelist) {
@@ -276,10 +508,10 @@ void SDL_QuitTimers(void)
         data->freelist = timer->next;
         SDL_free(timer);
     }
-    while (data->timermap) {
-        entry = data->timermap;
-        data->timermap = entry->next;
-        SDL_free(entry);
+
+    if (data->timermap) {
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
     }
 
     if (data->timermap_lock) {
@@ -299,7 +531,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    bool added;
 
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -318,7 +550,10 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     SDL_UnlockSpinlock(&data->lock);
 
     if (timer) {
-        SDL_RemoveTimer(timer->timerID);
+        // The old timer ID may still be in the map if it was never removed
+        SDL_LockMutex(data->timermap_lock);
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID);
+        SDL_UnlockMutex(data->timermap_lock);
     } else {
         timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
         if (!timer) {
@@ -332,19 +567,16 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->interval = interval;
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_SetAtomicInt(&timer->canceled, 0);
+    timer->stats_lock = 0;
+    SDL_zero(timer->stats);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
+    SDL_LockMutex(data->timermap_lock);
+    added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer);
+    SDL_UnlockMutex(data->timermap_lock);
+    if (!added) {
         SDL_free(timer);
         return 0;
     }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
 
     // Add the timer to the pending list for the timer thread
     SDL_LockSpinlock(&data->lock);
@@ -355,7 +587,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     // Wake up the timer thread if necessary
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timer->timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
@@ -371,7 +603,7 @@ SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *
 bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    const void *value;
     bool canceled = false;
 
     if (!id) {
@@ -380,26 +612,17 @@ bool SDL_RemoveTimer(SDL_TimerID id)
 
     // Find the timer
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
-    }
-    SDL_UnlockMutex(data->timermap_lock);
+    if (data->timermap && SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, &value)) {
+        SDL_Timer *timer = (SDL_Timer *)value;
 
-    if (entry) {
-        if (!SDL_GetAtomicInt(&entry->timer->canceled)) {
-            SDL_SetAtomicInt(&entry->timer->canceled, 1);
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
+        if (!SDL_GetAtomicInt(&timer->canceled)) {
+            SDL_SetAtomicInt(&timer->canceled, 1);
             canceled = true;
         }
-        SDL_free(entry);
     }
+    SDL_UnlockMutex(data->timermap_lock);
+
     if (canceled) {
         return true;
     } else {
@@ -407,6 +630,36 @@ bool SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+bool SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    const void *value;
+    bool found = false;
+
+    if (!id) {
+        return SDL_InvalidParamError("id");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(data->timermap_lock);
+    if (data->timermap && SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, &value)) {
+        SDL_Timer *timer = (SDL_Timer *)value;
+
+        SDL_LockSpinlock(&timer->stats_lock);
+        SDL_copyp(stats, &timer->stats);
+        SDL_UnlockSpinlock(&timer->stats_lock);
+        found = true;
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    if (!found) {
+        return SDL_SetError("Timer not found");
+    }
+    return true;
+}
+
 #else
 
 #include <emscripten/emscripten.h>
@@ -533,6 +786,11 @@ bool SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+bool SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    return SDL_Unsupported();
+}
+
 #endif // !SDL_PLATFORM_EMSCRIPTEN || !SDL_THREADS_DISABLED
 
 static Uint64 tick_start;
@@ -732,3 +990,133 @@ void SDL_DelayPrecise(Uint64 ns)
         current_value = SDL_GetTicksNS();
     }
 }
+
+#define SDL_FRAME_PACER_MIN_SPIN_NS 20000        // 20 us
+#define SDL_FRAME_PACER_INITIAL_SPIN_NS 1000000  // 1 ms
+#define SDL_FRAME_PACER_RESET_NS 1000000000      // restart the timeline after falling this far behind
+
+void SDL_SetFramePacerPeriod(SDL_FramePacer *pacer, Uint64 period_ns)
+{
+    if (period_ns != pacer->period_ns) {
+        pacer->period_ns = period_ns;
+        pacer->deadline = 0;
+    }
+}
+
+// Never spin for more than half a period, so most of every frame is spent sleeping
+static void SDL_ClampFramePacerSpin(SDL_FramePacer *pacer)
+{
+    const Uint64 max_spin = SDL_max(pacer->period_ns / 2, SDL_FRAME_PACER_MIN_SPIN_NS);
+
+    pacer->spin_threshold = SDL_clamp(pacer->spin_threshold, SDL_FRAME_PACER_MIN_SPIN_NS, max_spin);
+}
+
+static void SDL_UpdateFramePacerSpin(SDL_FramePacer *pacer, Uint64 overshoot)
+{
+    if (overshoot > pacer->spin_threshold) {
+        // Adapt quickly to a sleep that overshot, with a little margin
+        pacer->spin_threshold = overshoot + overshoot / 4;
+    } else {
+        // Slowly spin less while sleeps are accurate
+        pacer->spin_threshold -= (pacer->spin_threshold - overshoot) / 16;
+    }
+    SDL_ClampFramePacerSpin(pacer);
+}
+
+/* Called for waits that didn't sleep at all, because the frame ran long or missed
+   its deadline. There's no new overshoot sample, but the threshold still has to
+   shrink, or one bad sleep could leave the pacer spinning through every frame. */
+static void SDL_DecayFramePacerSpin(SDL_FramePacer *pacer)
+{
+    pacer->spin_threshold -= (pacer->spin_threshold - SDL_FRAME_PACER_MIN_SPIN_NS) / 16;
+    SDL_ClampFramePacerSpin(pacer);
+}
+
+static void SDL_RecordFramePacerJitter(SDL_FramePacer *pacer, Uint64 now)
+{
+    static const Uint64 limits[SDL_FRAME_PACER_JITTER_BUCKETS - 1] = {
+        10000, 50000, 100000, 250000, 500000, 1000000, 2000000
+    };
+    const Uint64 jitter = (now > pacer->deadline) ? (now - pacer->deadline) : (pacer->deadline - now);
+    int i;
+
+    for (i = 0; i < SDL_arraysize(limits); ++i) {
+        if (jitter < limits[i]) {
+            break;
+        }
+    }
+    ++pacer->stats.jitter[i];
+}
+
+/* Wait until the next deadline and return the current time. Deadlines advance by
+   exactly one period, so the timeline doesn't drift with how late each wait returns.
+   A frame that runs past its deadline skips to the next deadline on the timeline. */
+Uint64 SDL_WaitFramePacer(SDL_FramePacer *pacer)
+{
+    Uint64 now = SDL_GetTicksNS();
+
+    if (!pacer->period_ns) {
+        return now;
+    }
+
+    if (!pacer->deadline || now > pacer->deadline + SDL_FRAME_PACER_RESET_NS) {
+        // Start the timeline at the current time
+        pacer->deadline = now + pacer->period_ns;
+        if (!pacer->spin_threshold) {
+            pacer->spin_threshold = SDL_FRAME_PACER_INITIAL_SPIN_NS;
+        }
+        return now;
+    }
+
+    ++pacer->stats.frames;
+
+    if (now > pacer->deadline) {
+        // We missed this deadline, catch up with the timeline
+        ++pacer->stats.missed;
+        SDL_RecordFramePacerJitter(pacer, now);
+        SDL_DecayFramePacerSpin(pacer);
+        pacer->deadline += ((now - pacer->deadline) / pacer->period_ns + 1) * pacer->period_ns;
+        return now;
+    }
+
+    SDL_ClampFramePacerSpin(pacer);
+
+    if (now + pacer->spin_threshold >= pacer->deadline) {
+        SDL_DecayFramePacerSpin(pacer);
+    }
+
+    // Sleep until we're within the spin threshold, learning how much sleeps overshoot
+    while (now + pacer->spin_threshold < pacer->deadline) {
+        const Uint64 request = (pacer->deadline - now) - pacer->spin_threshold;
+        const Uint64 start = now;
+        Uint64 slept;
+
+        SDL_SYS_DelayNS(request);
+        now = SDL_GetTicksNS();
+
+        slept = (now - start);
+        SDL_UpdateFramePacerSpin(pacer, (slept > request) ? (slept - request) : 0);
+    }
+
+    // Spin for the rest of the wait
+    while (now < pacer->deadline) {
+        SDL_CPUPauseInstruction();
+        now = SDL_GetTicksNS();
+    }
+
+    SDL_RecordFramePacerJitter(pacer, now);
+    pacer->deadline += pacer->period_ns;
+    return now;
+}
+
+void SDL_LogFramePacerStats(const SDL_FramePacer *pacer, const char *name)
+{
+    const SDL_FramePacerStats *stats = &pacer->stats;
+
+    SDL_Log("SDL FRAME PACER (%s): %" SDL_PRIu64 " frames, %" SDL_PRIu64 " missed, spin threshold %" SDL_PRIu64 " us",
+            name, stats->frames, stats->missed, pacer->spin_threshold / SDL_NS_PER_US);
+    SDL_Log("SDL FRAME PACER (%s): jitter <10us: %" SDL_PRIu64 ", <50us: %" SDL_PRIu64 ", <100us: %" SDL_PRIu64 ", <250us: %" SDL_PRIu64
+            ", <500us: %" SDL_PRIu64 ", <1ms: %" SDL_PRIu64 ", <2ms: %" SDL_PRIu64 ", >=2ms: %" SDL_PRIu64,
+            name, stats->jitter[0], stats->jitter[1], stats->jitter[2], stats->jitter[3],
+            stats->jitter[4], stats->jitter[5], stats->jitter[6], stats->jitter[7]);
+}
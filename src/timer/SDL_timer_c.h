@@ -36,4 +36,29 @@ extern void SDL_QuitTimers(void);
 
 extern void SDL_SYS_DelayNS(Uint64 ns);
 
+/* A frame pacer waits until the next deadline on a fixed timeline of frame
+ * periods. It sleeps for most of the wait and spins for the last part. The
+ * spin threshold adapts to how far the system's sleeps actually overshoot.
+ * A zero-initialized pacer is ready to use once it has a period. */
+#define SDL_FRAME_PACER_JITTER_BUCKETS 8
+
+typedef struct SDL_FramePacerStats
+{
+    Uint64 frames;  // number of waits with a period set
+    Uint64 missed;  // waits that started after their deadline had passed
+    Uint64 jitter[SDL_FRAME_PACER_JITTER_BUCKETS];  // distance from the deadline when the wait returned: <10us, <50us, <100us, <250us, <500us, <1ms, <2ms, >=2ms
+} SDL_FramePacerStats;
+
+typedef struct SDL_FramePacer
+{
+    Uint64 period_ns;
+    Uint64 deadline;        // 0 if the timeline hasn't started
+    Uint64 spin_threshold;  // wait this close to the deadline by spinning rather than sleeping
+    SDL_FramePacerStats stats;
+} SDL_FramePacer;
+
+extern void SDL_SetFramePacerPeriod(SDL_FramePacer *pacer, Uint64 period_ns);
+extern Uint64 SDL_WaitFramePacer(SDL_FramePacer *pacer);
+extern void SDL_LogFramePacerStats(const SDL_FramePacer *pacer, const char *name);
+
 #endif // SDL_timer_c_h_
@@ -259,6 +259,258 @@ static int SDLCALL events_mainThreadCallbacks(void *arg)
     return TEST_COMPLETED;
 }
 
+static bool SDLCALL events_dropOddUserEvents(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_USER && (event->user.code % 2) != 0) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Pushes and polls events in batches, with an event filter dropping some.
+ *
+ * \sa SDL_PushEvents
+ * \sa SDL_PollEvents
+ */
+static int SDLCALL events_pushAndPollBatch(void *arg)
+{
+    SDL_Event events[32];
+    SDL_Event received[8];
+    int next_code = 0;
+    int total = 0;
+    int result;
+    int i;
+
+    /* Start from an empty queue */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < SDL_arraysize(events); ++i) {
+        SDL_zero(events[i]);
+        events[i].type = SDL_EVENT_USER;
+        events[i].user.code = i;
+    }
+
+    SDL_SetEventFilter(events_dropOddUserEvents, NULL);
+    result = SDL_PushEvents(events, SDL_arraysize(events));
+    SDLTest_AssertPass("Call to SDL_PushEvents()");
+    SDLTest_AssertCheck(result == SDL_arraysize(events), "Check all events were consumed, expected: %d, got: %d", (int)SDL_arraysize(events), result);
+    SDL_SetEventFilter(NULL, NULL);
+
+    /* Drain the queue in batches smaller than the number of events pushed */
+    while ((result = SDL_PollEvents(received, SDL_arraysize(received))) > 0) {
+        SDLTest_AssertCheck(result <= SDL_arraysize(received), "Check SDL_PollEvents() stays within the buffer, got: %d", result);
+        for (i = 0; i < result; ++i) {
+            if (received[i].type == SDL_EVENT_USER) {
+                SDLTest_AssertCheck(received[i].user.code == next_code, "Check event order, expected code: %d, got: %" SDL_PRIs32, next_code, received[i].user.code);
+                next_code = received[i].user.code + 2;
+                ++total;
+            }
+        }
+    }
+    SDLTest_AssertCheck(result == 0, "Check SDL_PollEvents() ends the poll cycle with 0, got: %d", result);
+    SDLTest_AssertCheck(total == SDL_arraysize(events) / 2, "Check only even events were queued, expected: %d, got: %d", (int)SDL_arraysize(events) / 2, total);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Checks that consecutive motion events are merged when SDL_HINT_EVENT_COALESCE_MOTION is set.
+ */
+static int SDLCALL events_coalesceMotion(void *arg)
+{
+    SDL_Event event;
+    int i;
+
+    /* Start from an empty queue */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "1");
+
+    /* Three motion events from one mouse, then one from another */
+    for (i = 0; i < 4; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.which = (i < 3) ? 1 : 2;
+        event.motion.x = (float)(10 * (i + 1));
+        event.motion.xrel = 10.0f;
+        event.motion.yrel = 1.0f;
+        SDL_PushEvent(&event);
+    }
+    SDLTest_AssertPass("Pushed 4 mouse motion events");
+
+    SDLTest_AssertCheck(SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION) == 2, "Check that 2 motion events are queued");
+
+    SDLTest_AssertCheck(SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION) == 1, "Get the merged motion event");
+    SDLTest_AssertCheck(event.motion.which == 1, "Check mouse id, expected: 1, got: %" SDL_PRIu32, event.motion.which);
+    SDLTest_AssertCheck(event.motion.x == 30.0f, "Check latest position is kept, expected: 30, got: %g", event.motion.x);
+    SDLTest_AssertCheck(event.motion.xrel == 30.0f && event.motion.yrel == 3.0f, "Check relative motion is summed, expected: 30,3, got: %g,%g", event.motion.xrel, event.motion.yrel);
+
+    SDLTest_AssertCheck(SDL_PeepEvents(&event, 1, SDL_GETEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION) == 1, "Get the second motion event");
+    SDLTest_AssertCheck(event.motion.which == 2 && event.motion.xrel == 10.0f, "Check motion from another mouse isn't merged");
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+
+    return TEST_COMPLETED;
+}
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+#define NUM_PRODUCER_THREADS     8
+#define EVENTS_PER_PRODUCER      20000
+
+typedef struct
+{
+    int index;
+    int failed_pushes;
+} EventProducerData;
+
+static int SDLCALL EventProducerThread(void *userdata)
+{
+    EventProducerData *data = (EventProducerData *)userdata;
+    int i;
+
+    for (i = 0; i < EVENTS_PER_PRODUCER; ++i) {
+        SDL_Event event;
+
+        SDL_zero(event);
+        event.type = SDL_EVENT_USER;
+        event.user.code = i;
+        event.user.data1 = (void *)(intptr_t)data->index;
+
+        /* Back off if the consumer has fallen far enough behind to fill the queue */
+        while (!SDL_PushEvent(&event)) {
+            ++data->failed_pushes;
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+/**
+ * Pushes events from several threads at once and checks that each thread's
+ * events arrive complete and in order, logging the throughput.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PollEvent
+ */
+static int SDLCALL events_multiProducerThroughput(void *arg)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+    SDL_Thread *threads[NUM_PRODUCER_THREADS];
+    EventProducerData data[NUM_PRODUCER_THREADS];
+    int next_code[NUM_PRODUCER_THREADS];
+    const int total = NUM_PRODUCER_THREADS * EVENTS_PER_PRODUCER;
+    int received = 0;
+    int out_of_order = 0;
+    int failed_pushes = 0;
+    Uint64 start, elapsed;
+    SDL_Event event;
+    int i;
+
+    /* Start from an empty queue */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < NUM_PRODUCER_THREADS; ++i) {
+        data[i].index = i;
+        data[i].failed_pushes = 0;
+        next_code[i] = 0;
+        threads[i] = SDL_CreateThread(EventProducerThread, "EventProducer", &data[i]);
+        SDLTest_AssertCheck(threads[i] != NULL, "Create producer thread %d", i);
+    }
+
+    while (received < total && SDL_GetTicksNS() - start < SDL_SECONDS_TO_NS(60)) {
+        if (!SDL_PollEvent(&event)) {
+            continue;
+        }
+        if (event.type == SDL_EVENT_USER) {
+            const int index = (int)(intptr_t)event.user.data1;
+            if (index >= 0 && index < NUM_PRODUCER_THREADS) {
+                if (event.user.code != next_code[index]) {
+                    ++out_of_order;
+                }
+                next_code[index] = event.user.code + 1;
+                ++received;
+            }
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    for (i = 0; i < NUM_PRODUCER_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+        failed_pushes += data[i].failed_pushes;
+    }
+
+    SDLTest_AssertCheck(received == total, "Check all events were received, expected: %d, got: %d", total, received);
+    SDLTest_AssertCheck(out_of_order == 0, "Check each producer's events arrived in order, got %d out of order", out_of_order);
+    SDLTest_Log("%d producer threads pushed %d events in %" SDL_PRIu64 " ms (%.0f events/sec, %d pushes retried)",
+                NUM_PRODUCER_THREADS, received, elapsed / SDL_NS_PER_MS,
+                elapsed ? (double)received * SDL_NS_PER_SECOND / elapsed : 0.0, failed_pushes);
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+static int SDLCALL EventFillerThread(void *userdata)
+{
+    int *pushed = (int *)userdata;
+    SDL_Event event;
+
+    SDL_zero(event);
+    event.type = SDL_EVENT_USER;
+    while (SDL_PushEvent(&event)) {
+        ++*pushed;
+    }
+    return 0;
+}
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+/**
+ * Fills the event queue from several threads at once and checks that no more
+ * events than the queue limit get in.
+ *
+ * \sa SDL_PushEvent
+ */
+static int SDLCALL events_queueLimit(void *arg)
+{
+#ifndef SDL_PLATFORM_EMSCRIPTEN /* Emscripten doesn't have threads */
+    /* SDL_MAX_QUEUED_EVENTS in SDL_events.c */
+    const int limit = 65535;
+    SDL_Thread *threads[NUM_PRODUCER_THREADS];
+    int pushed[NUM_PRODUCER_THREADS];
+    int total = 0;
+    int queued;
+    int i;
+
+    /* Start from an empty queue */
+    SDL_PumpEvents();
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < NUM_PRODUCER_THREADS; ++i) {
+        pushed[i] = 0;
+        threads[i] = SDL_CreateThread(EventFillerThread, "EventFiller", &pushed[i]);
+        SDLTest_AssertCheck(threads[i] != NULL, "Create filler thread %d", i);
+    }
+    for (i = 0; i < NUM_PRODUCER_THREADS; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+        total += pushed[i];
+    }
+
+    queued = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDLTest_AssertCheck(total == limit, "Check pushes accepted until the queue was full, expected: %d, got: %d", limit, total);
+    SDLTest_AssertCheck(queued == total, "Check every accepted event is queued, expected: %d, got: %d", total, queued);
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+#endif /* !SDL_PLATFORM_EMSCRIPTEN */
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -278,12 +530,32 @@ static const SDLTest_TestCaseReference eventsTest_mainThreadCallbacks = {
     events_mainThreadCallbacks, "events_mainThreadCallbacks", "Run callbacks on the main thread", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_pushAndPollBatch = {
+    events_pushAndPollBatch, "events_pushAndPollBatch", "Pushes and polls events in batches", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_coalesceMotion = {
+    events_coalesceMotion, "events_coalesceMotion", "Merges consecutive motion events in the queue", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_multiProducerThroughput = {
+    events_multiProducerThroughput, "events_multiProducerThroughput", "Pushes events from multiple threads and measures throughput", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_queueLimit = {
+    events_queueLimit, "events_queueLimit", "Fills the event queue from several threads", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
     &eventsTest_pushPumpAndPollUserevent,
     &eventsTest_addDelEventWatch,
     &eventsTest_addDelEventWatchWithUserdata,
     &eventsTest_mainThreadCallbacks,
+    &eventsTest_pushAndPollBatch,
+    &eventsTest_coalesceMotion,
+    &eventsTest_multiProducerThroughput,
+    &eventsTest_queueLimit,
     NULL
 };
 
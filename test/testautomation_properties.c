@@ -382,6 +382,239 @@ static int SDLCALL properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test lookups in large property sets, and log how long they take
+ */
+static int SDLCALL properties_testLookupScaling(void *arg)
+{
+    static const int sizes[] = { 1000, 10000, 100000, 1000000 };
+    const int max_count = sizes[SDL_arraysize(sizes) - 1];
+    char *names;
+    int i, j;
+
+    names = (char *)SDL_malloc((size_t)max_count * 16);
+    SDLTest_AssertCheck(names != NULL, "Allocate property names");
+    if (!names) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < max_count; ++i) {
+        SDL_snprintf(&names[i * 16], 16, "prop%d", i);
+    }
+
+    for (j = 0; j < SDL_arraysize(sizes); ++j) {
+        const int count = sizes[j];
+        const int lookups = 2000000;
+        SDL_PropertiesID props = SDL_CreateProperties();
+        Uint64 start, elapsed;
+        int found = 0;
+
+        for (i = 0; i < count; ++i) {
+            SDL_SetNumberProperty(props, &names[i * 16], i);
+        }
+
+        /* Look up existing names in a scattered order */
+        start = SDL_GetTicksNS();
+        for (i = 0; i < lookups; ++i) {
+            const int index = (int)(((Uint64)i * 2654435761u) % (Uint64)count);
+            if (SDL_GetNumberProperty(props, &names[index * 16], -1) == index) {
+                ++found;
+            }
+        }
+        elapsed = SDL_GetTicksNS() - start;
+        SDLTest_AssertCheck(found == lookups, "Check all lookups found their property, expected: %d, got: %d", lookups, found);
+        SDLTest_Log("%d properties: %.1f ns per lookup", count, (double)elapsed / lookups);
+
+        /* Remove every other property and check the rest are still there */
+        found = 0;
+        for (i = 0; i < count; i += 2) {
+            SDL_ClearProperty(props, &names[i * 16]);
+        }
+        for (i = 0; i < count; ++i) {
+            if (SDL_GetNumberProperty(props, &names[i * 16], -1) == ((i % 2) ? i : -1)) {
+                ++found;
+            }
+        }
+        SDLTest_AssertCheck(found == count, "Check properties after removing half, expected: %d, got: %d", count, found);
+
+        SDL_DestroyProperties(props);
+    }
+
+    SDL_free(names);
+
+    return TEST_COMPLETED;
+}
+
+#define CHURN_NAMES 512
+
+/* Check every name against the model, returns the number of mismatches */
+static int checkChurnedProperties(SDL_PropertiesID props, const char *names, const Sint64 *values)
+{
+    int i, mismatches = 0;
+
+    for (i = 0; i < CHURN_NAMES; ++i) {
+        if (SDL_GetNumberProperty(props, &names[i * 16], -1) != values[i]) {
+            ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+/* Fill the set up to `high` properties and drain it down to `low`, `cycles` times */
+static int churnProperties(SDL_PropertiesID props, const char *names, Sint64 *values, int *num_live, int low, int high, int cycles, Sint64 *generation)
+{
+    int i, index, mismatches = 0;
+
+    for (i = 0; i < cycles; ++i) {
+        while (*num_live < high) {
+            index = SDLTest_RandomIntegerInRange(0, CHURN_NAMES - 1);
+            if (values[index] < 0) {
+                /* Re-added names get a new value, so a stale entry would show up */
+                values[index] = ++*generation;
+                SDL_SetNumberProperty(props, &names[index * 16], values[index]);
+                ++*num_live;
+                mismatches += checkChurnedProperties(props, names, values);
+            }
+        }
+        while (*num_live > low) {
+            index = SDLTest_RandomIntegerInRange(0, CHURN_NAMES - 1);
+            if (values[index] >= 0) {
+                SDL_ClearProperty(props, &names[index * 16]);
+                values[index] = -1;
+                --*num_live;
+                mismatches += checkChurnedProperties(props, names, values);
+            }
+        }
+    }
+    return mismatches;
+}
+
+/**
+ * Test adding and removing properties in patterns that stress the hash table
+ */
+static int SDLCALL properties_testChurn(void *arg)
+{
+    char names[CHURN_NAMES * 16];
+    Sint64 values[CHURN_NAMES];
+    Sint64 generation = 0;
+    SDL_PropertiesID props;
+    int i, num_live = 0, mismatches;
+
+    for (i = 0; i < CHURN_NAMES; ++i) {
+        SDL_snprintf(&names[i * 16], 16, "churn%d", i);
+        values[i] = -1;
+    }
+
+    props = SDL_CreateProperties();
+    SDLTest_AssertCheck(props != 0, "Verify props were created");
+    if (!props) {
+        return TEST_ABORTED;
+    }
+
+    /* A table of one or two groups of slots, so most probes wrap around through the mirrored
+     * control bytes. Draining a nearly full table leaves deleted slots behind, until it's rebuilt.
+     */
+    mismatches = churnProperties(props, names, values, &num_live, 6, 13, 100, &generation);
+    SDLTest_AssertCheck(mismatches == 0, "Check properties while churning a small set, expected: 0 mismatches, got: %d", mismatches);
+
+    /* Grow the table one property at a time */
+    mismatches = 0;
+    for (i = 0; i < CHURN_NAMES; ++i) {
+        if (values[i] < 0) {
+            values[i] = ++generation;
+            SDL_SetNumberProperty(props, &names[i * 16], values[i]);
+            ++num_live;
+            mismatches += checkChurnedProperties(props, names, values);
+        }
+    }
+    SDLTest_AssertCheck(mismatches == 0, "Check properties while growing the set, expected: 0 mismatches, got: %d", mismatches);
+
+    /* Shrink back down and churn in the large table */
+    mismatches = churnProperties(props, names, values, &num_live, 8, 8, 1, &generation);
+    mismatches += churnProperties(props, names, values, &num_live, 8, 100, 10, &generation);
+    SDLTest_AssertCheck(mismatches == 0, "Check properties while churning a large set, expected: 0 mismatches, got: %d", mismatches);
+
+    /* Clearing everything leaves nothing behind */
+    for (i = 0; i < CHURN_NAMES; ++i) {
+        SDL_ClearProperty(props, &names[i * 16]);
+        values[i] = -1;
+    }
+    mismatches = checkChurnedProperties(props, names, values);
+    SDLTest_AssertCheck(mismatches == 0, "Check properties after clearing the set, expected: 0 mismatches, got: %d", mismatches);
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Test freezing properties
+ */
+static int SDLCALL properties_testFreeze(void *arg)
+{
+    SDL_PropertiesID props, copy;
+    const int lookups = 1000000;
+    Uint64 start, elapsed[2];
+    Sint64 sum = 0;
+    const char *value;
+    bool result;
+    int i, pass;
+
+    props = SDL_CreateProperties();
+    SDL_SetNumberProperty(props, "number", 42);
+    SDL_SetFloatProperty(props, "float", 1.5f);
+    SDL_SetStringProperty(props, "string", "frozen");
+
+    for (pass = 0; pass < 2; ++pass) {
+        if (pass == 1) {
+            SDLTest_AssertPass("Call to SDL_FreezeProperties()");
+            result = SDL_FreezeProperties(props);
+            SDLTest_AssertCheck(result, "Verify SDL_FreezeProperties() result, expected true, got %s", result ? "true" : "false");
+        }
+        start = SDL_GetTicksNS();
+        for (i = 0; i < lookups; ++i) {
+            sum += SDL_GetNumberProperty(props, "number", 0);
+        }
+        elapsed[pass] = SDL_GetTicksNS() - start;
+    }
+    SDLTest_AssertCheck(sum == (Sint64)lookups * 2 * 42, "Check lookups returned the property value");
+    SDLTest_Log("Lookups: %.1f ns unfrozen, %.1f ns frozen", (double)elapsed[0] / lookups, (double)elapsed[1] / lookups);
+
+    SDLTest_AssertPass("Call to SDL_FreezeProperties() on frozen properties");
+    result = SDL_FreezeProperties(props);
+    SDLTest_AssertCheck(result, "Verify SDL_FreezeProperties() result, expected true, got %s", result ? "true" : "false");
+
+    result = SDL_SetNumberProperty(props, "number", 1);
+    SDLTest_AssertCheck(!result, "Verify setting a frozen property fails");
+    result = SDL_SetNumberProperty(props, "new", 1);
+    SDLTest_AssertCheck(!result, "Verify adding a frozen property fails");
+    result = SDL_ClearProperty(props, "string");
+    SDLTest_AssertCheck(!result, "Verify clearing a frozen property fails");
+
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "number", 0) == 42, "Verify number property is unchanged");
+    SDLTest_AssertCheck(!SDL_HasProperty(props, "new"), "Verify no property was added");
+    value = SDL_GetStringProperty(props, "number", NULL);
+    SDLTest_AssertCheck(value && SDL_strcmp(value, "42") == 0, "Verify number as string, expected 42, got %s", value ? value : "NULL");
+    value = SDL_GetStringProperty(props, "float", NULL);
+    SDLTest_AssertCheck(value && SDL_strcmp(value, "1.500000") == 0, "Verify float as string, expected 1.500000, got %s", value ? value : "NULL");
+    value = SDL_GetStringProperty(props, "string", NULL);
+    SDLTest_AssertCheck(value && SDL_strcmp(value, "frozen") == 0, "Verify string property, expected frozen, got %s", value ? value : "NULL");
+
+    copy = SDL_CreateProperties();
+    result = SDL_CopyProperties(props, copy);
+    SDLTest_AssertCheck(result, "Verify copying from frozen properties succeeds");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(copy, "number", 0) == 42, "Verify copied number property");
+    result = SDL_SetNumberProperty(copy, "number", 1);
+    SDLTest_AssertCheck(result, "Verify the copy isn't frozen");
+    result = SDL_CopyProperties(copy, props);
+    SDLTest_AssertCheck(!result, "Verify copying into frozen properties fails");
+    SDLTest_AssertCheck(SDL_GetNumberProperty(props, "number", 0) == 42, "Verify number property is unchanged");
+
+    SDL_DestroyProperties(copy);
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -401,12 +634,27 @@ static const SDLTest_TestCaseReference propertiesTestLocking = {
     properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestFreeze = {
+    properties_testFreeze, "properties_testFreeze", "Test freezing properties", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTestLookupScaling = {
+    properties_testLookupScaling, "properties_testLookupScaling", "Test lookups in large property sets", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference propertiesTestChurn = {
+    properties_testChurn, "properties_testChurn", "Test adding and removing properties repeatedly", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
     &propertiesTestBasic,
     &propertiesTestCopy,
     &propertiesTestCleanup,
     &propertiesTestLocking,
+    &propertiesTestFreeze,
+    &propertiesTestLookupScaling,
+    &propertiesTestChurn,
     NULL
 };
 
@@ -1512,6 +1512,797 @@ static int SDLCALL render_testUVWrapping(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Draws interleaved blits from two textures, some overlapping and some not. Helper function.
+ */
+static void drawReorderPattern(SDL_Texture *tface, SDL_Texture *tface2)
+{
+    SDL_FRect rect;
+    int i, j;
+
+    /* Small blits that never overlap, alternating between textures */
+    rect.w = 8.0f;
+    rect.h = 8.0f;
+    for (j = 0; j < 3; j++) {
+        for (i = 0; i < 8; i++) {
+            rect.x = (float)(i * 10);
+            rect.y = (float)(j * 10);
+            SDL_RenderTexture(renderer, ((i + j) % 2) ? tface2 : tface, NULL, &rect);
+        }
+    }
+
+    /* Overlapping blits and fills, where order matters */
+    rect.w = (float)tface->w;
+    rect.h = (float)tface->h;
+    for (i = 0; i < 6; i++) {
+        rect.x = (float)(i * 8);
+        rect.y = 30.0f - (float)(i % 2) * 4.0f;
+        SDL_RenderTexture(renderer, (i % 2) ? tface2 : tface, NULL, &rect);
+        if (i == 3) {
+            SDL_FRect fill = { 20.0f, 36.0f, 30.0f, 10.0f };
+            SDL_RenderFillRect(renderer, &fill);
+        }
+    }
+}
+
+/**
+ * Tests that reordering draw commands by state doesn't change the result
+ */
+static int SDLCALL render_testReorderCommands(void *arg)
+{
+    SDL_Texture *tface, *tface2;
+    SDL_Surface *surface, *referenceSurface;
+    SDL_Rect rect = { 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H };
+    Sint64 commands, batches;
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        /* Recreate the renderer, with and without reordering */
+        SDL_DestroyRenderer(renderer);
+        SDL_SetHint(SDL_HINT_RENDER_REORDER_COMMANDS, i ? "1" : "0");
+        renderer = SDL_CreateRenderer(window, NULL);
+        SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result: %s", renderer != NULL ? "success" : SDL_GetError());
+        if (renderer == NULL) {
+            SDL_ResetHint(SDL_HINT_RENDER_REORDER_COMMANDS);
+            return TEST_ABORTED;
+        }
+
+        clearScreen();
+
+        tface = loadTestFace();
+        tface2 = loadTestFace();
+        SDLTest_AssertCheck(tface != NULL && tface2 != NULL, "Verify loadTestFace() result");
+        if (tface == NULL || tface2 == NULL) {
+            SDL_ResetHint(SDL_HINT_RENDER_REORDER_COMMANDS);
+            return TEST_ABORTED;
+        }
+        SDL_SetTextureBlendMode(tface2, SDL_BLENDMODE_ADD);
+
+        drawReorderPattern(tface, tface2);
+
+        if (i == 0) {
+            /* The unordered result is the reference */
+            surface = SDL_RenderReadPixels(renderer, &rect);
+            SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got %s", surface ? "surface" : SDL_GetError());
+            referenceSurface = surface ? SDL_ConvertSurface(surface, RENDER_COMPARE_FORMAT) : NULL;
+            SDL_DestroySurface(surface);
+        } else {
+            compare(referenceSurface, ALLOWABLE_ERROR_OPAQUE);
+        }
+
+        SDL_RenderPresent(renderer);
+        commands = SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_DRAW_COMMANDS_NUMBER, 0);
+        batches = SDL_GetNumberProperty(SDL_GetRendererProperties(renderer), SDL_PROP_RENDERER_DRAW_BATCHES_NUMBER, 0);
+        if (i == 0) {
+            /* The statistics are only kept while reordering */
+            SDLTest_AssertCheck(commands == 0 && batches == 0, "Validate draw statistics aren't kept, got %" SDL_PRIs64 " commands, %" SDL_PRIs64 " batches", commands, batches);
+        } else {
+            SDLTest_AssertCheck(batches > 0 && batches < commands, "Validate reordered draw batches, expected: 0 < %" SDL_PRIs64 " < %" SDL_PRIs64, batches, commands);
+        }
+
+        SDL_DestroyTexture(tface);
+        SDL_DestroyTexture(tface2);
+    }
+
+    /* Clean up. */
+    SDL_DestroySurface(referenceSurface);
+    SDL_ResetHint(SDL_HINT_RENDER_REORDER_COMMANDS);
+
+    return TEST_COMPLETED;
+}
+
+static void drawThreadedPattern(SDL_Texture *tface)
+{
+    SDL_Vertex verts[3];
+    SDL_FRect rect;
+    SDL_Rect viewport = { 10, 20, 300, 200 };
+    SDL_Rect cliprect = { 5, 5, 250, 170 };
+    int i;
+
+    /* Fills and blits crossing the bands the software renderer splits the target into */
+    SDL_SetRenderDrawColor(renderer, 40, 80, 120, SDL_ALPHA_OPAQUE);
+    rect.x = 16.0f;
+    rect.y = 50.0f;
+    rect.w = 100.0f;
+    rect.h = 150.0f;
+    SDL_RenderFillRect(renderer, &rect);
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 200, 100, 50, 128);
+    rect.x = 60.0f;
+    rect.y = 10.0f;
+    rect.w = 200.0f;
+    rect.h = 220.0f;
+    SDL_RenderFillRect(renderer, &rect);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SDL_SetRenderViewport(renderer, &viewport);
+    SDL_SetRenderClipRect(renderer, &cliprect);
+    for (i = 0; i < 8; i++) {
+        rect.x = (float)(i * 30);
+        rect.y = (float)(i * 22) - 20.0f;
+        rect.w = (float)tface->w * 1.5f;
+        rect.h = (float)tface->h * 1.5f;
+        SDL_RenderTexture(renderer, tface, NULL, &rect);
+        SDL_RenderTextureRotated(renderer, tface, NULL, &rect, i * 25.0, NULL, SDL_FLIP_NONE);
+        SDL_RenderPoint(renderer, rect.x, rect.y + 60.0f);
+    }
+
+    for (i = 0; i < 3; i++) {
+        verts[i].position.x = (i == 1) ? 280.0f : 30.0f + (float)i * 20.0f;
+        verts[i].position.y = (i == 2) ? 190.0f : 40.0f + (float)i * 30.0f;
+        verts[i].color.r = (i == 0) ? 1.0f : 0.0f;
+        verts[i].color.g = (i == 1) ? 1.0f : 0.0f;
+        verts[i].color.b = (i == 2) ? 1.0f : 0.0f;
+        verts[i].color.a = 1.0f;
+        verts[i].tex_coord.x = (i == 1) ? 1.0f : 0.0f;
+        verts[i].tex_coord.y = (i == 2) ? 1.0f : 0.0f;
+    }
+    SDL_RenderGeometry(renderer, NULL, verts, 3, NULL, 0);
+    SDL_RenderGeometry(renderer, tface, verts, 3, NULL, 0);
+
+    SDL_SetRenderClipRect(renderer, NULL);
+    SDL_SetRenderViewport(renderer, NULL);
+}
+
+/**
+ * Tests that drawing on several threads in the software renderer doesn't change the result
+ */
+static int SDLCALL render_testSoftwareThreads(void *arg)
+{
+    SDL_Texture *tface;
+    SDL_Surface *surface, *referenceSurface = NULL;
+    int i, ret;
+
+    if (SDL_strcmp(SDL_GetRendererName(renderer), SDL_SOFTWARE_RENDERER) != 0) {
+        SDLTest_Log("Skipping, the renderer isn't the software renderer");
+        return TEST_SKIPPED;
+    }
+
+    for (i = 0; i < 2; i++) {
+        /* Recreate the renderer, drawing on one thread and then on several */
+        SDL_DestroyRenderer(renderer);
+        SDL_SetHint(SDL_HINT_RENDER_SOFTWARE_THREADS, i ? "4" : "1");
+        renderer = SDL_CreateRenderer(window, SDL_SOFTWARE_RENDERER);
+        SDLTest_AssertCheck(renderer != NULL, "Check SDL_CreateRenderer result: %s", renderer != NULL ? "success" : SDL_GetError());
+        if (renderer == NULL) {
+            SDL_DestroySurface(referenceSurface);
+            SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+            return TEST_ABORTED;
+        }
+
+        SDL_SetRenderDrawColor(renderer, 0, 0, 0, SDL_ALPHA_OPAQUE);
+        SDL_RenderClear(renderer);
+
+        tface = loadTestFace();
+        SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+        if (tface == NULL) {
+            SDL_DestroySurface(referenceSurface);
+            SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+            return TEST_ABORTED;
+        }
+        SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureColorMod(tface, 255, 200, 150);
+
+        drawThreadedPattern(tface);
+
+        surface = SDL_RenderReadPixels(renderer, NULL);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got %s", surface ? "surface" : SDL_GetError());
+        if (i == 0) {
+            referenceSurface = surface;
+        } else if (surface && referenceSurface) {
+            ret = SDLTest_CompareSurfaces(surface, referenceSurface, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+            SDL_DestroySurface(surface);
+        }
+
+        SDL_DestroyTexture(tface);
+    }
+
+    /* Clean up. */
+    SDL_DestroySurface(referenceSurface);
+    SDL_ResetHint(SDL_HINT_RENDER_SOFTWARE_THREADS);
+
+    return TEST_COMPLETED;
+}
+
+/* Draws a set of textured triangles, including clipped and degenerate ones, onto a new surface */
+static SDL_Surface *drawTriangleSet(SDL_Surface *source, SDL_PixelFormat target_format)
+{
+    static const float positions[][6] = {
+        { 3.0f, 2.0f, 70.0f, 9.0f, 21.0f, 55.0f },       /* inside the target */
+        { -25.0f, -10.0f, 60.0f, 30.0f, 10.0f, 80.0f },  /* clipped by the target */
+        { 50.0f, 5.0f, 120.0f, 40.0f, 40.0f, 45.0f },    /* clipped on the right */
+        { 10.0f, 10.0f, 40.0f, 10.0f, 70.0f, 10.0f },    /* degenerate: flat */
+        { 5.0f, 5.0f, 35.0f, 35.0f, 65.0f, 65.0f },      /* degenerate: collinear */
+        { 30.0f, 30.0f, 30.0f, 30.0f, 30.0f, 30.0f },    /* degenerate: a point */
+        { 79.5f, 0.5f, 0.5f, 59.5f, 79.5f, 59.5f },      /* covers half the target */
+    };
+    static const SDL_FColor colors[] = {
+        { 1.0f, 1.0f, 1.0f, 1.0f },
+        { 1.0f, 0.5f, 0.25f, 0.75f },
+        { 0.2f, 0.9f, 0.6f, 0.4f },
+    };
+    SDL_Surface *target;
+    SDL_Renderer *sw_renderer;
+    SDL_Texture *texture;
+    SDL_Rect clip = { 4, 3, 70, 52 };
+    int i, j, pass;
+
+    target = SDL_CreateSurface(TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H, target_format);
+    if (!target) {
+        return NULL;
+    }
+    sw_renderer = SDL_CreateSoftwareRenderer(target);
+    texture = sw_renderer ? SDL_CreateTexture(sw_renderer, source->format, SDL_TEXTUREACCESS_STATIC, source->w, source->h) : NULL;
+    if (!texture || !SDL_UpdateTexture(texture, NULL, source->pixels, source->pitch)) {
+        SDL_DestroyRenderer(sw_renderer);
+        SDL_DestroySurface(target);
+        return NULL;
+    }
+    /* No blending, so the result doesn't depend on the precision of the target */
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_NONE);
+
+    SDL_SetRenderDrawColor(sw_renderer, 40, 80, 120, SDL_ALPHA_OPAQUE);
+    SDL_RenderClear(sw_renderer);
+
+    /* Draw everything once unclipped and once with a clip rect */
+    for (pass = 0; pass < 2; pass++) {
+        SDL_SetRenderClipRect(sw_renderer, pass ? &clip : NULL);
+        for (i = 0; i < (int)SDL_arraysize(positions); i++) {
+            SDL_Vertex verts[3];
+            for (j = 0; j < 3; j++) {
+                verts[j].position.x = positions[i][j * 2] + (float)pass;
+                verts[j].position.y = positions[i][j * 2 + 1];
+                verts[j].color = colors[(i + j + pass) % SDL_arraysize(colors)];
+                verts[j].tex_coord.x = (j == 1) ? 1.0f : 0.1f * (float)i;
+                verts[j].tex_coord.y = (j == 2) ? 1.0f : 0.05f * (float)j;
+            }
+            SDL_RenderGeometry(sw_renderer, texture, verts, 3, NULL, 0);
+        }
+    }
+    SDL_RenderPresent(sw_renderer);
+
+    SDL_DestroyTexture(texture);
+    SDL_DestroyRenderer(sw_renderer);
+    return target;
+}
+
+/**
+ * Tests that the 32-bit span blitter for textured triangles matches the generic per-pixel blitter
+ */
+static int SDLCALL render_testTriangleSpanBlitter(void *arg)
+{
+    SDL_Surface *source, *generic, *span, *converted;
+    int x, y, ret;
+
+    source = SDL_CreateSurface(37, 29, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(source != NULL, "Verify SDL_CreateSurface() result");
+    if (!source) {
+        return TEST_ABORTED;
+    }
+    for (y = 0; y < source->h; y++) {
+        Uint32 *row = (Uint32 *)((Uint8 *)source->pixels + y * source->pitch);
+        for (x = 0; x < source->w; x++) {
+            row[x] = ((Uint32)(x * 7 + y * 3) & 0xFF) << 16 | ((Uint32)(x * y) & 0xFF) << 8 | ((Uint32)(255 - y * 5) & 0xFF);
+        }
+    }
+
+    /* 16-bit targets go through the generic blitter, 32-bit ones through the span blitter.
+     * The colors are computed at 8 bits per channel either way, so converting the span
+     * result to the 16-bit format has to give the same pixels.
+     */
+    generic = drawTriangleSet(source, SDL_PIXELFORMAT_XRGB1555);
+    span = drawTriangleSet(source, SDL_PIXELFORMAT_XRGB8888);
+    SDLTest_AssertCheck(generic != NULL && span != NULL, "Verify triangles were drawn, got %s", SDL_GetError());
+    if (generic && span) {
+        converted = SDL_ConvertSurface(span, generic->format);
+        SDLTest_AssertCheck(converted != NULL, "Verify SDL_ConvertSurface() result");
+        if (converted) {
+            ret = SDLTest_CompareSurfaces(converted, generic, 0);
+            SDLTest_AssertCheck(ret == 0, "Validate result from SDLTest_CompareSurfaces, expected: 0, got: %i", ret);
+            SDL_DestroySurface(converted);
+        }
+    }
+
+    SDL_DestroySurface(generic);
+    SDL_DestroySurface(span);
+    SDL_DestroySurface(source);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that a property read by SDL_PropertyKey matches the same property read by name
+ */
+static int SDLCALL render_testPropertyKeyLookup(void *arg)
+{
+    /* SDL_GetRenderTarget() looks up this internal property by key */
+    const char *parent_name = "SDL.internal.texture.parent";
+    SDL_Texture *target, *parent, *found;
+    SDL_PropertiesID props;
+    int i;
+
+    target = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, 16, 16);
+    parent = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, 16, 16);
+    SDLTest_AssertCheck(target != NULL && parent != NULL, "Verify SDL_CreateTexture() found");
+    if (!target || !parent) {
+        SDL_DestroyTexture(target);
+        SDL_DestroyTexture(parent);
+        return TEST_ABORTED;
+    }
+    props = SDL_GetTextureProperties(target);
+    CHECK_FUNC(SDL_SetRenderTarget, (renderer, target));
+
+    /* Set, clear and set again, so the key has to keep finding the name after it was removed */
+    for (i = 0; i < 2; i++) {
+        CHECK_FUNC(SDL_SetPointerProperty, (props, parent_name, parent));
+        found = SDL_GetRenderTarget(renderer);
+        SDLTest_AssertCheck(found == SDL_GetPointerProperty(props, parent_name, NULL), "Check lookup by key matches lookup by name after set");
+        SDLTest_AssertCheck(found == parent, "Check lookup by key found the property, expected: %p, got: %p", (void *)parent, (void *)found);
+
+        CHECK_FUNC(SDL_ClearProperty, (props, parent_name));
+        found = SDL_GetRenderTarget(renderer);
+        SDLTest_AssertCheck(SDL_GetPointerProperty(props, parent_name, target) == found, "Check lookup by key matches lookup by name after clear");
+        SDLTest_AssertCheck(found == target, "Check lookup by key missed the property, expected: %p, got: %p", (void *)target, (void *)found);
+    }
+
+    CHECK_FUNC(SDL_SetRenderTarget, (renderer, NULL));
+    SDL_DestroyTexture(parent);
+    SDL_DestroyTexture(target);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that a batch of texture copies renders the same as individual copies
+ */
+static int SDLCALL render_testRenderTextureBatch(void *arg)
+{
+    SDL_TextureBatchItem items[12];
+    SDL_Texture *tface;
+    SDL_Surface *surface, *referenceSurface;
+    SDL_Rect rect = { 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H };
+    const int num_items = (int)SDL_arraysize(items);
+    int i;
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Create face surface. */
+    tface = loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+
+    for (i = 0; i < num_items; i++) {
+        items[i].srcrect.x = (float)(i % 3) * 4.0f;
+        items[i].srcrect.y = 0.0f;
+        items[i].srcrect.w = (float)tface->w - 8.0f;
+        items[i].srcrect.h = (float)tface->h / 2;
+        items[i].dstrect.x = (float)(i % 4) * 20.0f;
+        items[i].dstrect.y = (float)(i / 4) * 20.0f;
+        items[i].dstrect.w = 24.0f;
+        items[i].dstrect.h = 16.0f;
+        items[i].color.r = 1.0f;
+        items[i].color.g = (i % 2) ? 0.5f : 1.0f;
+        items[i].color.b = (i % 3) ? 1.0f : 0.0f;
+        items[i].color.a = 1.0f - (float)i / 16.0f;
+        items[i].angle = (i % 5) * 30.0;
+    }
+
+    /* Draw the reference with individual copies */
+    for (i = 0; i < num_items; i++) {
+        CHECK_FUNC(SDL_SetTextureColorModFloat, (tface, items[i].color.r, items[i].color.g, items[i].color.b));
+        CHECK_FUNC(SDL_SetTextureAlphaModFloat, (tface, items[i].color.a));
+        CHECK_FUNC(SDL_RenderTextureRotated, (renderer, tface, &items[i].srcrect, &items[i].dstrect, items[i].angle, NULL, SDL_FLIP_NONE));
+    }
+    surface = SDL_RenderReadPixels(renderer, &rect);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got %s", surface ? "surface" : SDL_GetError());
+    referenceSurface = surface ? SDL_ConvertSurface(surface, RENDER_COMPARE_FORMAT) : NULL;
+    SDL_DestroySurface(surface);
+    if (referenceSurface == NULL) {
+        SDL_DestroyTexture(tface);
+        return TEST_ABORTED;
+    }
+
+    /* Draw the same thing as a batch */
+    clearScreen();
+    CHECK_FUNC(SDL_SetTextureColorModFloat, (tface, 1.0f, 1.0f, 1.0f));
+    CHECK_FUNC(SDL_SetTextureAlphaModFloat, (tface, 1.0f));
+    CHECK_FUNC(SDL_RenderTextureBatch, (renderer, tface, items, num_items));
+
+    /* See if it's the same */
+    compare(referenceSurface, ALLOWABLE_ERROR_BLENDED);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    /* Clean up. */
+    SDL_DestroyTexture(tface);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that batch items with a srcrect partly outside the texture only draw the part inside it
+ */
+static int SDLCALL render_testRenderTextureBatchClipped(void *arg)
+{
+    SDL_TextureBatchItem items[4];
+    SDL_Vertex vertices[SDL_arraysize(items) * 6];
+    SDL_Texture *tface;
+    SDL_Surface *surface, *referenceSurface;
+    SDL_Rect rect = { 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H };
+    const int num_items = (int)SDL_arraysize(items);
+    const int corners[6] = { 0, 1, 2, 0, 2, 3 };
+    int i, j;
+
+    /* Clear surface. */
+    clearScreen();
+
+    /* Create face surface. */
+    tface = loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+
+    /* Each item hangs off a different edge of the texture by half its size, drawn at twice the size */
+    for (i = 0; i < num_items; i++) {
+        items[i].srcrect.x = (i == 0) ? -(float)tface->w / 2 : (i == 1) ? (float)tface->w / 2 : 0.0f;
+        items[i].srcrect.y = (i == 2) ? -(float)tface->h / 2 : (i == 3) ? (float)tface->h / 2 : 0.0f;
+        items[i].srcrect.w = (float)tface->w;
+        items[i].srcrect.h = (float)tface->h;
+        items[i].dstrect.x = (float)(i % 2) * (TESTRENDER_SCREEN_W / 2);
+        items[i].dstrect.y = (float)(i / 2) * (TESTRENDER_SCREEN_H / 2);
+        items[i].dstrect.w = (float)tface->w * 2;
+        items[i].dstrect.h = (float)tface->h * 2;
+        items[i].color.r = 1.0f;
+        items[i].color.g = 1.0f;
+        items[i].color.b = 1.0f;
+        items[i].color.a = 1.0f;
+        items[i].angle = 0.0;
+    }
+
+    /* Draw the reference as geometry, with the srcrect clipped and the dstrect shrunk to match */
+    for (i = 0; i < num_items; i++) {
+        const SDL_FRect *srcrect = &items[i].srcrect;
+        const SDL_FRect *dstrect = &items[i].dstrect;
+        const float minu = SDL_max(srcrect->x, 0.0f) / tface->w;
+        const float minv = SDL_max(srcrect->y, 0.0f) / tface->h;
+        const float maxu = SDL_min(srcrect->x + srcrect->w, (float)tface->w) / tface->w;
+        const float maxv = SDL_min(srcrect->y + srcrect->h, (float)tface->h) / tface->h;
+        const float minx = dstrect->x + (minu * tface->w - srcrect->x) * 2;
+        const float miny = dstrect->y + (minv * tface->h - srcrect->y) * 2;
+        const float maxx = dstrect->x + (maxu * tface->w - srcrect->x) * 2;
+        const float maxy = dstrect->y + (maxv * tface->h - srcrect->y) * 2;
+
+        for (j = 0; j < 6; j++) {
+            SDL_Vertex *vertex = &vertices[i * 6 + j];
+            const bool right = (corners[j] == 1 || corners[j] == 2);
+            const bool bottom = (corners[j] == 2 || corners[j] == 3);
+
+            vertex->position.x = right ? maxx : minx;
+            vertex->position.y = bottom ? maxy : miny;
+            vertex->color = items[i].color;
+            vertex->tex_coord.x = right ? maxu : minu;
+            vertex->tex_coord.y = bottom ? maxv : minv;
+        }
+    }
+    CHECK_FUNC(SDL_RenderGeometry, (renderer, tface, vertices, (int)SDL_arraysize(vertices), NULL, 0));
+    surface = SDL_RenderReadPixels(renderer, &rect);
+    SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got %s", surface ? "surface" : SDL_GetError());
+    referenceSurface = surface ? SDL_ConvertSurface(surface, RENDER_COMPARE_FORMAT) : NULL;
+    SDL_DestroySurface(surface);
+    if (referenceSurface == NULL) {
+        SDL_DestroyTexture(tface);
+        return TEST_ABORTED;
+    }
+
+    /* Draw the same thing as a batch, the software renderer blits each item separately */
+    clearScreen();
+    CHECK_FUNC(SDL_RenderTextureBatch, (renderer, tface, items, num_items));
+
+    /* See if it's the same */
+    compare(referenceSurface, ALLOWABLE_ERROR_BLENDED);
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    /* Clean up. */
+    SDL_DestroyTexture(tface);
+    SDL_DestroySurface(referenceSurface);
+
+    return TEST_COMPLETED;
+}
+
+#define PACER_FRAMES      30
+#define PACER_LONG_FRAME  3.5
+#define PACER_AFTER_LONG  10
+
+/**
+ * Tests that simulated vsync paces presents to the display refresh rate
+ */
+static int SDLCALL render_testSimulatedVSync(void *arg)
+{
+    const SDL_DisplayMode *mode;
+    Uint64 period, start, elapsed, average;
+    int vsync = 0;
+    int i;
+
+    /* The software renderer can't sync to the dummy video driver, so SDL simulates vsync */
+    CHECK_FUNC(SDL_SetRenderVSync, (renderer, 1));
+    CHECK_FUNC(SDL_GetRenderVSync, (renderer, &vsync));
+    SDLTest_AssertCheck(vsync == 1, "Validate vsync, expected: 1, got: %d", vsync);
+
+    /* This is the refresh rate the renderer paces to */
+    mode = SDL_GetDesktopDisplayMode(SDL_GetDisplayForWindow(window));
+    if (mode && mode->refresh_rate_numerator > 0 && mode->refresh_rate_denominator > 0) {
+        period = (SDL_NS_PER_SECOND * mode->refresh_rate_denominator) / mode->refresh_rate_numerator;
+    } else {
+        period = SDL_NS_PER_SECOND / 60;
+    }
+
+    /* The first present starts the timeline */
+    SDL_RenderClear(renderer);
+    SDL_RenderPresent(renderer);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < PACER_FRAMES; i++) {
+        SDL_RenderClear(renderer);
+        SDL_RenderPresent(renderer);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    average = elapsed / PACER_FRAMES;
+    SDLTest_AssertCheck(average >= period - period / 10 && average <= period + period / 4,
+                        "Validate average frame interval, expected: %" SDL_PRIu64 " ns, got: %" SDL_PRIu64 " ns", period, average);
+
+    /* A frame that runs long skips to the next refresh instead of making the next frames catch up */
+    SDL_RenderClear(renderer);
+    SDL_DelayNS((Uint64)(period * PACER_LONG_FRAME));
+    SDL_RenderPresent(renderer);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < PACER_AFTER_LONG; i++) {
+        SDL_RenderClear(renderer);
+        SDL_RenderPresent(renderer);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    /* Only the first frame should be short, to line back up with the refresh */
+    SDLTest_AssertCheck(elapsed >= (PACER_AFTER_LONG - 1) * period,
+                        "Validate frames after a long frame, expected at least: %" SDL_PRIu64 " ns, got: %" SDL_PRIu64 " ns", (PACER_AFTER_LONG - 1) * period, elapsed);
+
+    CHECK_FUNC(SDL_SetRenderVSync, (renderer, 0));
+
+    return TEST_COMPLETED;
+}
+
+#define VALIDATE_THREADS  16
+#define VALIDATE_TEXTURES 64
+#define VALIDATE_CALLS    100000
+#define VALIDATE_CHURN    1024
+#define VALIDATE_ROUNDS   20
+
+typedef struct
+{
+    SDL_Texture **textures;
+    SDL_AtomicInt *done;
+    int calls;
+    int failures;
+} ValidateThreadData;
+
+static int SDLCALL validateTexturesThread(void *arg)
+{
+    ValidateThreadData *data = (ValidateThreadData *)arg;
+    float w, h;
+    int i;
+
+    /* Keep going until the table has been churned enough */
+    for (i = 0; i < VALIDATE_CALLS || !SDL_GetAtomicInt(data->done); i++) {
+        if (!SDL_GetTextureSize(data->textures[i % VALIDATE_TEXTURES], &w, &h)) {
+            data->failures++;
+        }
+    }
+    data->calls = i;
+    return 0;
+}
+
+/**
+ * Tests validating texture handles on many threads while other textures are created and destroyed
+ */
+static int SDLCALL render_testValidateHandlesThreaded(void *arg)
+{
+    SDL_Texture *textures[VALIDATE_TEXTURES];
+    SDL_Thread *threads[VALIDATE_THREADS];
+    ValidateThreadData data[VALIDATE_THREADS];
+    SDL_AtomicInt done;
+    SDL_Texture **temp;
+    SDL_Texture *destroyed;
+    Uint64 start, elapsed, calls = 0;
+    int i, j, failures = 0;
+    float w, h;
+
+    temp = (SDL_Texture **)SDL_calloc(VALIDATE_CHURN, sizeof(*temp));
+    SDLTest_AssertCheck(temp != NULL, "Check SDL_calloc result");
+    if (!temp) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < VALIDATE_TEXTURES; i++) {
+        textures[i] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 4, 4);
+        if (!textures[i]) {
+            SDLTest_AssertCheck(false, "Check SDL_CreateTexture result: %s", SDL_GetError());
+            while (i--) {
+                SDL_DestroyTexture(textures[i]);
+            }
+            SDL_free(temp);
+            return TEST_ABORTED;
+        }
+    }
+
+    SDL_SetAtomicInt(&done, 0);
+    start = SDL_GetTicksNS();
+    for (i = 0; i < VALIDATE_THREADS; i++) {
+        data[i].textures = textures;
+        data[i].done = &done;
+        data[i].calls = 0;
+        data[i].failures = 0;
+        threads[i] = SDL_CreateThread(validateTexturesThread, "validate", &data[i]);
+        SDLTest_AssertCheck(threads[i] != NULL, "Check SDL_CreateThread result: %s", threads[i] != NULL ? "success" : SDL_GetError());
+    }
+
+    /* Churn the object table while the threads are validating. Every fourth texture
+     * survives into the next round, so the others leave tombstones behind them and the
+     * table keeps being rebuilt.
+     */
+    for (i = 0; i < VALIDATE_ROUNDS; i++) {
+        for (j = 0; j < VALIDATE_CHURN; j++) {
+            if (temp[j]) {
+                SDL_DestroyTexture(temp[j]);
+            }
+            temp[j] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1, 1);
+        }
+        for (j = 0; j < VALIDATE_CHURN; j++) {
+            if ((j % 4) != 0) {
+                SDL_DestroyTexture(temp[j]);
+                temp[j] = NULL;
+            }
+        }
+    }
+    for (j = 0; j < VALIDATE_CHURN; j++) {
+        if (temp[j]) {
+            SDL_DestroyTexture(temp[j]);
+        }
+    }
+    SDL_SetAtomicInt(&done, 1);
+
+    for (i = 0; i < VALIDATE_THREADS; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+            calls += data[i].calls;
+            failures += data[i].failures;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDLTest_AssertCheck(failures == 0, "Check texture validation failures, expected: 0, got: %d", failures);
+    SDLTest_Log("%d threads validated %" SDL_PRIu64 " handles in %" SDL_PRIu64 " ms (%.1f ns per call, %d create/destroy rounds of %d textures)",
+                VALIDATE_THREADS, calls, elapsed / SDL_NS_PER_MS,
+                calls ? (double)elapsed / (double)calls : 0.0, VALIDATE_ROUNDS, VALIDATE_CHURN);
+
+    destroyed = textures[0];
+    for (i = 0; i < VALIDATE_TEXTURES; i++) {
+        SDL_DestroyTexture(textures[i]);
+    }
+    SDL_free(temp);
+    SDLTest_AssertCheck(!SDL_GetTextureSize(destroyed, &w, &h), "Check that a destroyed texture is no longer valid");
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Tests that rotations by multiples of 90 degrees match the equivalent flips
+ */
+static int SDLCALL render_testRenderTextureRotated(void *arg)
+{
+    static const struct
+    {
+        double angle;
+        SDL_FlipMode flip;
+        double ref_angle;
+        SDL_FlipMode ref_flip;
+    } cases[] = {
+        { 180.0, SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL, 0.0, SDL_FLIP_NONE },
+        { 180.0, SDL_FLIP_NONE, 0.0, SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL },
+        { 90.0, SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL, 270.0, SDL_FLIP_NONE },
+        { 270.0, SDL_FLIP_HORIZONTAL, 90.0, SDL_FLIP_VERTICAL },
+        { 0.0, SDL_FLIP_HORIZONTAL, 180.0, SDL_FLIP_VERTICAL },
+    };
+    SDL_Texture *tface;
+    SDL_Surface *surface, *referenceSurface;
+    SDL_Rect rect = { 0, 0, TESTRENDER_SCREEN_W, TESTRENDER_SCREEN_H };
+    SDL_FRect dst;
+    int i, j;
+
+    /* Create face surface. */
+    tface = loadTestFace();
+    SDLTest_AssertCheck(tface != NULL, "Verify loadTestFace() result");
+    if (tface == NULL) {
+        return TEST_ABORTED;
+    }
+    SDL_SetTextureBlendMode(tface, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureColorMod(tface, 255, 200, 150);
+    SDL_SetTextureAlphaMod(tface, 200);
+
+    dst.w = (float)tface->w;
+    dst.h = (float)tface->h;
+
+    for (i = 0; i < (int)SDL_arraysize(cases); i++) {
+        /* Draw the reference */
+        clearScreen();
+        for (j = 0; j < 4; j++) {
+            dst.x = (float)(j * 50 - 10);
+            dst.y = (float)(j * 40 - 10);
+            CHECK_FUNC(SDL_RenderTextureRotated, (renderer, tface, NULL, &dst, cases[i].ref_angle, NULL, cases[i].ref_flip));
+        }
+        surface = SDL_RenderReadPixels(renderer, &rect);
+        SDLTest_AssertCheck(surface != NULL, "Validate result from SDL_RenderReadPixels, got %s", surface ? "surface" : SDL_GetError());
+        referenceSurface = surface ? SDL_ConvertSurface(surface, RENDER_COMPARE_FORMAT) : NULL;
+        SDL_DestroySurface(surface);
+        if (referenceSurface == NULL) {
+            SDL_DestroyTexture(tface);
+            return TEST_ABORTED;
+        }
+
+        /* Draw the same thing rotated */
+        clearScreen();
+        for (j = 0; j < 4; j++) {
+            dst.x = (float)(j * 50 - 10);
+            dst.y = (float)(j * 40 - 10);
+            CHECK_FUNC(SDL_RenderTextureRotated, (renderer, tface, NULL, &dst, cases[i].angle, NULL, cases[i].flip));
+        }
+
+        /* See if it's the same */
+        compare(referenceSurface, ALLOWABLE_ERROR_BLENDED);
+
+        SDL_DestroySurface(referenceSurface);
+    }
+
+    /* Make current */
+    SDL_RenderPresent(renderer);
+
+    /* Clean up. */
+    SDL_DestroyTexture(tface);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Render test cases */
@@ -1563,6 +2354,42 @@ static const SDLTest_TestCaseReference renderTestUVWrapping = {
     render_testUVWrapping, "render_testUVWrapping", "Tests geometry UV wrapping", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference renderTestTriangleSpanBlitter = {
+    render_testTriangleSpanBlitter, "render_testTriangleSpanBlitter", "Tests the span blitter for textured triangles against the generic blitter", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestPropertyKeyLookup = {
+    render_testPropertyKeyLookup, "render_testPropertyKeyLookup", "Tests property lookups by key against lookups by name", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderTextureBatch = {
+    render_testRenderTextureBatch, "render_testRenderTextureBatch", "Tests batched texture copies", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSimulatedVSync = {
+    render_testSimulatedVSync, "render_testSimulatedVSync", "Tests pacing presents with simulated vsync", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderTextureBatchClipped = {
+    render_testRenderTextureBatchClipped, "render_testRenderTextureBatchClipped", "Tests batched texture copies with srcrects outside the texture", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestReorderCommands = {
+    render_testReorderCommands, "render_testReorderCommands", "Tests reordering draw commands by state", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestSoftwareThreads = {
+    render_testSoftwareThreads, "render_testSoftwareThreads", "Tests drawing on several threads in the software renderer", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestValidateHandlesThreaded = {
+    render_testValidateHandlesThreaded, "render_testValidateHandlesThreaded", "Tests validating texture handles on many threads", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference renderTestRenderTextureRotated = {
+    render_testRenderTextureRotated, "render_testRenderTextureRotated", "Tests rotations by multiples of 90 degrees against flips", TEST_ENABLED
+};
+
 /* Sequence of Render test cases */
 static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestGetNumRenderDrivers,
@@ -1577,6 +2404,15 @@ static const SDLTest_TestCaseReference *renderTests[] = {
     &renderTestClipRect,
     &renderTestLogicalSize,
     &renderTestUVWrapping,
+    &renderTestRenderTextureBatch,
+    &renderTestRenderTextureBatchClipped,
+    &renderTestSimulatedVSync,
+    &renderTestReorderCommands,
+    &renderTestSoftwareThreads,
+    &renderTestTriangleSpanBlitter,
+    &renderTestPropertyKeyLookup,
+    &renderTestRenderTextureRotated,
+    &renderTestValidateHandlesThreaded,
     NULL
 };
 
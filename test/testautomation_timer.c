@@ -126,6 +126,7 @@ static int SDLCALL timer_addRemoveTimer(void *arg)
     return TEST_SKIPPED;
 #else
     SDL_TimerID id;
+    SDL_TimerStats stats;
     int result;
     int param;
 
@@ -164,12 +165,26 @@ static int SDLCALL timer_addRemoveTimer(void *arg)
     SDL_Delay(100);
     SDLTest_AssertPass("Call to SDL_Delay(100)");
 
+    /* Check the timer statistics */
+    result = SDL_GetTimerStats(id, &stats);
+    SDLTest_AssertPass("Call to SDL_GetTimerStats()");
+    SDLTest_AssertCheck(result == true, "Check result value, expected: true, got: %i", result);
+    SDLTest_AssertCheck(stats.count == 1, "Check callback count, expected: 1, got: %" SDL_PRIu64, stats.count);
+    SDLTest_AssertCheck(stats.max_lateness_ns == stats.last_lateness_ns && stats.total_lateness_ns == stats.last_lateness_ns,
+                        "Check lateness of a single call is consistent, got: last %" SDL_PRIu64 ", max %" SDL_PRIu64 ", total %" SDL_PRIu64,
+                        stats.last_lateness_ns, stats.max_lateness_ns, stats.total_lateness_ns);
+
     /* Remove timer again and check that callback was called */
     result = SDL_RemoveTimer(id);
     SDLTest_AssertPass("Call to SDL_RemoveTimer()");
     SDLTest_AssertCheck(result == false, "Check result value, expected: false, got: %i", result);
     SDLTest_AssertCheck(g_timerCallbackCalled == 1, "Check callback WAS called, expected: 1, got: %i", g_timerCallbackCalled);
 
+    /* Statistics go away with the timer */
+    result = SDL_GetTimerStats(id, &stats);
+    SDLTest_AssertPass("Call to SDL_GetTimerStats()");
+    SDLTest_AssertCheck(result == false, "Check result value, expected: false, got: %i", result);
+
     return TEST_COMPLETED;
 #endif
 }
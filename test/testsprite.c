@@ -383,6 +383,27 @@ static void MoveSprites(SDL_Renderer *renderer, SDL_Texture *sprite)
         SDL_RenderGeometry(renderer, sprite, verts2, num_sprites * 5, indices2, num_sprites * 4 * 3);
         SDL_free(verts2);
         SDL_free(indices2);
+    } else if (use_rendergeometry == 3) {
+        /* Draw all sprites with a single batched call */
+        SDL_TextureBatchItem *items = (SDL_TextureBatchItem *)SDL_malloc(num_sprites * sizeof(*items));
+        if (items) {
+            for (i = 0; i < num_sprites; ++i) {
+                items[i].srcrect.x = 0.0f;
+                items[i].srcrect.y = 0.0f;
+                items[i].srcrect.w = (float)sprite->w;
+                items[i].srcrect.h = (float)sprite->h;
+                items[i].dstrect = positions[i];
+                items[i].color.r = 1.0f;
+                items[i].color.g = 1.0f;
+                items[i].color.b = 1.0f;
+                items[i].color.a = 1.0f;
+                items[i].angle = 0.0;
+            }
+
+            /* Blit sprites as a batch onto the screen */
+            SDL_RenderTextureBatch(renderer, sprite, items, num_sprites);
+            SDL_free(items);
+        }
     }
 
     /* Update the screen! */
@@ -464,6 +485,9 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                         /* Draw sprite2 as triangles that can *not* be recombined as rect by software renderer
                          * Use an 'indices' array */
                         use_rendergeometry = 2;
+                    } else if (SDL_strcasecmp(argv[i + 1], "batch") == 0) {
+                        /* Draw all sprites with SDL_RenderTextureBatch() */
+                        use_rendergeometry = 3;
                     } else {
                         return SDL_APP_FAILURE;
                     }
@@ -484,7 +508,7 @@ SDL_AppResult SDL_AppInit(void **appstate, int argc, char *argv[])
                 "[--cyclealpha]",
                 "[--suspend-when-occluded]",
                 "[--iterations N]",
-                "[--use-rendergeometry mode1|mode2]",
+                "[--use-rendergeometry mode1|mode2|batch]",
                 "[num_sprites]",
                 "[icon.bmp]",
                 NULL
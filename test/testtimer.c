@@ -63,6 +63,143 @@ ticktockNS(void *param, SDL_TimerID timerID, Uint64 interval)
     return interval;
 }
 
+static SDL_AtomicInt oneshots;
+
+static Uint32 SDLCALL
+oneshot(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    SDL_AddAtomicInt(&oneshots, 1);
+    return 0;
+}
+
+static void
+benchmark_timers(int num_timers)
+{
+    SDL_TimerID *timers = (SDL_TimerID *)SDL_malloc(num_timers * sizeof(*timers));
+    Uint64 start_perf, now_perf;
+    int i;
+
+    if (!timers) {
+        return;
+    }
+
+    SDL_Log("Benchmarking %d timers...\n", num_timers);
+
+    /* Long intervals in a scattered order, so none fire during the benchmark */
+    start_perf = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; ++i) {
+        timers[i] = SDL_AddTimer(60 * 1000 + (Uint32)((i * 7919) % 10000), ticktock, NULL);
+    }
+    now_perf = SDL_GetPerformanceCounter();
+    SDL_Log("Adding %d timers took %f ms\n", num_timers, (double)((now_perf - start_perf) * 1000) / SDL_GetPerformanceFrequency());
+
+    start_perf = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; ++i) {
+        SDL_RemoveTimer(timers[i]);
+    }
+    now_perf = SDL_GetPerformanceCounter();
+    SDL_Log("Removing %d timers took %f ms\n", num_timers, (double)((now_perf - start_perf) * 1000) / SDL_GetPerformanceFrequency());
+
+    /* Timers that all expire at about the same time */
+    SDL_SetAtomicInt(&oneshots, 0);
+    start_perf = SDL_GetPerformanceCounter();
+    for (i = 0; i < num_timers; ++i) {
+        SDL_AddTimer(10, oneshot, NULL);
+    }
+    while (SDL_GetAtomicInt(&oneshots) < num_timers) {
+        SDL_Delay(1);
+    }
+    now_perf = SDL_GetPerformanceCounter();
+    SDL_Log("Adding and dispatching %d one-shot timers took %f ms\n", num_timers, (double)((now_perf - start_perf) * 1000) / SDL_GetPerformanceFrequency());
+
+    SDL_free(timers);
+}
+
+#define WORKER_SLOW_CALLBACK_MS 250
+
+static SDL_AtomicInt worker_fast_calls;
+static SDL_AtomicInt worker_slow_calls;
+static SDL_AtomicInt worker_slow_running;
+static SDL_AtomicInt worker_slow_overlapped;
+static SDL_AtomicInt worker_slow_finished;
+
+static Uint32 SDLCALL
+worker_fast(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    SDL_AddAtomicInt(&worker_fast_calls, 1);
+    return interval;
+}
+
+static Uint32 SDLCALL
+worker_slow(void *param, SDL_TimerID timerID, Uint32 interval)
+{
+    if (SDL_AddAtomicInt(&worker_slow_running, 1) != 0) {
+        SDL_SetAtomicInt(&worker_slow_overlapped, 1);
+    }
+    SDL_AddAtomicInt(&worker_slow_calls, 1);
+    SDL_Delay(WORKER_SLOW_CALLBACK_MS);
+    SDL_AddAtomicInt(&worker_slow_running, -1);
+    SDL_AddAtomicInt(&worker_slow_finished, 1);
+    return interval;
+}
+
+/* This has to run before any other timer is added, the worker threads are created with the timer thread */
+static int test_timer_workers(void)
+{
+    SDL_TimerID fast, slow;
+    SDL_TimerStats stats;
+    int calls;
+
+    SDLTest_ResetAssertSummary();
+
+    SDL_SetHint(SDL_HINT_TIMER_WORKER_THREADS, "2");
+    SDL_SetAtomicInt(&worker_fast_calls, 0);
+    SDL_SetAtomicInt(&worker_slow_calls, 0);
+    SDL_SetAtomicInt(&worker_slow_running, 0);
+    SDL_SetAtomicInt(&worker_slow_overlapped, 0);
+    SDL_SetAtomicInt(&worker_slow_finished, 0);
+
+    /* The slow timer is due again long before its callback returns */
+    slow = SDL_AddTimer(10, worker_slow, NULL);
+    SDLTest_AssertCheck(slow != 0, "Check SDL_AddTimer(10, worker_slow), got: %s", slow ? "success" : SDL_GetError());
+    fast = SDL_AddTimer(10, worker_fast, NULL);
+    SDLTest_AssertCheck(fast != 0, "Check SDL_AddTimer(10, worker_fast), got: %s", fast ? "success" : SDL_GetError());
+
+    SDL_Delay(4 * WORKER_SLOW_CALLBACK_MS);
+
+    /* The fast timer keeps running on the other worker while the slow callback blocks */
+    calls = SDL_GetAtomicInt(&worker_fast_calls);
+    SDLTest_AssertCheck(calls >= 20, "Check fast timer calls, expected: >=20, got: %d", calls);
+    SDL_zero(stats);
+    SDLTest_AssertCheck(SDL_GetTimerStats(fast, &stats), "Call to SDL_GetTimerStats(fast)");
+    SDLTest_AssertCheck(stats.max_lateness_ns < SDL_MS_TO_NS(WORKER_SLOW_CALLBACK_MS / 2),
+                        "Check fast timer lateness, expected: <%d ms, got: %" SDL_PRIu64 " ns",
+                        WORKER_SLOW_CALLBACK_MS / 2, stats.max_lateness_ns);
+
+    /* The slow timer is never dispatched again while its callback is running */
+    calls = SDL_GetAtomicInt(&worker_slow_calls);
+    SDLTest_AssertCheck(calls >= 2, "Check slow timer calls, expected: >=2, got: %d", calls);
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&worker_slow_overlapped) == 0, "Check slow timer callback never ran twice at once");
+
+    SDL_RemoveTimer(fast);
+
+    /* Shutting down waits for the callback in flight */
+    while (SDL_GetAtomicInt(&worker_slow_running) == 0) {
+        SDL_Delay(1);
+    }
+    calls = SDL_GetAtomicInt(&worker_slow_finished);
+    SDL_Quit();
+    SDLTest_AssertPass("Call to SDL_Quit() with a timer callback in flight");
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&worker_slow_running) == 0, "Check no timer callback is running after SDL_Quit()");
+    SDLTest_AssertCheck(SDL_GetAtomicInt(&worker_slow_finished) == calls + 1,
+                        "Check the callback in flight finished, expected: %d, got: %d", calls + 1, SDL_GetAtomicInt(&worker_slow_finished));
+
+    /* The rest of the tests use the timer thread alone */
+    SDL_ResetHint(SDL_HINT_TIMER_WORKER_THREADS);
+
+    return SDLTest_AssertSummaryToTestResult() == TEST_RESULT_PASSED ? 0 : 1;
+}
+
 static Uint32 SDLCALL
 callback(void *param, SDL_TimerID timerID, Uint32 interval)
 {
@@ -122,6 +259,10 @@ int main(int argc, char *argv[])
         return 0;
     }
 
+    /* Run the timer callbacks on worker threads */
+    SDL_Log("Testing timer worker threads\n");
+    return_code = test_timer_workers();
+
     /* Verify SDL_GetTicks* acts monotonically increasing, and not erratic. */
     SDL_Log("Sanity-checking GetTicks\n");
     for (i = 0; i < 1000; ++i) {
@@ -269,6 +410,8 @@ int main(int argc, char *argv[])
     now_perf = SDL_GetPerformanceCounter();
     SDL_Log("1 million iterations of ticktock took %f ms\n", (double)((now_perf - start_perf) * 1000) / SDL_GetPerformanceFrequency());
 
+    benchmark_timers(100000);
+
     SDL_Log("Performance counter frequency: %" SDL_PRIu64 "\n", SDL_GetPerformanceFrequency());
     start = SDL_GetTicks();
     start_perf = SDL_GetPerformanceCounter();
@@ -278,7 +421,7 @@ int main(int argc, char *argv[])
     SDL_Log("Delay 1 second = %d ms in ticks, %f ms according to performance counter\n", (int)(now - start), (double)((now_perf - start_perf) * 1000) / SDL_GetPerformanceFrequency());
 
     if (run_interactive_tests) {
-        return_code = test_sdl_delay_within_bounds();
+        return_code |= test_sdl_delay_within_bounds();
     }
 
     SDL_Quit();